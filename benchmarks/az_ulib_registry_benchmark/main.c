@@ -0,0 +1,404 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "az_ulib_pal_flash_sim.h"
+#include "az_ulib_registry_api.h"
+#include "az_ulib_result.h"
+#include "azure/core/az_span.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*
+ * Flash geometry and timing of a typical MCU with 2KB pages.
+ */
+#define REGISTRY_PAGE_SIZE 0x800
+#define REGISTRY_DATA_PAGES 16
+#define REGISTRY_INFO_PAGES 2
+#define REGISTRY_CHECKPOINT_PAGES 1
+#define PROGRAM_LATENCY_NS 82000
+#define ERASE_LATENCY_NS 22000000
+
+/*
+ * Command and address phases of a read in an external SPI flash.
+ */
+#define READ_LATENCY_NS 2000
+
+/*
+ * Workloads.
+ */
+#define BOOT_KEYS 64
+#define PERIODIC_KEYS 8
+#define DEFAULT_UPDATE_ROUNDS 2000
+#define LOOKUPS 10000
+#define MAX_KEY_SIZE 32
+#define MAX_VALUE_SIZE 32
+
+typedef struct
+{
+  const char* name;
+  uint32_t count;
+  uint32_t capacity;
+  uint64_t* wall_ns;
+  uint64_t* flash_ns;
+  uint64_t total_wall_ns;
+} workload;
+
+static uint8_t* registry_buffer;
+static uint8_t* registry_information_buffer;
+static uint8_t* registry_checkpoint_buffer;
+static az_ulib_registry_control_block registry_cb;
+
+static uint8_t key_buffer[BOOT_KEYS][MAX_KEY_SIZE];
+static uint8_t value_buffer[MAX_VALUE_SIZE];
+
+static uint64_t now_ns(void)
+{
+  struct timespec ts;
+  (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ((uint64_t)ts.tv_sec * 1000000000) + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t flash_busy_ns(void)
+{
+  az_ulib_pal_flash_sim_stats stats;
+  az_ulib_pal_flash_sim_get_stats(&stats);
+  return stats.busy_time_ns;
+}
+
+static int compare_uint64(const void* a, const void* b)
+{
+  uint64_t x = *(const uint64_t*)a;
+  uint64_t y = *(const uint64_t*)b;
+  return (x > y) - (x < y);
+}
+
+static az_result workload_create(workload* w, const char* name, uint32_t capacity)
+{
+  w->name = name;
+  w->count = 0;
+  w->capacity = capacity;
+  w->total_wall_ns = 0;
+  w->wall_ns = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+  w->flash_ns = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+  return ((w->wall_ns == NULL) || (w->flash_ns == NULL)) ? AZ_ERROR_OUT_OF_MEMORY : AZ_OK;
+}
+
+static void workload_destroy(workload* w)
+{
+  free(w->wall_ns);
+  free(w->flash_ns);
+}
+
+static void workload_record(workload* w, uint64_t wall_start, uint64_t flash_start)
+{
+  uint64_t wall = now_ns() - wall_start;
+  if (w->count < w->capacity)
+  {
+    w->wall_ns[w->count] = wall;
+    w->flash_ns[w->count] = flash_busy_ns() - flash_start;
+    w->count++;
+  }
+  w->total_wall_ns += wall;
+}
+
+static uint64_t percentile(const uint64_t* sorted, uint32_t count, uint32_t pct)
+{
+  return (count == 0) ? 0 : sorted[((uint64_t)(count - 1) * pct) / 100];
+}
+
+static void workload_report(workload* w)
+{
+  uint64_t total_flash_ns = 0;
+  for (uint32_t i = 0; i < w->count; i++)
+  {
+    total_flash_ns += w->flash_ns[i];
+  }
+
+  qsort(w->wall_ns, w->count, sizeof(uint64_t), compare_uint64);
+  qsort(w->flash_ns, w->count, sizeof(uint64_t), compare_uint64);
+
+  /* Throughput on the device is bounded by the flash time, on the host by the CPU time. */
+  uint64_t device_ns = w->total_wall_ns + total_flash_ns;
+  printf(
+      "%-10s ops=%-6" PRIu32 " host=%.0f ops/s  device=%.1f ops/s\r\n",
+      w->name,
+      w->count,
+      (w->total_wall_ns == 0) ? 0.0 : ((double)w->count * 1e9) / (double)w->total_wall_ns,
+      (device_ns == 0) ? 0.0 : ((double)w->count * 1e9) / (double)device_ns);
+  printf(
+      "           host  ns: p50=%-8" PRIu64 " p90=%-8" PRIu64 " p99=%-8" PRIu64 " max=%" PRIu64
+      "\r\n",
+      percentile(w->wall_ns, w->count, 50),
+      percentile(w->wall_ns, w->count, 90),
+      percentile(w->wall_ns, w->count, 99),
+      percentile(w->wall_ns, w->count, 100));
+  printf(
+      "           flash us: p50=%-8" PRIu64 " p90=%-8" PRIu64 " p99=%-8" PRIu64 " max=%" PRIu64
+      "\r\n",
+      percentile(w->flash_ns, w->count, 50) / 1000,
+      percentile(w->flash_ns, w->count, 90) / 1000,
+      percentile(w->flash_ns, w->count, 99) / 1000,
+      percentile(w->flash_ns, w->count, 100) / 1000);
+}
+
+static void report_wear(uint32_t region, const char* name)
+{
+  uint32_t pages = az_ulib_pal_flash_sim_get_page_count(region);
+  uint32_t min_erase = UINT32_MAX;
+  uint32_t max_erase = 0;
+  uint64_t sum_erase = 0;
+  uint32_t max_program = 0;
+  uint64_t sum_program = 0;
+
+  for (uint32_t page = 0; page < pages; page++)
+  {
+    uint32_t program_count;
+    uint32_t erase_count;
+    (void)az_ulib_pal_flash_sim_get_page_counters(region, page, &program_count, &erase_count);
+    min_erase = (erase_count < min_erase) ? erase_count : min_erase;
+    max_erase = (erase_count > max_erase) ? erase_count : max_erase;
+    max_program = (program_count > max_program) ? program_count : max_program;
+    sum_erase += erase_count;
+    sum_program += program_count;
+  }
+
+  printf(
+      "%-10s pages=%-3" PRIu32 " erases min=%" PRIu32 " avg=%.1f max=%" PRIu32
+      "  programs avg=%.1f max=%" PRIu32 "\r\n",
+      name,
+      pages,
+      (pages == 0) ? 0 : min_erase,
+      (pages == 0) ? 0.0 : (double)sum_erase / (double)pages,
+      max_erase,
+      (pages == 0) ? 0.0 : (double)sum_program / (double)pages,
+      max_program);
+}
+
+static az_span make_key(uint32_t index)
+{
+  int size = snprintf(
+      (char*)key_buffer[index], MAX_KEY_SIZE, "ipc/interface_%02" PRIu32 ".1", index);
+  return az_span_create(key_buffer[index], size);
+}
+
+static az_span make_value(uint32_t index, uint32_t round)
+{
+  int size = snprintf(
+      (char*)value_buffer, MAX_VALUE_SIZE, "slot=%02" PRIu32 ";round=%08" PRIu32, index, round);
+  return az_span_create(value_buffer, size);
+}
+
+static az_result alloc_flash(uint8_t** buffer, uint32_t pages)
+{
+  void* memory;
+  if (posix_memalign(&memory, REGISTRY_PAGE_SIZE, (size_t)pages * REGISTRY_PAGE_SIZE) != 0)
+  {
+    return AZ_ERROR_OUT_OF_MEMORY;
+  }
+  (void)memset(memory, 0xFF, (size_t)pages * REGISTRY_PAGE_SIZE);
+  *buffer = (uint8_t*)memory;
+  return az_ulib_pal_flash_sim_add_region(memory, (size_t)pages * REGISTRY_PAGE_SIZE);
+}
+
+/* Boot-time publish storm: all interfaces store their entries right after a clean registry. */
+static az_result run_boot_storm(workload* w)
+{
+  for (uint32_t i = 0; i < BOOT_KEYS; i++)
+  {
+    az_span key = make_key(i);
+    uint64_t wall_start = now_ns();
+    uint64_t flash_start = flash_busy_ns();
+    az_result result = az_ulib_registry_add(key, make_value(i, 0));
+    workload_record(w, wall_start, flash_start);
+    if (result != AZ_OK)
+    {
+      return result;
+    }
+  }
+  return AZ_OK;
+}
+
+/* Periodic updates: a few entries are updated in a loop, the registry is cleaned and repopulated
+ * when it runs out of space, as a device without compaction would do. */
+static az_result run_periodic_updates(workload* w, uint32_t rounds, uint32_t* cleans)
+{
+  for (uint32_t round = 1; round <= rounds; round++)
+  {
+    uint32_t index = round % PERIODIC_KEYS;
+    az_span key = make_key(index);
+    uint64_t wall_start = now_ns();
+    uint64_t flash_start = flash_busy_ns();
+    az_result result = az_ulib_registry_update(key, make_value(index, round), NULL);
+    if ((result == AZ_ERROR_NOT_ENOUGH_SPACE) || (result == AZ_ERROR_OUT_OF_MEMORY))
+    {
+      (*cleans)++;
+      az_ulib_registry_clean_all();
+      result = AZ_OK;
+      for (uint32_t i = 0; (i < BOOT_KEYS) && (result == AZ_OK); i++)
+      {
+        result = az_ulib_registry_add(make_key(i), make_value(i, round));
+      }
+    }
+    workload_record(w, wall_start, flash_start);
+    if (result != AZ_OK)
+    {
+      return result;
+    }
+  }
+  return AZ_OK;
+}
+
+static az_result run_lookups(workload* w)
+{
+  for (uint32_t i = 0; i < LOOKUPS; i++)
+  {
+    az_span value;
+    uint64_t wall_start = now_ns();
+    uint64_t flash_start = flash_busy_ns();
+    az_result result = az_ulib_registry_try_get_value(make_key(i % BOOT_KEYS), &value);
+    workload_record(w, wall_start, flash_start);
+    if (result != AZ_OK)
+    {
+      return result;
+    }
+  }
+  return AZ_OK;
+}
+
+/* Same lookups with the registry in an external flash, read through the registry cache. */
+static az_result run_external_lookups(workload* w)
+{
+  az_ulib_registry_deinit();
+  registry_cb.external_flash = true;
+  az_ulib_registry_init(&registry_cb);
+
+  for (uint32_t i = 0; i < LOOKUPS; i++)
+  {
+    az_span value;
+    uint64_t wall_start = now_ns();
+    uint64_t flash_start = flash_busy_ns();
+    az_result result = az_ulib_registry_try_get_value_copy(
+        make_key(i % BOOT_KEYS), AZ_SPAN_FROM_BUFFER(value_buffer), &value);
+    workload_record(w, wall_start, flash_start);
+    if (result != AZ_OK)
+    {
+      return result;
+    }
+  }
+  return AZ_OK;
+}
+
+static az_result run_reboot(workload* w)
+{
+  az_ulib_registry_deinit();
+  uint64_t wall_start = now_ns();
+  uint64_t flash_start = flash_busy_ns();
+  az_ulib_registry_init(&registry_cb);
+  workload_record(w, wall_start, flash_start);
+  return AZ_OK;
+}
+
+int main(int argc, char** argv)
+{
+  az_result result = AZ_OK;
+  uint32_t rounds = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 10) : DEFAULT_UPDATE_ROUNDS;
+  uint32_t cleans = 0;
+  workload boot;
+  workload periodic;
+  workload lookup;
+  workload reboot;
+  workload external;
+
+  az_ulib_pal_flash_sim_config config = { .page_size = REGISTRY_PAGE_SIZE,
+                                          .program_latency_ns = PROGRAM_LATENCY_NS,
+                                          .erase_latency_ns = ERASE_LATENCY_NS,
+                                          .read_latency_ns = READ_LATENCY_NS,
+                                          .block_on_latency = false,
+                                          .fail_on_illegal_program = false };
+  az_ulib_pal_flash_sim_configure(&config);
+
+  if (((result = alloc_flash(&registry_buffer, REGISTRY_DATA_PAGES)) != AZ_OK)
+      || ((result = alloc_flash(&registry_information_buffer, REGISTRY_INFO_PAGES)) != AZ_OK)
+      || ((result = alloc_flash(&registry_checkpoint_buffer, REGISTRY_CHECKPOINT_PAGES)) != AZ_OK)
+      || ((result = workload_create(&boot, "boot", BOOT_KEYS)) != AZ_OK)
+      || ((result = workload_create(&periodic, "periodic", rounds)) != AZ_OK)
+      || ((result = workload_create(&lookup, "lookup", LOOKUPS)) != AZ_OK)
+      || ((result = workload_create(&reboot, "reboot", 1)) != AZ_OK)
+      || ((result = workload_create(&external, "external", LOOKUPS)) != AZ_OK))
+  {
+    (void)printf("Benchmark setup failed with code %" PRIi32 "\r\n", result);
+    return (int)result;
+  }
+
+  registry_cb = (az_ulib_registry_control_block){
+    .registry_start = registry_buffer,
+    .registry_end = registry_buffer + (REGISTRY_DATA_PAGES * REGISTRY_PAGE_SIZE),
+    .registry_info_start = registry_information_buffer,
+    .registry_info_end = registry_information_buffer + (REGISTRY_INFO_PAGES * REGISTRY_PAGE_SIZE),
+    .page_size = REGISTRY_PAGE_SIZE,
+    .registry_checkpoint_start = registry_checkpoint_buffer,
+    .registry_checkpoint_end
+    = registry_checkpoint_buffer + (REGISTRY_CHECKPOINT_PAGES * REGISTRY_PAGE_SIZE)
+  };
+
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  if (((result = run_boot_storm(&boot)) != AZ_OK)
+      || ((result = run_periodic_updates(&periodic, rounds, &cleans)) != AZ_OK)
+      || ((result = run_lookups(&lookup)) != AZ_OK) || ((result = run_reboot(&reboot)) != AZ_OK)
+      || ((result = run_external_lookups(&external)) != AZ_OK))
+  {
+    (void)printf("Benchmark failed with code %" PRIi32 "\r\n", result);
+  }
+  else
+  {
+    az_ulib_pal_flash_sim_stats stats;
+    az_ulib_registry_info info;
+    az_ulib_pal_flash_sim_get_stats(&stats);
+    az_ulib_registry_get_info(&info);
+
+    (void)printf("Registry benchmark, %" PRIu32 " update rounds\r\n", rounds);
+    workload_report(&boot);
+    workload_report(&periodic);
+    workload_report(&lookup);
+    workload_report(&reboot);
+    workload_report(&external);
+    (void)printf(
+        "flash      programs=%" PRIu64 " erases=%" PRIu64 " illegal=%" PRIu64 " busy=%" PRIu64
+        " ms cleans=%" PRIu32 "\r\n",
+        stats.program_count,
+        stats.erase_count,
+        stats.illegal_program_count,
+        stats.busy_time_ns / 1000000,
+        cleans);
+    (void)printf(
+        "reads      count=%" PRIu64 " bytes=%" PRIu64 " cache hits=%" PRIu32 " misses=%" PRIu32
+        "\r\n",
+        stats.read_count,
+        stats.read_bytes,
+        info.cache_hit_count,
+        info.read_count);
+    report_wear(0, "data");
+    report_wear(1, "info");
+    report_wear(2, "checkpoint");
+  }
+
+  az_ulib_registry_deinit();
+  workload_destroy(&boot);
+  workload_destroy(&periodic);
+  workload_destroy(&lookup);
+  workload_destroy(&reboot);
+  workload_destroy(&external);
+  az_ulib_pal_flash_sim_configure(NULL);
+  free(registry_buffer);
+  free(registry_information_buffer);
+  free(registry_checkpoint_buffer);
+
+  return (result == AZ_OK) ? 0 : (int)result;
+}
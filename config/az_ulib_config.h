@@ -80,6 +80,123 @@ extern "C"
  */
 #define AZ_ULIB_CONFIG_MAX_DM_INTERFACE_NAME_VERSION (AZ_ULIB_CONFIG_MAX_DM_INTERFACE_NAME + 1 + 8)
 
+/**
+ * @brief   Number of registry entries added between checkpoints.
+ *
+ * If the registry control block provides memory for checkpoints, the registry will store a new
+ * checkpoint record after this number of new entries. Each checkpoint uses 32 bytes of flash and
+ * reduces the time to initialize the registry after a reboot.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_CHECKPOINT_INTERVAL 16
+
+/**
+ * @brief   Number of lock free attempts of a registry lookup.
+ *
+ * Registry lookups run without the registry lock, and retry if a writer changed the registry in
+ * the middle of the lookup. After this number of attempts, the lookup waits for the writer on the
+ * registry lock.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_LOOKUP_RETRIES 4
+
+/**
+ * @brief   Registry supports the write-behind.
+ *
+ * This definition adds the write-behind queue to each registry instance, so the control block can
+ * enable it. The queue uses around 800 bytes of RAM with the default sizes.
+ *
+ * Commenting this definition removes the queue from the registry instance, and the registry stores
+ * each new entry in the flash before the add returns.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+
+/**
+ * @brief   Maximum number of entries in the registry write-behind queue.
+ *
+ * If the registry control block enables the write-behind, new entries wait in a queue in the RAM
+ * to be stored in the flash by a background thread. If the queue is full, the next add stores
+ * all queued entries before it returns.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE 8
+
+/**
+ * @brief   Size in bytes of the registry write-behind buffer.
+ *
+ * Buffer in the RAM with a copy of the key and value of the queued entries, each one aligned to 64
+ * bits. Entries bigger than this buffer are stored in the flash before the add returns.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_BUFFER_SIZE 512
+
+/**
+ * @brief   Registry supports external flash.
+ *
+ * This definition adds the read cache to each registry instance, so the control block can store
+ * the registry in a flash that is not memory mapped. The cache uses around 340 bytes of RAM with
+ * the default sizes.
+ *
+ * Commenting this definition removes the cache from the registry instance, and the registry
+ * memory shall be memory mapped.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+
+/**
+ * @brief   Number of blocks in the registry read cache.
+ *
+ * If the registry is stored in a flash that is not memory mapped, each registry instance keeps the
+ * most recently used blocks of the flash in the RAM, so lookups do not read the same nodes and
+ * keys from the flash over and over.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS 4
+
+/**
+ * @brief   Number of blocks in the registry read cache that only keep registry nodes.
+ *
+ * Lookups read the nodes in sequence, and the keys and values of some of them. Keeping the nodes
+ * in their own blocks avoids that one evicts the other. It shall be at least 1, and smaller than
+ * #AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_CACHE_NODE_BLOCKS 2
+
+/**
+ * @brief   Size in bytes of each block in the registry read cache.
+ *
+ * Each miss reads one block from the flash. It shall be a multiple of 8.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE 64
+
+/**
+ * @brief   Maximum number of chunks in a registry value stored with a writer.
+ *
+ * Each chunk holds up to 65535 bytes of the value, and uses one registry node. The writer keeps
+ * the index of each chunk in the RAM up to the commit.
+ */
+#define AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS 16
+
+/**
+ * @brief   Number of #az_ulib_ustream_data_cb in the ustream pool.
+ *
+ * The pool reserves the memory for all control blocks at build time. It shall be smaller than
+ * 32767.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB 32
+
+/**
+ * @brief   Number of #az_ulib_ustream_multi_data_cb in the ustream pool.
+ *
+ * The pool reserves the memory for all control blocks at build time. It shall be smaller than
+ * 32767.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB 16
+
+/**
+ * @brief   Number of segments in a #az_ulib_ustream_multi_data_cb.
+ *
+ * Each az_ulib_ustream_concat() on a multi ustream appends one segment to the same control block,
+ * so reads do not descend through one level for each concatenated ustream. When all segments are
+ * in use, the next concat uses the new control block as a new level. Increasing this number shall
+ * increase the size of the #az_ulib_ustream_multi_data_cb. It shall be at least 2.
+ */
+#define AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS 8
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
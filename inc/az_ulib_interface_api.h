@@ -71,8 +71,13 @@ typedef struct
 {
   struct
   {
-    /** Lock to make IPC operations thread safe. */
-    az_ulib_pal_os_lock lock;
+    /** Lock to make IPC operations thread safe. Lookups share it, and changes in the interface
+     * list acquire it in exclusive mode. */
+    az_ulib_pal_os_rwlock lock;
+
+    /** Manual-reset event set when the last user releases an interface on hold, so the unpublish
+     * can wake up. */
+    az_ulib_pal_os_event released;
 
     /** Reserved memory space to store the interfaces control block. */
     _az_ulib_ipc_interface interface_list[AZ_ULIB_CONFIG_MAX_IPC_INTERFACE];
@@ -52,6 +52,7 @@
  *
  * @return The #az_result with the result of the initialization.
  *  @retval #AZ_OK                              If the IPC initializes with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM               If the OS failed to create the IPC event.
  */
 AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc_control_block* ipc_control_block);
 
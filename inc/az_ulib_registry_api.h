@@ -12,20 +12,35 @@
 #ifndef AZ_ULIB_REGISTRY_API_H
 #define AZ_ULIB_REGISTRY_API_H
 
+#include "az_ulib_config.h"
 #include "az_ulib_pal_api.h"
 #include "az_ulib_result.h"
+#include "az_ulib_ustream_base.h"
 #include "azure/az_core.h"
 
 #ifdef __cplusplus
+#include <cstdbool>
 #include <cstddef>
 #include <cstdint>
 #else
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #endif
 
 #include "azure/core/_az_cfg_prefix.h"
 
+/**
+ * @brief   Signature of the function called for each flash page erased by the registry.
+ *
+ * It allows the application to keep wear accounting of the registry memory. It runs with the
+ * registry locked, so it shall be fast and shall not call any registry API.
+ *
+ * @param[in]   page          The `const void*` with the start of the erased page.
+ * @param[in]   page_size     The `size_t` with the number of erased bytes.
+ */
+typedef void (*az_ulib_registry_erase_callback)(const void* page, size_t page_size);
+
 /**
  * @brief   Registry control block.
  *
@@ -45,9 +60,41 @@ typedef struct
   /** Pointer to the end of the memory to store the registry information. */
   void* registry_info_end;
 
-  /** Size of each page. */
+  /** Size of each page. The registry erases the flash one page at a time, and skips the pages
+   * that are already erased. If `0`, each memory region is erased at once. */
   size_t page_size;
 
+  /** Pointer to the start of the memory to store the registry checkpoints. It can be `NULL`, in
+   * this case the registry will not store checkpoints, and the init will scan all registry
+   * information. */
+  void* registry_checkpoint_start;
+
+  /** Pointer to the end of the memory to store the registry checkpoints. */
+  void* registry_checkpoint_end;
+
+  /** If `true`, new entries are stored in the flash by a background thread, see
+   * az_ulib_registry_flush(). Ignored if #AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND is not defined, in
+   * this case new entries are always stored before the add returns. */
+  bool write_behind;
+
+  /** If `true`, the registry memory is not memory mapped, for example, an external SPI flash. The
+   * pointers in this control block are addresses in the flash device, the registry only reads them
+   * with the flash driver through a block cache, and values can only be retrieved with
+   * az_ulib_registry_try_get_value_copy(). If the flash driver fails to read, the API returns the
+   * error of the driver. Ignored if #AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH is not defined, in this
+   * case the registry memory shall be memory mapped. */
+  bool external_flash;
+
+  /** If `true`, the flash accepts a second program of a programmed doubleword that only clears
+   * bits, so az_ulib_registry_update() can update values in place. It shall be `false` for flash
+   * that refuses to program a doubleword twice, like the flash with ECC of the STM32L4. If `false`,
+   * updates always append a new entry. */
+  bool reprogrammable;
+
+  /** Function called for each page erased by the registry, see
+   * #az_ulib_registry_erase_callback. It can be `NULL`. */
+  az_ulib_registry_erase_callback erase_callback;
+
 } az_ulib_registry_control_block;
 
 /**
@@ -74,13 +121,268 @@ typedef struct
 
   /** Total free memory to store registry data In bytes. */
   size_t free_registry_data;
+
+  /** Total memory used by deleted or incomplete registry entries in bytes. This memory is not
+   * free, and can only be reused after an az_ulib_registry_clean_all(). */
+  size_t dead_registry_data;
+
+  /** Number of flash write operations done by the registry since its initialization. */
+  uint32_t write_count;
+
+  /** Number of flash read operations done by the registry cache since its initialization, one
+   * for each cache miss. It is always `0` if the registry memory is memory mapped. */
+  uint32_t read_count;
+
+  /** Number of reads served by the registry cache since its initialization, without a flash read.
+   * It is always `0` if the registry memory is memory mapped. */
+  uint32_t cache_hit_count;
+
+  /** Number of flash pages erased by the registry since its initialization. Pages that were
+   * already erased are skipped, and not counted. */
+  uint32_t erase_count;
 } az_ulib_registry_info;
 
+/**
+ * @brief   Registry update mode.
+ *
+ *  Reports how az_ulib_registry_update() stored the new value in the flash.
+ */
+typedef enum
+{
+  /** The new value was programmed over the stored one, no new registry entry was used. */
+  AZ_ULIB_REGISTRY_UPDATE_IN_PLACE = 0,
+
+  /** The new value was stored in a new registry entry, and the old entry was deleted. */
+  AZ_ULIB_REGISTRY_UPDATE_APPEND = 1
+} az_ulib_registry_update_mode;
+
+/**
+ * @brief   Internal registry node, defined by the registry implementation.
+ */
+struct _az_ulib_registry_node;
+
+/**
+ * @brief   Internal registry checkpoint record, defined by the registry implementation.
+ */
+struct _az_ulib_registry_checkpoint;
+
+/**
+ * @brief   Internal entry in the registry write-behind queue.
+ *
+ * The node and the registry data are reserved when the entry is queued, so the entries are stored
+ * in the flash in the same order that they were added.
+ */
+typedef struct
+{
+  /** Node reserved for the entry in the registry information. */
+  struct _az_ulib_registry_node* node;
+
+  /** Offset of the reserved registry data from the registry start. */
+  uint32_t data_offset;
+
+  /** Size of the key in bytes. */
+  uint16_t key_size;
+
+  /** Size of the value in bytes. */
+  uint16_t value_size;
+
+  /** Offset of the copy of the key and value in the queue buffer. */
+  uint32_t buffer_offset;
+} _az_ulib_registry_queue_entry;
+
+/**
+ * @brief   Internal block in the registry read cache.
+ */
+typedef struct
+{
+  /** Flash address of the first byte in the block, `NULL` if the block is empty. */
+  const uint8_t* address;
+
+  /** Number of bytes in the block. */
+  uint32_t size;
+
+  /** Value of the cache clock in the last use of the block. */
+  uint32_t last_use;
+
+  /** Copy of the flash. */
+  uint64_t data[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE / sizeof(uint64_t)];
+} _az_ulib_registry_cache_block;
+
+/**
+ * @brief   Registry instance.
+ *
+ * Each registry instance manages the memory described by one #az_ulib_registry_control_block, and
+ * has its own lock and write-behind queue, so operations in one instance never wait for another.
+ * The memory for the instance is provided by the caller in the az_ulib_registry_instance_init(),
+ * and shall be kept up to the az_ulib_registry_instance_deinit().
+ */
+typedef struct
+{
+  struct
+  {
+    /** Control block with the memory of this instance, `NULL` if not initialized. */
+    const az_ulib_registry_control_block* control_block;
+
+    /** Lock to make the instance operations thread safe. Read-only operations share it. */
+    az_ulib_pal_os_rwlock lock;
+
+    /** Sequence counter, odd while a change that can invalidate a lookup is in progress. */
+    volatile long sequence;
+
+    /** Format of the registry nodes. */
+    int32_t format;
+
+    /** First node in the registry information. */
+    struct _az_ulib_registry_node* first_node;
+
+    /** Size of each node in bytes. */
+    size_t node_size;
+
+    /** First free node in the registry information. */
+    struct _az_ulib_registry_node* free_node;
+
+    /** First free byte in the registry data. */
+    uint8_t* free_data;
+
+    /** Number of live registry nodes. */
+    uint32_t in_use_nodes;
+
+    /** Number of bytes used by live registry nodes. */
+    uint32_t in_use_data;
+
+    /** Number of entries added since the last checkpoint. */
+    uint32_t adds_since_checkpoint;
+
+    /** Number of flash writes since the initialization. */
+    uint32_t write_count;
+
+    /** Number of flash pages erased since the initialization. */
+    uint32_t erase_count;
+
+    /** Current checkpoint record, `NULL` if there is no valid checkpoint. */
+    struct _az_ulib_registry_checkpoint* checkpoint;
+
+    /** Number of queued entries that are not in the flash yet. */
+    volatile long pending;
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+    /** Read cache, only used if the registry memory is not memory mapped. */
+    struct
+    {
+      /** Blocks in the cache. */
+      _az_ulib_registry_cache_block blocks[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS];
+
+      /** Clock incremented on each access to the cache, to find the least recently used block. */
+      uint32_t clock;
+
+      /** Number of flash reads since the initialization. */
+      uint32_t read_count;
+
+      /** Number of cache hits since the initialization. */
+      uint32_t hit_count;
+
+      /** Error of the first flash read that failed since the last API call, `AZ_OK` if none. */
+      az_result read_result;
+    } cache;
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+    /** Write-behind queue. */
+    struct
+    {
+      /** Entries in the queue, including the ones already stored in the flash. */
+      _az_ulib_registry_queue_entry entries[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE];
+
+      /** Copy of the key and value of each entry, aligned to 64 bits. */
+      uint64_t buffer[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_BUFFER_SIZE / sizeof(uint64_t)];
+
+      /** Number of entries in the queue. */
+      uint32_t queued;
+
+      /** Number of entries in the queue already stored in the flash. */
+      uint32_t committed;
+
+      /** Number of bytes used in the buffer. */
+      uint32_t buffer_used;
+
+      /** Result of the first entry that failed to be stored since the last flush. */
+      az_result error;
+
+      /** If `true`, new entries go to the queue. */
+      bool enabled;
+
+      /** Request the worker thread to stop. */
+      volatile bool stop;
+
+      /** Wake up the worker thread when there are new entries, or to stop it. */
+      az_ulib_pal_os_event wakeup;
+
+      /** Worker thread handle. */
+      az_ulib_pal_thread_handle worker;
+    } queue;
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+  } _internal;
+} az_ulib_registry_instance;
+
+/**
+ * @brief   Writer of a registry value stored in chunks.
+ *
+ * Created by az_ulib_registry_add_begin(). The value is written to the flash as it arrives with
+ * az_ulib_registry_writer_write(), and the key only becomes visible in the registry after the
+ * az_ulib_registry_writer_commit().
+ */
+typedef struct
+{
+  struct
+  {
+    /** Registry instance that will receive the value, `NULL` if the writer is closed. */
+    az_ulib_registry_instance* registry;
+
+    /** Key of the new entry. */
+    az_span key;
+
+    /** Index of the node of each chunk, in the order of the value. */
+    uint32_t chunks[AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS];
+
+    /** Number of chunks already stored in the flash. */
+    uint32_t chunk_count;
+
+    /** Number of bytes that the chunks use in the registry data. */
+    uint32_t data_size;
+  } _internal;
+} az_ulib_registry_writer;
+
+/**
+ * @brief   Control block of a ustream with a registry value.
+ *
+ * Memory provided by the caller of az_ulib_registry_try_get_value_ustream(). It shall stay valid
+ * until the release callback is called, after all instances of the ustream are disposed.
+ */
+typedef struct
+{
+  /** The #az_ulib_ustream_data_cb shared by all instances of the ustream. */
+  az_ulib_ustream_data_cb control_block;
+
+  struct
+  {
+    /** Registry instance with the value. */
+    az_ulib_registry_instance* registry;
+
+    /** Node of the entry with the value. */
+    struct _az_ulib_registry_node* node;
+  } _internal;
+} az_ulib_registry_ustream_data_cb;
+
 /**
  * @brief   This function gets the #az_span value associated with the given #az_span key from the
  * registry.
  *
  * This function goes through the registry comparing keys until it finds one that matches the input.
+ * Lookups do not take the registry lock, so they can run concurrently with each other. If a
+ * writer deletes or changes an entry during the lookup, the lookup is repeated, and only waits for
+ * the writer after #AZ_ULIB_CONFIG_REGISTRY_LOOKUP_RETRIES attempts. While there are entries in the
+ * write-behind queue, lookups take the lock and store the queued entries in the flash first, so the
+ * returned value always points to the flash.
  *
  * @param[in]   key                 The #az_span key to look for within the registry.
  * @param[out]  value               The point to #az_span value corresponding to the input key.
@@ -94,15 +396,127 @@ typedef struct
  *                                            successful.
  *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If there are no values that correspond to the
  *                                            given key within the registry.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the registry memory is not memory mapped, or the
+ *                                            value is stored in chunks. Use
+ *                                            az_ulib_registry_try_get_value_copy() or
+ *                                            az_ulib_registry_try_get_value_ustream().
  */
 AZ_NODISCARD az_result az_ulib_registry_try_get_value(az_span key, az_span* value);
 
+/**
+ * @brief   This function copies the value associated with the given #az_span key from the registry
+ * to the caller buffer.
+ *
+ * Same as az_ulib_registry_try_get_value(), but the returned value is a copy in \p buffer, so it
+ * stays valid after any change in the registry. Together with
+ * az_ulib_registry_try_get_value_ustream(), it is the only way to retrieve a value from a
+ * registry in a flash that is not memory mapped, see `external_flash` in
+ * #az_ulib_registry_control_block, or a value stored in chunks. In the first case, the lookup
+ * reads the flash through the registry cache, holding the registry lock.
+ *
+ * @param[in]   key                 The #az_span key to look for within the registry.
+ * @param[in]   buffer              The #az_span with the buffer to copy the value.
+ * @param[out]  value               The pointer to #az_span to return the copy of the value, a slice
+ *                                  of \p buffer.
+ *
+ * @pre         Registry shall already be initialized.
+ * @pre         \p key              shall not be `#AZ_SPAN_EMPTY`.
+ * @pre         \p value            shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                        If the value was copied to the buffer.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If there are no values that correspond to the
+ *                                            given key within the registry.
+ *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE    If the value does not fit in the buffer.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM         If the flash failed to read the registry.
+ */
+AZ_NODISCARD az_result
+az_ulib_registry_try_get_value_copy(az_span key, az_span buffer, az_span* value);
+
+/**
+ * @brief   This function creates a ustream with the value associated with the given #az_span key.
+ *
+ * The ustream reads the value directly from the flash, chunk by chunk, so large values are never
+ * assembled in the RAM. It works for any value, including values stored in chunks with
+ * az_ulib_registry_add_begin(), and values in a flash that is not memory mapped. Each read takes
+ * the registry lock.
+ *
+ * @note    Deleting or updating the key does not change a ustream that was already created, but
+ *          all instances of the ustream shall be disposed before az_ulib_registry_clean_all().
+ *
+ * @param[in]   key                   The #az_span key to look for within the registry.
+ * @param[in]   ustream_control_block The pointer to #az_ulib_registry_ustream_data_cb with the
+ *                                    memory for the ustream control block.
+ * @param[in]   control_block_release The #az_ulib_release_callback to release the
+ *                                    \p ustream_control_block once all instances of the ustream
+ *                                    are disposed. It can be `NULL`.
+ * @param[out]  ustream_instance      The pointer to #az_ulib_ustream to initialize with the value.
+ *
+ * @pre         Registry shall already be initialized.
+ * @pre         \p key              shall not be `#AZ_SPAN_EMPTY`.
+ * @pre         \p ustream_control_block shall not be `NULL`.
+ * @pre         \p ustream_instance shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                        If the ustream was created.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If there are no values that correspond to the
+ *                                            given key within the registry.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM         If the flash failed to read the registry.
+ */
+AZ_NODISCARD az_result az_ulib_registry_try_get_value_ustream(
+    az_span key,
+    az_ulib_registry_ustream_data_cb* ustream_control_block,
+    az_ulib_release_callback control_block_release,
+    az_ulib_ustream* ustream_instance);
+
+/**
+ * @brief   This function returns the next key value pair in the registry that starts with the
+ * given prefix.
+ *
+ * This function walks the registry entries from the position in the \p cursor, skipping deleted
+ * entries and the ones that do not start with \p prefix. The returned key and value point to the
+ * data in the registry, no copy is made. The value of an entry stored in chunks is returned as
+ * `#AZ_SPAN_EMPTY`, use az_ulib_registry_try_get_value_ustream() to read it. The lock is released
+ * between calls, so a caller may iterate over the registry in pages with no impact in the other
+ * registry operations.
+ *
+ * @note    Entries added during the iteration may or may not be returned, and an entry updated
+ *          during the iteration may be returned twice.
+ *
+ * @param[in]       prefix          The #az_span with the prefix of the keys to return. Use
+ *                                  `#AZ_SPAN_EMPTY` to return all keys in the registry.
+ * @param[in, out]  cursor          The pointer to `uint32_t` with the position in the registry.
+ *                                  It shall be `0` on the first call, and this function will
+ *                                  update it to the position for the next call.
+ * @param[out]      key             The pointer to #az_span to return the key.
+ * @param[out]      value           The pointer to #az_span to return the value.
+ *
+ * @pre         Registry shall already be initialized.
+ * @pre         \p cursor           shall not be `NULL`.
+ * @pre         \p key              shall not be `NULL`.
+ * @pre         \p value            shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                        If a key value pair that starts with the prefix was
+ *                                            returned.
+ *      @retval #AZ_ULIB_EOF                  If there are no more keys that start with the prefix.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED       If the registry memory is not memory mapped.
+ */
+AZ_NODISCARD az_result
+az_ulib_registry_iterate(az_span prefix, uint32_t* cursor, az_span* key, az_span* value);
+
 /**
  * @brief   This function adds an #az_span key and an #az_span value into the device registry.
  *
  * This function goes through the registry ensuring there are no duplicate elements before
  * adding a new key value pair to the registry.
  *
+ * If the write-behind is enabled in the #az_ulib_registry_control_block, this function reserves
+ * the space in the flash and returns after copying the key and value to a queue in the RAM. The
+ * new entry is immediately visible to az_ulib_registry_try_get_value(), and a background thread
+ * stores the queued entries in the flash in the same order that they were added. Call
+ * az_ulib_registry_flush() to make sure that the entry is in the flash.
+ *
  * @param[in]   key                 The #az_span key to add to the registry.
  * @param[in]   value               The #az_span value to add to the registry.
  *
@@ -120,9 +534,138 @@ AZ_NODISCARD az_result az_ulib_registry_try_get_value(az_span key, az_span* valu
  *                                                `az_ulib_registry_add` operation are busy.
  *      @retval #AZ_ERROR_OUT_OF_MEMORY           If the flash space for `az_ulib_registry_add`
  *                                                is not enough for a new registry entry.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED           If the key is bigger than 32767 bytes, or the
+ *                                                value is bigger than 65535 bytes. Use
+ *                                                az_ulib_registry_add_begin() for bigger values.
+ *      @retval #AZ_ERROR_ULIB_INCOMPATIBLE_VERSION If the registry was stored in a format that
+ *                                                cannot receive new entries. Call
+ *                                                az_ulib_registry_clean_all() to format it.
  */
 AZ_NODISCARD az_result az_ulib_registry_add(az_span key, az_span value);
 
+/**
+ * @brief   This function starts to add a key with a value stored in chunks.
+ *
+ * Values that are too big for az_ulib_registry_add(), or that are not available in the RAM at
+ * once, like firmware manifests or certificates, can be written to the flash piece by piece with
+ * az_ulib_registry_writer_write(). Each piece is stored in one or more chunks of up to 65535
+ * bytes, with up to #AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS chunks per value, so pieces shall be as
+ * big as possible. The key is only added to the registry by az_ulib_registry_writer_commit(), and
+ * a power failure before it leaves no trace of the key.
+ *
+ * Values stored in chunks cannot be returned as a single #az_span by
+ * az_ulib_registry_try_get_value(), and are read with az_ulib_registry_try_get_value_ustream()
+ * or az_ulib_registry_try_get_value_copy().
+ *
+ * @param[in]   key                 The #az_span key to add to the registry. The memory of the key
+ *                                  shall be kept up to the commit or abort of the writer.
+ * @param[out]  writer              The pointer to #az_ulib_registry_writer to initialize.
+ *
+ * @pre         Registry shall already be initialized.
+ * @pre         \p key              shall not be `#AZ_SPAN_EMPTY`.
+ * @pre         \p writer           shall not be `NULL`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                            If the writer is ready to receive the value.
+ *      @retval #AZ_ERROR_ULIB_ELEMENT_DUPLICATE  If there is a key within the registry that is the
+ *                                                same as the new key.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED           If the key is bigger than 32767 bytes.
+ *      @retval #AZ_ERROR_ULIB_INCOMPATIBLE_VERSION If the registry was stored in a format that
+ *                                                cannot receive new entries.
+ */
+AZ_NODISCARD az_result az_ulib_registry_add_begin(az_span key, az_ulib_registry_writer* writer);
+
+/**
+ * @brief   Write the next piece of a value stored in chunks.
+ *
+ * @param[in]   writer              The pointer to #az_ulib_registry_writer created by
+ *                                  az_ulib_registry_add_begin().
+ * @param[in]   data                The #az_span with the next piece of the value.
+ *
+ * @pre         \p writer           shall be open.
+ * @pre         \p data             shall not be `#AZ_SPAN_EMPTY`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                            If the piece was stored in the flash.
+ *      @retval #AZ_ERROR_OUT_OF_MEMORY           If the flash space is not enough for the piece.
+ *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE        If there is no free registry entry for a new
+ *                                                chunk, or the value already has
+ *                                                #AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS chunks.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM             If the flash failed to store the piece.
+ */
+AZ_NODISCARD az_result az_ulib_registry_writer_write(az_ulib_registry_writer* writer, az_span data);
+
+/**
+ * @brief   Add the key with the value written so far to the registry, and close the writer.
+ *
+ * If the commit fails, the chunks already written are discarded.
+ *
+ * @param[in]   writer              The pointer to #az_ulib_registry_writer to commit.
+ *
+ * @pre         \p writer           shall be open, with at least one piece of the value written.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                            If the key was added to the registry.
+ *      @retval #AZ_ERROR_ULIB_ELEMENT_DUPLICATE  If the key was added to the registry by someone
+ *                                                else after az_ulib_registry_add_begin().
+ *      @retval #AZ_ERROR_OUT_OF_MEMORY           If the flash space is not enough for the entry.
+ *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE        If there is no free registry entry for the key.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM             If the flash failed to store the entry.
+ */
+AZ_NODISCARD az_result az_ulib_registry_writer_commit(az_ulib_registry_writer* writer);
+
+/**
+ * @brief   Discard the value written so far, and close the writer.
+ *
+ * @param[in]   writer              The pointer to #az_ulib_registry_writer to abort.
+ *
+ * @pre         \p writer           shall be open.
+ */
+void az_ulib_registry_writer_abort(az_ulib_registry_writer* writer);
+
+/**
+ * @brief   This function updates the #az_span value associated with an existing #az_span key in the
+ * device registry.
+ *
+ * If the registry control block is `reprogrammable`, the new value has the same size as the
+ * stored one, and it only clears bits of the stored value, this function programs the new value
+ * over the old one in place, without spending a new registry entry. Otherwise, it appends a new
+ * entry with the new value, and only after that marks the old entry as deleted.
+ *
+ * @note    To make small values updatable in place in a `reprogrammable` flash, reserve the value
+ *          slot with bits set. For example, a flag stored as `0xFFFFFFFF` can have its bits
+ *          cleared one by one with no new entry in the registry.
+ *
+ * @param[in]   key                 The #az_span key to update in the registry.
+ * @param[in]   value               The #az_span new value for the key.
+ * @param[out]  mode                The pointer to #az_ulib_registry_update_mode to return how the
+ *                                  value was stored. It can be `NULL`.
+ *
+ * @pre         Registry shall already be initialized.
+ * @pre         \p key              shall not be `#AZ_SPAN_EMPTY`.
+ * @pre         \p value            shall not be `#AZ_SPAN_EMPTY`.
+ *
+ * @return The #az_result with the result of the registry operations.
+ *      @retval #AZ_OK                            If updating the value in the registry was
+ *                                                successful.
+ *      @retval #AZ_ERROR_ITEM_NOT_FOUND          If there are no values that correspond to the
+ *                                                given key within the registry.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM             If the `az_ulib_registry_update` operation failed
+ *                                                on the system level.
+ *      @retval #AZ_ERROR_ULIB_BUSY               If the resources necessary for the
+ *                                                `az_ulib_registry_update` operation are busy.
+ *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE        If the value cannot be updated in place, and there
+ *                                                is no free registry entry to append it.
+ *      @retval #AZ_ERROR_OUT_OF_MEMORY           If the value cannot be updated in place, and the
+ *                                                flash space is not enough for a new entry.
+ *      @retval #AZ_ERROR_NOT_SUPPORTED           If the value cannot be updated in place, and it
+ *                                                is bigger than 65535 bytes.
+ *      @retval #AZ_ERROR_ULIB_INCOMPATIBLE_VERSION If the value cannot be updated in place, and
+ *                                                the registry format cannot receive new entries.
+ */
+AZ_NODISCARD az_result
+az_ulib_registry_update(az_span key, az_span value, az_ulib_registry_update_mode* mode);
+
 /**
  * @brief   This function removes an #az_span key and its corresponding #az_span value from the
  * device registry.
@@ -153,11 +696,28 @@ AZ_NODISCARD az_result az_ulib_registry_delete(az_span key);
  * This function initializes components that the registry needs upon reboot. This function is not
  * thread safe and all other APIs shall only be invoked after the initialization ends.
  *
+ * During the initialization, the registry validates the stored entries, and marks as deleted the
+ * ones that were not completely written, for example because of a power failure in the middle of
+ * an add. If the control block provides memory for checkpoints, the registry resumes from the
+ * last checkpoint, only validating the entries added after it, and stores a new checkpoint at the
+ * end of the initialization.
+ *
+ * If the control block enables the write-behind, this function starts the background thread that
+ * stores the queued entries. If the thread cannot be created, the registry stores the new entries
+ * synchronously.
+ *
+ * The registry information starts with a header that identifies the version of the node format.
+ * Nodes store the key and value as offsets from `registry_start` with their sizes, so the same
+ * registry image is valid regardless of the address where the flash is mapped, or the size of the
+ * pointers in the device. A registry stored before the header was introduced is still read, its
+ * entries can be retrieved, updated in place and deleted, but new entries are only accepted after
+ * az_ulib_registry_clean_all() formats the registry with the current version.
+ *
  * @note    This API **is not** thread safe. The other Registry APIs shall only be called after the
  *          initialization process is complete.
  *
  * @note    Double initialization of this singleton component shall result in a unpredictable
- *          behavior.
+ *          behavior. To manage more than one registry, use az_ulib_registry_instance_init().
  *
  * @param[in]   registry_cb         The pointer to #az_ulib_registry_control_block with the control
  *                                  block that contains the registry memory.
@@ -171,7 +731,8 @@ void az_ulib_registry_init(const az_ulib_registry_control_block* registry_cb);
  *
  * This function deinitializes components that the registry used. The registry can be reinitialized.
  * This function is not thread safe and all other APIs shall release the resource before calling
- * the deinit() function.
+ * the deinit() function. If the write-behind is enabled, this function stops the background
+ * thread, and stores all queued entries in the flash.
  *
  * @note    This API **is not** thread safe, no other Registry API may be called during the
  *          execution of this deinit and no other Registry API shall be running during the
@@ -192,10 +753,32 @@ void az_ulib_registry_deinit(void);
  */
 void az_ulib_registry_clean_all(void);
 
+/**
+ * @brief   Store all queued entries in the flash.
+ *
+ * If the write-behind is enabled, new entries are stored in the flash by a background thread.
+ * This function stores all entries that are still in the queue before it returns, so callers can
+ * use it as a barrier when they need the entries to survive a power failure. The registry APIs
+ * that change or iterate existing entries also store the queued entries first.
+ *
+ * If the write-behind is not enabled, there is nothing to store and this function returns
+ * #AZ_OK.
+ *
+ * @pre         Registry shall already be initialized.
+ *
+ * @return The #az_result with the result of the flush.
+ *      @retval #AZ_OK                            If all queued entries were stored in the flash.
+ *      @retval #AZ_ERROR_ULIB_SYSTEM             If the flash failed to store one of the entries
+ *                                                queued since the last flush. The failed entry is
+ *                                                not in the registry.
+ */
+AZ_NODISCARD az_result az_ulib_registry_flush(void);
+
 /**
  * @brief   Return the registry information.
  *
- * Return the current information about the registry memory utilization.
+ * Return the current information about the registry memory utilization. The information is kept
+ * up to date by the other registry APIs, so this function does not scan the flash.
  *
  * @param[out]  info                The point to #az_ulib_registry_info to return the registry
  *                                  information.
@@ -205,6 +788,168 @@ void az_ulib_registry_clean_all(void);
  */
 void az_ulib_registry_get_info(az_ulib_registry_info* info);
 
+/**
+ * @brief   Initialize a registry instance.
+ *
+ * Same as az_ulib_registry_init(), for the registry in the memory described by \p registry_cb.
+ * Each instance has its own lock and write-behind queue, so a small partition for data that
+ * changes frequently can run independently of a large partition for configuration blobs. The
+ * default registry used by the other registry APIs is an instance as well.
+ *
+ * @note    Two instances shall never share the same registry memory.
+ *
+ * @param[out]  registry            The pointer to #az_ulib_registry_instance to initialize. The
+ *                                  memory shall be kept up to the
+ *                                  az_ulib_registry_instance_deinit().
+ * @param[in]   registry_cb         The pointer to #az_ulib_registry_control_block with the control
+ *                                  block that contains the registry memory.
+ *
+ * @pre         \p registry         shall not be `NULL`.
+ * @pre         \p registry_cb      shall not be `NULL`.
+ * @pre         \p registry         shall **not** be initialized.
+ */
+void az_ulib_registry_instance_init(
+    az_ulib_registry_instance* registry,
+    const az_ulib_registry_control_block* registry_cb);
+
+/**
+ * @brief   Deinitialize a registry instance.
+ *
+ * Same as az_ulib_registry_deinit(), for the given registry instance.
+ *
+ * @param[in]   registry            The pointer to #az_ulib_registry_instance to deinitialize.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+void az_ulib_registry_instance_deinit(az_ulib_registry_instance* registry);
+
+/**
+ * @brief   Get a value from a registry instance.
+ *
+ * Same as az_ulib_registry_try_get_value(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span* value);
+
+/**
+ * @brief   Copy a value from a registry instance.
+ *
+ * Same as az_ulib_registry_try_get_value_copy(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value_copy(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span buffer,
+    az_span* value);
+
+/**
+ * @brief   Create a ustream with a value from a registry instance.
+ *
+ * Same as az_ulib_registry_try_get_value_ustream(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value_ustream(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_ulib_registry_ustream_data_cb* ustream_control_block,
+    az_ulib_release_callback control_block_release,
+    az_ulib_ustream* ustream_instance);
+
+/**
+ * @brief   Iterate over the entries of a registry instance.
+ *
+ * Same as az_ulib_registry_iterate(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_iterate(
+    az_ulib_registry_instance* registry,
+    az_span prefix,
+    uint32_t* cursor,
+    az_span* key,
+    az_span* value);
+
+/**
+ * @brief   Add a key value pair to a registry instance.
+ *
+ * Same as az_ulib_registry_add(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result
+az_ulib_registry_instance_add(az_ulib_registry_instance* registry, az_span key, az_span value);
+
+/**
+ * @brief   Start to add a key with a value stored in chunks to a registry instance.
+ *
+ * Same as az_ulib_registry_add_begin(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_add_begin(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_ulib_registry_writer* writer);
+
+/**
+ * @brief   Update the value of a key in a registry instance.
+ *
+ * Same as az_ulib_registry_update(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_update(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span value,
+    az_ulib_registry_update_mode* mode);
+
+/**
+ * @brief   Remove a key from a registry instance.
+ *
+ * Same as az_ulib_registry_delete(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result
+az_ulib_registry_instance_delete(az_ulib_registry_instance* registry, az_span key);
+
+/**
+ * @brief   Erase all memory of a registry instance.
+ *
+ * Same as az_ulib_registry_clean_all(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+void az_ulib_registry_instance_clean_all(az_ulib_registry_instance* registry);
+
+/**
+ * @brief   Store all queued entries of a registry instance in the flash.
+ *
+ * Same as az_ulib_registry_flush(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+AZ_NODISCARD az_result az_ulib_registry_instance_flush(az_ulib_registry_instance* registry);
+
+/**
+ * @brief   Return the information of a registry instance.
+ *
+ * Same as az_ulib_registry_get_info(), for the given registry instance.
+ *
+ * @pre         \p registry         shall already be initialized.
+ */
+void az_ulib_registry_instance_get_info(
+    az_ulib_registry_instance* registry,
+    az_ulib_registry_info* info);
+
 #include "azure/core/_az_cfg_suffix.h"
 
 #endif /* AZ_ULIB_REGISTRY_API_H */
@@ -95,6 +95,12 @@ AZ_NODISCARD az_result az_ulib_ustream_init(
  *     `ustream_instance` and `ustream_to_concat` will have to be disposed by the calling
  *     function.
  *
+ *  If the `ustream_instance` is already a concatenated ustream, no other instance shares it, and
+ *     its `az_ulib_ustream_multi_data_cb` has a free segment, the concat appends the
+ *     `ustream_to_concat` to that `az_ulib_ustream_multi_data_cb` instead, so concatenating many
+ *     ustreams does not make the reads slower. In this case, the passed `multi_data` is not used,
+ *     and the concat calls the `multi_data_release` before it returns.
+ *
  * @param[in,out]  ustream_instance        The #az_ulib_ustream* with the interface of the
  *                                         ustream. It cannot be `NULL`, and it shall be a
  *                                         valid ustream.
@@ -156,6 +162,101 @@ AZ_NODISCARD az_result az_ulib_ustream_split(
     az_ulib_ustream* ustream_instance_split,
     offset_t split_pos);
 
+/**
+ * @brief   Get the next contiguous data in the ustream without copying it.
+ *
+ *  The peek returns an `az_span` that points to the next contiguous bytes in the ustream, from
+ *     the current position up to the end of the memory where the data is located. It does not
+ *     change the current position, so the caller shall call az_ulib_ustream_advance() with the
+ *     number of bytes that it consumed to move forward.
+ *
+ *  If the ustream cannot expose its memory, the peek copies the next bytes to the provided
+ *     `buffer`, and the returned `span` points to the copied data in the `buffer`.
+ *
+ *  The returned `span` is read-only, the caller cannot change its content. It is valid until the
+ *     ustream is disposed or, if it points to the `buffer`, until the next change in the `buffer`.
+ *
+ * @param[in]      ustream_instance        The #az_ulib_ustream* with the interface of the
+ *                                         ustream. It cannot be `NULL`, and it shall be a valid
+ *                                         ustream.
+ * @param[in]      buffer                  The `az_span` with the memory to copy the data to if
+ *                                         the ustream cannot expose its memory. It may be
+ *                                         #AZ_SPAN_EMPTY if the caller only accepts data without
+ *                                         copy.
+ * @param[out]     span                    The pointer to `az_span` that will receive the next
+ *                                         contiguous data in the ustream. It cannot be `NULL`.
+ *
+ * @return The #az_result with the result of the `peek` operation.
+ *     @retval #AZ_OK                         If the `span` points to the next data in the ustream.
+ *     @retval #AZ_ULIB_EOF                   If there is no more data in the ustream.
+ *     @retval #AZ_ERROR_NOT_SUPPORTED        If the ustream cannot expose its memory, and the
+ *                                            `buffer` is empty.
+ *     @retval #AZ_ERROR_ULIB_BUSY            If the resource necessary to read the ustream is
+ *                                            busy.
+ *     @retval #AZ_ERROR_ULIB_SYSTEM          If the read operation failed on the system level.
+ */
+AZ_NODISCARD az_result
+az_ulib_ustream_peek(az_ulib_ustream* ustream_instance, az_span buffer, az_span* const span);
+
+/**
+ * @brief   Move the current position of the ustream forward.
+ *
+ *  The advance consumes `size` bytes from the current position of the ustream. It is the
+ *     counterpart of the az_ulib_ustream_peek(), but it can move the position over any number of
+ *     bytes up to the end of the ustream.
+ *
+ * @param[in]      ustream_instance        The #az_ulib_ustream* with the interface of the
+ *                                         ustream. It cannot be `NULL`, and it shall be a valid
+ *                                         ustream.
+ * @param[in]      size                    The `size_t` with the number of bytes to consume.
+ *
+ * @return The #az_result with the result of the `advance` operation.
+ *     @retval #AZ_OK                         If the current position moved forward with success.
+ *     @retval #AZ_ERROR_ITEM_NOT_FOUND       If the new position is after the end of the ustream.
+ *     @retval #AZ_ERROR_ULIB_BUSY            If the resource necessary to move the position is
+ *                                            busy.
+ *     @retval #AZ_ERROR_ULIB_SYSTEM          If the operation failed on the system level.
+ */
+AZ_NODISCARD az_result az_ulib_ustream_advance(az_ulib_ustream* ustream_instance, size_t size);
+
+/**
+ * @brief   Read the next portion of the ustream into multiple buffers.
+ *
+ *  The readv copies the content of the ustream, starting at the current position, to the
+ *     provided `buffers`, in order. It fills each buffer before moving to the next one, so the
+ *     caller can read, for example, a header and a payload to different places with a single call.
+ *     Empty buffers are skipped.
+ *
+ *  It follows the same rules of az_ulib_ustream_read(). The current position moves forward by the
+ *     number of bytes returned in `size`, and only the last buffer with data may be partially
+ *     filled, if the ustream ends before the buffers.
+ *
+ * @param[in]      ustream_instance        The #az_ulib_ustream* with the interface of the
+ *                                         ustream. It cannot be `NULL`, and it shall be a valid
+ *                                         ustream.
+ * @param[in]      buffers                 The array of `az_span` with the buffers to copy the
+ *                                         data to. It cannot be `NULL`.
+ * @param[in]      buffers_count           The `size_t` with the number of `az_span` in
+ *                                         `buffers`. It shall be larger than zero.
+ * @param[out]     size                    The `size_t* const` that points to the place where the
+ *                                         readv shall store the total number of `uint8_t`
+ *                                         values copied to the buffers. It cannot be `NULL`.
+ *
+ * @return The #az_result with the result of the `readv` operation.
+ *     @retval #AZ_OK                         If the ustream copied its content to the buffers with
+ *                                            success.
+ *     @retval #AZ_ULIB_EOF                   If there are no more `uint8_t` values in the ustream
+ *                                            to read.
+ *     @retval #AZ_ERROR_ULIB_BUSY            If the resource necessary to read the ustream is
+ *                                            busy.
+ *     @retval #AZ_ERROR_ULIB_SYSTEM          If the read operation failed on the system level.
+ */
+AZ_NODISCARD az_result az_ulib_ustream_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size);
+
 #include "azure/core/_az_cfg_suffix.h"
 
 #endif /* AZ_ULIB_USTREAM_H */
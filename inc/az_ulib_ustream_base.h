@@ -330,6 +330,7 @@
 #include "az_ulib_config.h"
 #include "az_ulib_pal_api.h"
 #include "az_ulib_result.h"
+#include "azure/core/az_span.h"
 
 #ifdef __cplusplus
 #include <cstddef>
@@ -387,6 +388,19 @@ typedef struct az_ulib_ustream_interface_tag
   /** Concrete `dispose` implementation. */
   az_result (*dispose)(az_ulib_ustream* ustream_instance);
 
+  /** Concrete `peek` implementation. It is `NULL` if the ustream cannot expose its memory, in
+   * which case az_ulib_ustream_peek() copies the data. */
+  az_result (*peek)(az_ulib_ustream* ustream_instance, az_span* const span);
+
+  /** Concrete `readv` implementation. It is `NULL` if the ustream has no better way to fill
+   * multiple buffers than one read for each buffer, in which case az_ulib_ustream_readv() calls
+   * the `read`. */
+  az_result (*readv)(
+      az_ulib_ustream* ustream_instance,
+      const az_span* const buffers,
+      size_t buffers_count,
+      size_t* const size);
+
 } az_ulib_ustream_interface;
 
 /**
@@ -474,11 +488,16 @@ struct az_ulib_ustream_tag
  *
  * When concatenating a ustream to another ustream, the instances are placed into a
  *      `az_ulib_ustream_multi_data_cb`. The base ustream onto which you wish to concatenate will
- *      be copied into the `ustream_one` structure and the ustream to concatenate will be cloned
- *      into the `ustream_two` structure. The difference being that the first #az_ulib_ustream*,
- *      when returned, will point to the newly populated multi instance and the ownership of the
- *      passed instance will be assumed by the multi instance. The second ustream which was passed
- *      will not be changed, only cloned into the `az_ulib_ustream_multi_data_cb` structure.
+ *      be copied into the first segment and the ustream to concatenate will be cloned into the
+ *      next segment. The difference being that the first #az_ulib_ustream*, when returned, will
+ *      point to the newly populated multi instance and the ownership of the passed instance will
+ *      be assumed by the multi instance. The second ustream which was passed will not be changed,
+ *      only cloned into the `az_ulib_ustream_multi_data_cb` structure.
+ *
+ * Concatenating more ustreams to a multi instance appends them to the free segments of the same
+ *      structure, up to #AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS. The `segments_end` keeps the end
+ *      position of each segment, so a position is found with a binary search, and sequential
+ *      reads continue from the last read segment.
  *
  * @note    This structure should be viewed and used as internal to the implementation of the
  *          ustream. Users should therefore not act on it directly and only allocate the memory
@@ -490,17 +509,17 @@ typedef struct az_ulib_ustream_multi_data_cb_tag
   /** The #az_ulib_ustream_data_cb to manage the multi data structure. */
   az_ulib_ustream_data_cb control_block;
 
-  /** The #az_ulib_ustream with the first ustream instance. */
-  az_ulib_ustream ustream_one;
+  /** The array of #az_ulib_ustream with the concatenated ustream instances, in order. */
+  az_ulib_ustream segments[AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS];
 
-  /** The #az_ulib_ustream with the second ustream instance. */
-  az_ulib_ustream ustream_two;
+  /** The array of #offset_t with the position right after the end of each segment. */
+  offset_t segments_end[AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS];
 
-  /** The `long` with the number of references to the first ustream. */
-  volatile long ustream_one_ref_count;
+  /** The `size_t` with the number of segments in use. */
+  size_t segments_count;
 
-  /** The `long` with the number of references to the second ustream. */
-  volatile long ustream_two_ref_count;
+  /** The `size_t` with the index of the segment where the last read stopped. */
+  size_t current_segment;
 
   /** The #az_ulib_pal_os_lock with controls the critical section of the read from the multi
    * ustream. */
@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+/**
+ * @file az_ulib_ustream_pool.h
+ *
+ * @brief Fixed-block pool for the ustream control blocks.
+ *
+ * The ustream factories receive the control blocks from the caller, and release them with the
+ * provided #az_ulib_release_callback. Instead of allocating them from the heap, the caller may
+ * take them from this pool, and pass the pool release function as the `control_block_release`.
+ *
+ * @code
+ * az_ulib_ustream_data_cb* control_block = az_ulib_ustream_pool_alloc_data_cb();
+ * if (control_block != NULL)
+ * {
+ *   result = az_ulib_ustream_init(
+ *       &ustream_instance,
+ *       control_block,
+ *       az_ulib_ustream_pool_release_data_cb,
+ *       buffer,
+ *       buffer_length,
+ *       NULL);
+ * }
+ * @endcode
+ *
+ * The pool keeps a static array of blocks for each control block type, with the sizes defined by
+ * #AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB and #AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB. The alloc
+ * and release functions are lock-free, so they can be called from any thread, and do not block
+ * when another thread is allocating or releasing blocks.
+ */
+
+#ifndef AZ_ULIB_USTREAM_POOL_H
+#define AZ_ULIB_USTREAM_POOL_H
+
+#include "az_ulib_ustream_base.h"
+
+#include "azure/core/_az_cfg_prefix.h"
+
+/**
+ * @brief   Allocate an #az_ulib_ustream_data_cb from the pool.
+ *
+ * @return The pointer to the #az_ulib_ustream_data_cb, or `NULL` if all blocks are in use.
+ */
+AZ_NODISCARD az_ulib_ustream_data_cb* az_ulib_ustream_pool_alloc_data_cb(void);
+
+/**
+ * @brief   Release an #az_ulib_ustream_data_cb to the pool.
+ *
+ * This function has the signature of the #az_ulib_release_callback, so it can be passed as the
+ * `control_block_release` to the ustream factories.
+ *
+ * @param[in]   release_pointer     The pointer to the #az_ulib_ustream_data_cb returned by
+ *                                  az_ulib_ustream_pool_alloc_data_cb(). It cannot be `NULL`.
+ */
+void az_ulib_ustream_pool_release_data_cb(void* release_pointer);
+
+/**
+ * @brief   Allocate an #az_ulib_ustream_multi_data_cb from the pool.
+ *
+ * @return The pointer to the #az_ulib_ustream_multi_data_cb, or `NULL` if all blocks are in use.
+ */
+AZ_NODISCARD az_ulib_ustream_multi_data_cb* az_ulib_ustream_pool_alloc_multi_data_cb(void);
+
+/**
+ * @brief   Release an #az_ulib_ustream_multi_data_cb to the pool.
+ *
+ * This function has the signature of the #az_ulib_release_callback, so it can be passed as the
+ * `multi_data_release` to az_ulib_ustream_concat().
+ *
+ * @param[in]   release_pointer     The pointer to the #az_ulib_ustream_multi_data_cb returned by
+ *                                  az_ulib_ustream_pool_alloc_multi_data_cb(). It cannot be
+ *                                  `NULL`.
+ */
+void az_ulib_ustream_pool_release_multi_data_cb(void* release_pointer);
+
+#include "azure/core/_az_cfg_suffix.h"
+
+#endif /* AZ_ULIB_USTREAM_POOL_H */
@@ -6,86 +6,58 @@
 #define AZ_ULIB_GCC_ARM_CM4F_PORT_H
 
 #ifdef __cplusplus
+#include <cstdbool>
 #include <cstdint>
 extern "C"
 {
 #else
+#include <stdbool.h>
 #include <stdint.h>
 #endif
 
-  __attribute__((always_inline)) static inline long AZ_ULIB_PORT_ATOMIC_INC_W(volatile long* addr)
-  {
-    register long prev;
-    register long modified;
-    register long result;
-
-    __asm volatile("1:     ldrex   %0, [%3]                \n"
-                   "       mov     %1, %0                  \n"
-                   "       adds    %0, #1                  \n"
-                   "       strex   %2, %0, [%3]            \n"
-                   "       cmp     %2, #0                  \n"
-                   "       bne     1b                      "
-                   : "=&r"(result), "=&r"(prev), "=&r"(modified)
-                   : "r"(addr)
-                   : "cc", "memory");
-
-    return prev;
-  }
-
-  __attribute__((always_inline)) static inline long AZ_ULIB_PORT_ATOMIC_DEC_W(volatile long* addr)
-  {
-    register long prev;
-    register long modified;
-    register long result;
-
-    __asm volatile("1:     ldrex   %0, [%3]                \n"
-                   "       mov     %1, %0                  \n"
-                   "       subs    %0, #1                  \n"
-                   "       strex   %2, %0, [%3]            \n"
-                   "       cmp     %2, #0                  \n"
-                   "       bne     1b                      "
-                   : "=&r"(result), "=&r"(prev), "=&r"(modified)
-                   : "r"(addr)
-                   : "cc", "memory");
-
-    return prev;
-  }
-
-  __attribute__((always_inline)) static inline long AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(
-      volatile long* addr,
-      long val)
-  {
-    register long result;
-    register long modified;
-
-    __asm volatile("1:     ldrex   %0, [%2]                \n"
-                   "       strex   %1, %3, [%2]            \n"
-                   "       cmp     %1, #0                  \n"
-                   "       bne     1b                      "
-                   : "=&r"(result), "=&r"(modified)
-                   : "r"(addr), "r"(val)
-                   : "cc", "memory");
-
-    return result;
-  }
-
-  __attribute__((always_inline)) static inline void* AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(
-      const volatile void** addr,
-      const void* val)
-  {
-    register void* result;
-    register long modified;
-
-    __asm volatile("1:     ldrex   %0, [%2]                \n"
-                   "       strex   %1, %3, [%2]            \n"
-                   "       cmp     %1, #0                  \n"
-                   "       bne     1b                      "
-                   : "=&r"(result), "=&r"(modified)
-                   : "r"(addr), "r"(val)
-                   : "cc", "memory");
-
-    return result;
-  }
+  /*
+   * The Cortex-M4 has exclusive load and store (ldrex/strex) and the dmb barrier, which is all that
+   * GCC needs to inline the __atomic builtins, so this port uses them instead of hand written
+   * assembly. The semantics are the same for all ports:
+   *  - LOAD and STORE are sequentially consistent, LOAD_ACQUIRE and STORE_RELEASE only order the
+   *    memory accesses after the load, or before the store.
+   *  - INC and DEC return the new value.
+   *  - FETCH_ADD, FETCH_SUB, FETCH_OR, FETCH_AND and EXCHANGE return the previous value.
+   *  - COMPARE_EXCHANGE stores `desired` only if the value is `*expected`, and returns `true`.
+   *    Otherwise, it copies the value to `*expected` and returns `false`.
+   *  - THREAD_FENCE is a full memory barrier.
+   * The builtins are generic, so the same macros serve the _W and _PTR variants.
+   */
+#define AZ_ULIB_PORT_ATOMIC_LOAD_W(addr) __atomic_load_n((addr), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr) __atomic_load_n((addr), __ATOMIC_ACQUIRE)
+#define AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value) \
+  __atomic_store_n((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value) \
+  __atomic_store_n((addr), (value), __ATOMIC_RELEASE)
+#define AZ_ULIB_PORT_ATOMIC_INC_W(addr) __atomic_add_fetch((addr), 1, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_DEC_W(addr) __atomic_sub_fetch((addr), 1, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_ADD_W(addr, value) \
+  __atomic_fetch_add((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_SUB_W(addr, value) \
+  __atomic_fetch_sub((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_OR_W(addr, value) \
+  __atomic_fetch_or((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_AND_W(addr, value) \
+  __atomic_fetch_and((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value) \
+  __atomic_exchange_n((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(addr, expected, desired) \
+  __atomic_compare_exchange_n(                                         \
+      (addr), (expected), (desired), false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr) AZ_ULIB_PORT_ATOMIC_LOAD_W(addr)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_PTR(addr) AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr)
+#define AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value) AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_PTR(addr, value) \
+  AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(addr, value) AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_PTR(addr, expected, desired) \
+  AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(addr, expected, desired)
+#define AZ_ULIB_PORT_ATOMIC_THREAD_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
 
   __attribute__((always_inline)) static inline void AZ_ULIB_PORT_GET_DATA_CONTEXT(
       volatile void** data_address)
@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ *
+ * @brief   File backed flash for Linux.
+ *
+ * When the PAL is built with `ULIB_PAL_FLASH_DRIVER=file`, the flash driver emulates a NOR flash
+ * over a file mapped in memory with `mmap`. The erase sets the bytes to `0xFF`, and the write only
+ * clears bits, exactly as a NOR flash does. Changes are flushed to the file with `msync` when a
+ * write is closed, when a single doubleword is written, and after an erase.
+ *
+ * A registry stored in the legacy format keeps pointers to its own data, so the file shall always
+ * be mapped at the same address to be read back after a restart.
+ */
+
+#ifndef AZ_ULIB_PAL_FLASH_FILE_H
+#define AZ_ULIB_PAL_FLASH_FILE_H
+
+#include "az_ulib_result.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+extern "C"
+{
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/**
+ * @brief   Default address to map the flash file.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFF
+#define AZ_ULIB_PAL_FLASH_FILE_DEFAULT_ADDRESS ((void*)(uintptr_t)0x7E0000000000)
+#else
+#define AZ_ULIB_PAL_FLASH_FILE_DEFAULT_ADDRESS ((void*)(uintptr_t)0x70000000)
+#endif
+
+  /**
+   * @brief   Map a file as the device flash.
+   *
+   * Open or create the file in \p path and map it in memory at \p base_address. If the file is new
+   * or smaller than \p size, it is extended to \p size bytes, and the new bytes are erased.
+   *
+   * @param[in]   path              The `const char*` with the path of the file.
+   * @param[in]   base_address      The `void*` with the address to map the file. Use
+   *                                #AZ_ULIB_PAL_FLASH_FILE_DEFAULT_ADDRESS if there is no
+   *                                specific address.
+   * @param[in]   size              The `size_t` with the size of the flash in bytes. It shall be
+   *                                multiple of the system page size.
+   * @param[out]  flash_start       The pointer to `void*` to return the start of the flash.
+   *
+   * @pre         \p path           shall not be `NULL`.
+   * @pre         \p size           shall be bigger than 0.
+   * @pre         \p flash_start    shall not be `NULL`.
+   *
+   * @return The #az_result with the result of the map operation.
+   *      @retval #AZ_OK                              If the file was mapped with success.
+   *      @retval #AZ_ERROR_ULIB_ALREADY_INITIALIZED  If there is a file already mapped.
+   *      @retval #AZ_ERROR_ULIB_SYSTEM               If the file could not be opened, extended or
+   *                                                  mapped at \p base_address.
+   */
+  az_result az_ulib_pal_flash_file_open(
+      const char* path,
+      void* base_address,
+      size_t size,
+      void** flash_start);
+
+  /**
+   * @brief   Unmap the flash file.
+   *
+   * Flush all pending changes to the file, unmap and close it.
+   */
+  void az_ulib_pal_flash_file_close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AZ_ULIB_PAL_FLASH_FILE_H */
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+/**
+ * @file
+ *
+ * @brief   Simulated flash for Linux.
+ *
+ * When the PAL is built with `ULIB_PAL_FLASH_DRIVER=sim`, the flash driver emulates a NOR flash
+ * over RAM, and keeps the information needed to evaluate the flash usage without real hardware.
+ * The erase sets the bytes to `0xFF`, and the write only clears bits, exactly as a NOR flash does.
+ *
+ * The simulator models the latency of each doubleword program, page erase and read, counts the
+ * programs and erases in each page of the regions added with az_ulib_pal_flash_sim_add_region(),
+ * and detects writes that try to change a bit from `0` to `1` without an erase. Memory out of the
+ * regions keeps the NOR behavior and the totals, but does not have page counters.
+ *
+ * @note    The simulator is not thread safe. The registry already serializes the flash accesses.
+ */
+
+#ifndef AZ_ULIB_PAL_FLASH_SIM_H
+#define AZ_ULIB_PAL_FLASH_SIM_H
+
+#include "az_ulib_result.h"
+
+#ifdef __cplusplus
+#include <cstdbool>
+#include <cstddef>
+#include <cstdint>
+extern "C"
+{
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+/**
+ * @brief   Maximum number of regions in the simulated flash.
+ */
+#define AZ_ULIB_PAL_FLASH_SIM_MAX_REGIONS 4
+
+  /**
+   * @brief   Simulated flash configuration.
+   */
+  typedef struct
+  {
+    /** Size of the flash page in bytes, the erase is aligned to it. */
+    uint32_t page_size;
+
+    /** Time in nanoseconds to program one doubleword. */
+    uint32_t program_latency_ns;
+
+    /** Time in nanoseconds to erase one page. */
+    uint32_t erase_latency_ns;
+
+    /** Time in nanoseconds of one read, like the command and address phases of a SPI flash
+     * read. */
+    uint32_t read_latency_ns;
+
+    /** If `true`, each operation blocks the caller for its latency. Otherwise, the latency is
+     * only accumulated in #az_ulib_pal_flash_sim_stats. */
+    bool block_on_latency;
+
+    /** If `true`, a write that changes a bit from `0` to `1` fails with
+     * #AZ_ERROR_ULIB_SYSTEM. Otherwise, it is only counted. */
+    bool fail_on_illegal_program;
+  } az_ulib_pal_flash_sim_config;
+
+  /**
+   * @brief   Simulated flash statistics.
+   */
+  typedef struct
+  {
+    /** Number of doublewords programmed. */
+    uint64_t program_count;
+
+    /** Number of pages erased. */
+    uint64_t erase_count;
+
+    /** Number of reads done with _az_ulib_pal_flash_driver_read(). Memory mapped accesses are not
+     * counted. */
+    uint64_t read_count;
+
+    /** Number of bytes read with _az_ulib_pal_flash_driver_read(). */
+    uint64_t read_bytes;
+
+    /** Number of doublewords programmed with a bit changing from `0` to `1`. */
+    uint64_t illegal_program_count;
+
+    /** Total flash latency in nanoseconds. */
+    uint64_t busy_time_ns;
+  } az_ulib_pal_flash_sim_stats;
+
+  /**
+   * @brief   Configure the simulated flash.
+   *
+   * Set the flash geometry and latencies, remove all regions, and reset the statistics.
+   *
+   * @param[in]   config            The pointer to #az_ulib_pal_flash_sim_config with the flash
+   *                                configuration. If `NULL`, the simulator uses pages of 2KB with
+   *                                no latency.
+   */
+  void az_ulib_pal_flash_sim_configure(const az_ulib_pal_flash_sim_config* config);
+
+  /**
+   * @brief   Add a region to the simulated flash.
+   *
+   * Memory in the region has a program and an erase counter for each page. The region is not
+   * erased by this function.
+   *
+   * @param[in]   start             The `void*` with the start of the region. It shall be aligned to
+   *                                the page size.
+   * @param[in]   size              The `size_t` with the size of the region in bytes. It shall be
+   *                                multiple of the page size.
+   *
+   * @return The #az_result with the result of the operation.
+   *      @retval #AZ_OK                        If the region was added with success.
+   *      @retval #AZ_ERROR_ARG                 If the region is not aligned to the page size.
+   *      @retval #AZ_ERROR_NOT_ENOUGH_SPACE    If there are already
+   *                                            #AZ_ULIB_PAL_FLASH_SIM_MAX_REGIONS regions.
+   *      @retval #AZ_ERROR_OUT_OF_MEMORY       If there is no memory for the page counters.
+   */
+  az_result az_ulib_pal_flash_sim_add_region(void* start, size_t size);
+
+  /**
+   * @brief   Remove all regions and release their page counters.
+   */
+  void az_ulib_pal_flash_sim_remove_all_regions(void);
+
+  /**
+   * @brief   Return the simulated flash statistics.
+   *
+   * @param[out]  stats             The pointer to #az_ulib_pal_flash_sim_stats to return the
+   *                                statistics.
+   */
+  void az_ulib_pal_flash_sim_get_stats(az_ulib_pal_flash_sim_stats* stats);
+
+  /**
+   * @brief   Return the counters of one page.
+   *
+   * @param[in]   region            The `uint32_t` with the index of the region, in the order they
+   *                                were added.
+   * @param[in]   page              The `uint32_t` with the index of the page in the region.
+   * @param[out]  program_count     The pointer to `uint32_t` to return the number of doublewords
+   *                                programmed in the page since the simulator was configured.
+   * @param[out]  erase_count       The pointer to `uint32_t` to return the number of times that the
+   *                                page was erased.
+   *
+   * @return The #az_result with the result of the operation.
+   *      @retval #AZ_OK                        If the page exists.
+   *      @retval #AZ_ERROR_ITEM_NOT_FOUND      If the region or the page does not exist.
+   */
+  az_result az_ulib_pal_flash_sim_get_page_counters(
+      uint32_t region,
+      uint32_t page,
+      uint32_t* program_count,
+      uint32_t* erase_count);
+
+  /**
+   * @brief   Return the number of pages in a region.
+   *
+   * @param[in]   region            The `uint32_t` with the index of the region.
+   *
+   * @return The `uint32_t` with the number of pages, or `0` if the region does not exist.
+   */
+  uint32_t az_ulib_pal_flash_sim_get_page_count(uint32_t region);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* AZ_ULIB_PAL_FLASH_SIM_H */
@@ -3,10 +3,16 @@
 // See LICENSE file in the project root for full license information.
 
 // This file gets included into az_ulib_port.h as a means of extending the behavior of
-// atomic increment, decrement, and test.
+// atomic operations.
 #ifndef AZ_ULIB_GCC_LINUX_PORT_H
 #define AZ_ULIB_GCC_LINUX_PORT_H
 
+#ifndef __cplusplus
+#include <stdbool.h>
+#else
+#include <cstdbool>
+#endif /* __cplusplus */
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -21,67 +27,167 @@ extern "C"
 #define AZURE_ULIB_C_USE_GNU_C_ATOMIC 1
 #endif
 
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ == 201112)
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ == 201112) && !defined(__cplusplus)
 #define AZURE_ULIB_C_USE_STD_ATOMIC 1
 #undef AZURE_ULIB_C_USE_GNU_C_ATOMIC
 #endif
 
-  /*the following macros increment/decrement a ref count in an atomic way, depending on the
-   * platform*/
-  /*The following mechanisms are considered in this order
-  AZURE_ULIB_C_ATOMIC_DONTCARE does not use atomic operations
-  - will result in ++/-- used for increment/decrement.
-  C11
-  - will result in #include <stdatomic.h>
-  - will use atomic_fetch_add/sub;
-  - about the return value: "Atomically, the value pointed to by object immediately before the
-    effects" gcc
-  - will result in no include (for gcc these are intrinsics build in)
-  - will use __sync_fetch_and_add/sub
-  - about the return value: "... returns the value that had previously been in memory."
-    (https://gcc.gnu.org/onlinedocs/gcc-4.4.3/gcc/Atomic-Builtins.html#Atomic-Builtins)
-  */
+  /*
+   * All ports offer the same atomic operations over a `volatile long` (_W) or a `void* volatile`
+   * (_PTR):
+   *  - LOAD and STORE are sequentially consistent, LOAD_ACQUIRE and STORE_RELEASE only order the
+   *    memory accesses after the load, or before the store.
+   *  - INC and DEC return the new value.
+   *  - FETCH_ADD, FETCH_SUB, FETCH_OR, FETCH_AND and EXCHANGE return the previous value.
+   *  - COMPARE_EXCHANGE stores `desired` only if the value is `*expected`, and returns `true`.
+   *    Otherwise, it copies the value to `*expected` and returns `false`.
+   *  - THREAD_FENCE is a full memory barrier.
+   * The read-modify-write operations are sequentially consistent.
+   */
 
 #if defined(AZURE_ULIB_C_ATOMIC_DONTCARE)
-#define AZ_ULIB_PORT_ATOMIC_INC_W(count) ++(*(count))
-#define AZ_ULIB_PORT_ATOMIC_DEC_W(count) --(*(count))
-  static inline long AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(volatile long* addr, long val)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_W(addr) (*(addr))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr) (*(addr))
+#define AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value) (*(addr) = (value))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value) (*(addr) = (value))
+#define AZ_ULIB_PORT_ATOMIC_INC_W(addr) ++(*(addr))
+#define AZ_ULIB_PORT_ATOMIC_DEC_W(addr) --(*(addr))
+  static inline long AZ_ULIB_PORT_ATOMIC_FETCH_ADD_W(volatile long* addr, long value)
+  {
+    long prev = *addr;
+    *addr = prev + value;
+    return prev;
+  }
+  static inline long AZ_ULIB_PORT_ATOMIC_FETCH_SUB_W(volatile long* addr, long value)
+  {
+    long prev = *addr;
+    *addr = prev - value;
+    return prev;
+  }
+  static inline long AZ_ULIB_PORT_ATOMIC_FETCH_OR_W(volatile long* addr, long value)
+  {
+    long prev = *addr;
+    *addr = prev | value;
+    return prev;
+  }
+  static inline long AZ_ULIB_PORT_ATOMIC_FETCH_AND_W(volatile long* addr, long value)
   {
     long prev = *addr;
-    *addr = val;
+    *addr = prev & value;
     return prev;
   }
-  static inline long AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(volatile void** addr, void* val)
+  static inline long AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(volatile long* addr, long value)
+  {
+    long prev = *addr;
+    *addr = value;
+    return prev;
+  }
+  static inline bool
+  AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(volatile long* addr, long* expected, long desired)
+  {
+    if (*addr != *expected)
+    {
+      *expected = *addr;
+      return false;
+    }
+    *addr = desired;
+    return true;
+  }
+#define AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr) (*(addr))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_PTR(addr) (*(addr))
+#define AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value) (*(addr) = (value))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_PTR(addr, value) (*(addr) = (value))
+  static inline void* AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(void* volatile* addr, void* value)
   {
     void* prev = *addr;
-    *addr = val;
+    *addr = value;
     return prev;
   }
+  static inline bool
+  AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_PTR(void* volatile* addr, void** expected, void* desired)
+  {
+    if (*addr != *expected)
+    {
+      *expected = *addr;
+      return false;
+    }
+    *addr = desired;
+    return true;
+  }
+#define AZ_ULIB_PORT_ATOMIC_THREAD_FENCE()
 
 #elif defined(AZURE_ULIB_C_USE_STD_ATOMIC)
-#ifndef __cplusplus
 #include <stdatomic.h>
-#else
-#include <atomic>
-#endif /* __cplusplus */
-static inline long AZ_ULIB_PORT_ATOMIC_INC_W(volatile long* addr)
-{
-  return (long)atomic_fetch_add((atomic_int)addr, 1) + 1;
-}
-static inline long AZ_ULIB_PORT_ATOMIC_DEC_W(volatile long* addr)
-{
-  return (long)atomic_fetch_sub((atomic_int)addr, 1) - 1;
-}
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(target, value) atomic_exchange((target), (value))
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) atomic_exchange((target), (value))
+  /* The library keeps the atomic variables as `volatile long` and `void* volatile`, which have the
+   * same representation as their atomic types in the supported compilers. */
+#define _AZ_ULIB_PORT_ATOMIC_W(addr) ((volatile _Atomic long*)(addr))
+#define _AZ_ULIB_PORT_ATOMIC_PTR(addr) ((volatile _Atomic(void*)*)(volatile void*)(addr))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_W(addr) atomic_load(_AZ_ULIB_PORT_ATOMIC_W(addr))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr) \
+  atomic_load_explicit(_AZ_ULIB_PORT_ATOMIC_W(addr), memory_order_acquire)
+#define AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value) \
+  atomic_store(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value) \
+  atomic_store_explicit(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value), memory_order_release)
+#define AZ_ULIB_PORT_ATOMIC_INC_W(addr) (atomic_fetch_add(_AZ_ULIB_PORT_ATOMIC_W(addr), 1) + 1)
+#define AZ_ULIB_PORT_ATOMIC_DEC_W(addr) (atomic_fetch_sub(_AZ_ULIB_PORT_ATOMIC_W(addr), 1) - 1)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_ADD_W(addr, value) \
+  atomic_fetch_add(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_SUB_W(addr, value) \
+  atomic_fetch_sub(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_OR_W(addr, value) \
+  atomic_fetch_or(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_AND_W(addr, value) \
+  atomic_fetch_and(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value) \
+  atomic_exchange(_AZ_ULIB_PORT_ATOMIC_W(addr), (long)(value))
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(addr, expected, desired) \
+  atomic_compare_exchange_strong(_AZ_ULIB_PORT_ATOMIC_W(addr), (expected), (long)(desired))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr) atomic_load(_AZ_ULIB_PORT_ATOMIC_PTR(addr))
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_PTR(addr) \
+  atomic_load_explicit(_AZ_ULIB_PORT_ATOMIC_PTR(addr), memory_order_acquire)
+#define AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value) \
+  atomic_store(_AZ_ULIB_PORT_ATOMIC_PTR(addr), (void*)(value))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_PTR(addr, value) \
+  atomic_store_explicit(_AZ_ULIB_PORT_ATOMIC_PTR(addr), (void*)(value), memory_order_release)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(addr, value) \
+  atomic_exchange(_AZ_ULIB_PORT_ATOMIC_PTR(addr), (void*)(value))
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_PTR(addr, expected, desired) \
+  atomic_compare_exchange_strong(_AZ_ULIB_PORT_ATOMIC_PTR(addr), (expected), (void*)(desired))
+#define AZ_ULIB_PORT_ATOMIC_THREAD_FENCE() atomic_thread_fence(memory_order_seq_cst)
 
 #elif defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)
-#define AZ_ULIB_PORT_ATOMIC_INC_W(count) __sync_add_and_fetch((count), 1)
-#define AZ_ULIB_PORT_ATOMIC_DEC_W(count) __sync_sub_and_fetch((count), 1)
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(target, value) \
-  __sync_val_compare_and_swap((target), *(target), (value))
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
-  __sync_val_compare_and_swap((target), *(target), (value))
+  /* The __atomic builtins are generic, so the same macros serve the _W and _PTR variants. */
+#define AZ_ULIB_PORT_ATOMIC_LOAD_W(addr) __atomic_load_n((addr), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr) __atomic_load_n((addr), __ATOMIC_ACQUIRE)
+#define AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value) \
+  __atomic_store_n((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value) \
+  __atomic_store_n((addr), (value), __ATOMIC_RELEASE)
+#define AZ_ULIB_PORT_ATOMIC_INC_W(addr) __atomic_add_fetch((addr), 1, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_DEC_W(addr) __atomic_sub_fetch((addr), 1, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_ADD_W(addr, value) \
+  __atomic_fetch_add((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_SUB_W(addr, value) \
+  __atomic_fetch_sub((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_OR_W(addr, value) \
+  __atomic_fetch_or((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_FETCH_AND_W(addr, value) \
+  __atomic_fetch_and((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value) \
+  __atomic_exchange_n((addr), (value), __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(addr, expected, desired) \
+  __atomic_compare_exchange_n(                                         \
+      (addr), (expected), (desired), false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr) AZ_ULIB_PORT_ATOMIC_LOAD_W(addr)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_PTR(addr) AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr)
+#define AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value) AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_PTR(addr, value) \
+  AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(addr, value) AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_PTR(addr, expected, desired) \
+  AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(addr, expected, desired)
+#define AZ_ULIB_PORT_ATOMIC_THREAD_FENCE() __atomic_thread_fence(__ATOMIC_SEQ_CST)
 
 #endif /*defined(AZURE_ULIB_C_USE_GNU_C_ATOMIC)*/
 
@@ -7,12 +7,57 @@
 
 #include "windows.h"
 
-#define AZ_ULIB_PORT_ATOMIC_INC_W(count) InterlockedIncrement((volatile LONG*)(count))
-#define AZ_ULIB_PORT_ATOMIC_DEC_W(count) InterlockedDecrement((volatile LONG*)(count))
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(target, value) \
-  InterlockedExchange((volatile LONG*)(target), (LONG)(value))
-#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(target, value) \
-  InterlockedExchangePointer((volatile PVOID*)(target), (PVOID)(value))
+/*
+ * The Interlocked functions are full memory barriers, and so are the aligned loads and stores on
+ * x86 and x64 followed by MemoryBarrier(), so all operations are sequentially consistent.
+ *  - INC and DEC return the new value.
+ *  - FETCH_ADD, FETCH_SUB, FETCH_OR, FETCH_AND and EXCHANGE return the previous value.
+ *  - COMPARE_EXCHANGE stores `desired` only if the value is `*expected`, and returns `true`.
+ *    Otherwise, it copies the value to `*expected` and returns `false`.
+ */
+#define AZ_ULIB_PORT_ATOMIC_LOAD_W(addr) InterlockedCompareExchange((volatile LONG*)(addr), 0, 0)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(addr) AZ_ULIB_PORT_ATOMIC_LOAD_W(addr)
+#define AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value) \
+  ((void)InterlockedExchange((volatile LONG*)(addr), (LONG)(value)))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_W(addr, value) AZ_ULIB_PORT_ATOMIC_STORE_W(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_INC_W(addr) InterlockedIncrement((volatile LONG*)(addr))
+#define AZ_ULIB_PORT_ATOMIC_DEC_W(addr) InterlockedDecrement((volatile LONG*)(addr))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_ADD_W(addr, value) \
+  InterlockedExchangeAdd((volatile LONG*)(addr), (LONG)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_SUB_W(addr, value) \
+  InterlockedExchangeAdd((volatile LONG*)(addr), -(LONG)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_OR_W(addr, value) \
+  InterlockedOr((volatile LONG*)(addr), (LONG)(value))
+#define AZ_ULIB_PORT_ATOMIC_FETCH_AND_W(addr, value) \
+  InterlockedAnd((volatile LONG*)(addr), (LONG)(value))
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_W(addr, value) \
+  InterlockedExchange((volatile LONG*)(addr), (LONG)(value))
+static __inline BOOL
+AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(volatile long* addr, long* expected, long desired)
+{
+  LONG prev = InterlockedCompareExchange((volatile LONG*)addr, desired, *expected);
+  BOOL exchanged = (prev == *expected);
+  *expected = prev;
+  return exchanged;
+}
+#define AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr) \
+  InterlockedCompareExchangePointer((volatile PVOID*)(addr), NULL, NULL)
+#define AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_PTR(addr) AZ_ULIB_PORT_ATOMIC_LOAD_PTR(addr)
+#define AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value) \
+  ((void)InterlockedExchangePointer((volatile PVOID*)(addr), (PVOID)(value)))
+#define AZ_ULIB_PORT_ATOMIC_STORE_RELEASE_PTR(addr, value) \
+  AZ_ULIB_PORT_ATOMIC_STORE_PTR(addr, value)
+#define AZ_ULIB_PORT_ATOMIC_EXCHANGE_PTR(addr, value) \
+  InterlockedExchangePointer((volatile PVOID*)(addr), (PVOID)(value))
+static __inline BOOL
+AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_PTR(void* volatile* addr, void** expected, void* desired)
+{
+  PVOID prev = InterlockedCompareExchangePointer((volatile PVOID*)addr, desired, *expected);
+  BOOL exchanged = (prev == *expected);
+  *expected = prev;
+  return exchanged;
+}
+#define AZ_ULIB_PORT_ATOMIC_THREAD_FENCE() MemoryBarrier()
 
 #define AZ_ULIB_PORT_THROW_HARD_FAULT (*(char*)NULL = 0)
 
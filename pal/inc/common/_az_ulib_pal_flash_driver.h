@@ -91,6 +91,30 @@ extern "C"
    */
   az_result _az_ulib_pal_flash_driver_erase(uint64_t* destination_ptr, uint32_t size);
 
+  /**
+   * @brief [**INTERNAL ONLY**]Read data from the flash.
+   *
+   * This is a standalone function to copy bytes from the flash to the RAM. Memory mapped flash can
+   * be read directly, but external flash, like a SPI or QSPI NOR, can only be read by the driver.
+   * In this case, `source_ptr` is the address of the data in the flash device, and shall never be
+   * dereferenced by the caller.
+   *
+   * @param[in]     source_ptr            The pointer to `uint8_t` with the address in the flash to
+   *                                      read.
+   * @param[out]    destination_ptr       The pointer to `uint8_t` with the buffer to copy the data.
+   * @param[in]     size                  The `uint32_t` with the number of bytes to read.
+   *
+   * @return The #az_result with the result of the read from flash.
+   *      @retval #AZ_OK                        If read from flash was successful.
+   *      @retval #AZ_ERROR_ULIB_SYSTEM         If there are generic error from the HAL layer.
+   *      @retval #AZ_ERROR_ULIB_BUSY           If the HAL layer is busy.
+   *      @retval #AZ_ERROR_ULIB_TIMEOUT        If the HAL layer is throw a timeout error.
+   */
+  az_result _az_ulib_pal_flash_driver_read(
+      const uint8_t* source_ptr,
+      uint8_t* destination_ptr,
+      uint32_t size);
+
   /**
    * @brief [**INTERNAL ONLY**]Open flash to write on it.
    *
@@ -152,6 +176,152 @@ extern "C"
       _az_ulib_pal_flash_driver_control_block* flash_cb,
       uint8_t pad);
 
+  /**
+   * @brief [**INTERNAL ONLY**]Signature of the function called when an asynchronous flash
+   * operation completes.
+   *
+   * The driver may call it from its own thread or interrupt context, so it shall be fast and shall
+   * not start a new flash operation synchronously. The operation is out of the driver queue when
+   * the callback runs, so the callback may submit it, or any other operation, asynchronously. If it
+   * submits the same operation, the operation stays pending until the new run completes.
+   *
+   * @param[in]     result                The #az_result with the result of the operation. It is the
+   *                                      same value that the synchronous API would return.
+   * @param[in]     context               The `void*` provided when the operation was submitted.
+   */
+  typedef void (*_az_ulib_pal_flash_driver_callback)(az_result result, void* context);
+
+  /**
+   * @brief [**INTERNAL ONLY**]Type of an asynchronous flash operation.
+   */
+  typedef enum
+  {
+    /** Program a buffer, see _az_ulib_pal_flash_driver_write_async(). */
+    _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_WRITE = 0,
+
+    /** Erase pages, see _az_ulib_pal_flash_driver_erase_async(). */
+    _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_ERASE = 1
+  } _az_ulib_pal_flash_driver_operation_type;
+
+  /**
+   * @brief   [**INTERNAL ONLY**]Asynchronous flash operation.
+   *
+   * The memory for the operation is provided by the caller when it submits the operation, and
+   * shall be kept, together with the source buffer, until the operation completes.
+   *
+   * The driver runs the operations with its synchronous API, which is not thread safe. So, the
+   * synchronous API shall not be called while there are asynchronous operations in progress.
+   */
+  typedef struct _az_ulib_pal_flash_driver_operation_tag
+  {
+    /** Next operation in the driver queue. */
+    struct _az_ulib_pal_flash_driver_operation_tag* next;
+
+    /** Type of the operation. */
+    _az_ulib_pal_flash_driver_operation_type type;
+
+    /** Flash address to write or erase. */
+    uint64_t* destination_ptr;
+
+    /** Data to write, `NULL` for an erase. */
+    uint8_t* source_ptr;
+
+    /** Number of bytes to write or erase. */
+    uint32_t size;
+
+    /** Byte to pad the last doubleword of a write. */
+    uint8_t pad;
+
+    /** Function to call when the operation completes, it can be `NULL`. */
+    _az_ulib_pal_flash_driver_callback callback;
+
+    /** Context for the callback. */
+    void* context;
+
+    /** Result of the operation, #AZ_ULIB_PENDING while it is in progress. */
+    volatile az_result result;
+  } _az_ulib_pal_flash_driver_operation;
+
+  /**
+   * @brief [**INTERNAL ONLY**]Submit a write of data to flash.
+   *
+   * This function queues the write of `size` bytes from `source_ptr` to `destination_ptr`, and
+   * returns without waiting for the flash. It is the same as _az_ulib_pal_flash_driver_open(),
+   * _az_ulib_pal_flash_driver_write() and _az_ulib_pal_flash_driver_close() in sequence. The
+   * operations run in the order that they were submitted. Drivers that cannot program in the
+   * background complete the operation, and call the callback, before returning.
+   *
+   * @param[out]    operation             The pointer to #_az_ulib_pal_flash_driver_operation to
+   *                                      control the operation. It cannot be NULL.
+   * @param[in]     destination_ptr       The pointer to `uint64_t` to write the data.
+   * @param[in]     source_ptr            The pointer to `uint8_t` with the source data to write.
+   * @param[in]     size                  The `uint32_t` with the number of bytes to write.
+   * @param[in]     pad                   The `uint8_t` to pad the end of the memory.
+   * @param[in]     callback              The #_az_ulib_pal_flash_driver_callback to call when the
+   *                                      write completes. It can be NULL.
+   * @param[in]     context               The `void*` to pass to the callback.
+   *
+   * @return The #az_result with the result of the submit.
+   *      @retval #AZ_OK                        If the write was submitted.
+   *      @retval #AZ_ERROR_ULIB_SYSTEM         If the driver cannot run operations.
+   */
+  az_result _az_ulib_pal_flash_driver_write_async(
+      _az_ulib_pal_flash_driver_operation* operation,
+      uint64_t* destination_ptr,
+      uint8_t* source_ptr,
+      uint32_t size,
+      uint8_t pad,
+      _az_ulib_pal_flash_driver_callback callback,
+      void* context);
+
+  /**
+   * @brief [**INTERNAL ONLY**]Submit an erase of the flash.
+   *
+   * This function queues the erase of the pages with `size` bytes starting from
+   * `destination_ptr`, with the same alignment rules of _az_ulib_pal_flash_driver_erase(), and
+   * returns without waiting for the flash.
+   *
+   * @param[out]    operation             The pointer to #_az_ulib_pal_flash_driver_operation to
+   *                                      control the operation. It cannot be NULL.
+   * @param[in]     destination_ptr       The pointer to `uint64_t` to erase.
+   * @param[in]     size                  The `uint32_t` with the number of bytes to erase.
+   * @param[in]     callback              The #_az_ulib_pal_flash_driver_callback to call when the
+   *                                      erase completes. It can be NULL.
+   * @param[in]     context               The `void*` to pass to the callback.
+   *
+   * @return The #az_result with the result of the submit.
+   *      @retval #AZ_OK                        If the erase was submitted.
+   *      @retval #AZ_ERROR_ULIB_SYSTEM         If the driver cannot run operations.
+   */
+  az_result _az_ulib_pal_flash_driver_erase_async(
+      _az_ulib_pal_flash_driver_operation* operation,
+      uint64_t* destination_ptr,
+      uint32_t size,
+      _az_ulib_pal_flash_driver_callback callback,
+      void* context);
+
+  /**
+   * @brief [**INTERNAL ONLY**]Check an asynchronous flash operation.
+   *
+   * @param[in]     operation             The pointer to #_az_ulib_pal_flash_driver_operation with
+   *                                      a submitted operation. It cannot be NULL.
+   *
+   * @return The #az_result with the state of the operation.
+   *      @retval #AZ_ULIB_PENDING              If the operation is still in progress.
+   *      @retval other                         The result of the completed operation.
+   */
+  az_result _az_ulib_pal_flash_driver_poll(const _az_ulib_pal_flash_driver_operation* operation);
+
+  /**
+   * @brief [**INTERNAL ONLY**]Wait for an asynchronous flash operation to complete.
+   *
+   * @param[in]     operation             The pointer to #_az_ulib_pal_flash_driver_operation with
+   *                                      a submitted operation. It cannot be NULL.
+   *
+   * @return The #az_result with the result of the completed operation.
+   */
+  az_result _az_ulib_pal_flash_driver_wait(const _az_ulib_pal_flash_driver_operation* operation);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,8 +13,10 @@
 #include "az_ulib_result.h"
 
 #ifndef __cplusplus
+#include <stdbool.h>
 #include <stdint.h>
 #else
+#include <cstdbool>
 #include <cstdint>
 extern "C"
 {
@@ -38,6 +40,9 @@ void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock);
  * @brief   Acquires a lock on the given lock handle. Uses platform specific mutex primitives in
  *          its implementation.
  *
+ * If the lock is busy, the thread may spin for a short time before it blocks, see
+ * `AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT` in the platform header.
+ *
  * @param[in]       lock    The #az_ulib_pal_os_lock* that points to a valid lock handle.
  */
 void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock);
@@ -50,6 +55,289 @@ void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock);
  */
 void az_pal_os_lock_release(az_ulib_pal_os_lock* lock);
 
+/**
+ * @brief   This API initialize a reader-writer lock.
+ *
+ * A reader-writer lock can be held by many threads in shared mode, or by a single thread in
+ * exclusive mode. Use the shared mode for operations that only read the protected data.
+ *
+ * @param[in,out]   rwlock  The #az_ulib_pal_os_rwlock* that points to the lock handle.
+ */
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   The reader-writer lock instance is destroyed.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ */
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   Acquires the reader-writer lock in shared mode. It waits while any thread holds the
+ *          lock in exclusive mode.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ */
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   Releases the reader-writer lock acquired in shared mode.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ */
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   Acquires the reader-writer lock in exclusive mode. It waits while any thread holds the
+ *          lock, in any mode.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ */
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   Releases the reader-writer lock acquired in exclusive mode.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ */
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock);
+
+/**
+ * @brief   Lock statistics.
+ *
+ * The counters are only updated if the PAL is built with AZ_ULIB_PAL_OS_LOCK_STATISTICS, otherwise
+ * they are all zero.
+ */
+typedef struct
+{
+  /** Number of times that the lock was acquired, in any mode. */
+  uint32_t acquire_count;
+
+  /** Number of acquisitions that found the lock busy. */
+  uint32_t contended_count;
+
+  /** Number of contended acquisitions that blocked the thread after spinning. */
+  uint32_t blocked_count;
+
+  /** Total time in nanoseconds that the threads waited to acquire the lock. */
+  uint64_t wait_time_ns;
+
+  /** Total time in nanoseconds that the lock was held in exclusive mode. */
+  uint64_t hold_time_ns;
+} az_ulib_pal_os_lock_stats;
+
+/**
+ * @brief   Get the statistics of a lock.
+ *
+ * @param[in]       lock    The #az_ulib_pal_os_lock* that points to a valid lock handle.
+ * @param[out]      stats   The #az_ulib_pal_os_lock_stats* to receive the statistics.
+ */
+void az_pal_os_lock_get_stats(const az_ulib_pal_os_lock* lock, az_ulib_pal_os_lock_stats* stats);
+
+/**
+ * @brief   Get the statistics of a reader-writer lock.
+ *
+ * @param[in]       rwlock  The #az_ulib_pal_os_rwlock* that points to a valid lock handle.
+ * @param[out]      stats   The #az_ulib_pal_os_lock_stats* to receive the statistics.
+ */
+void az_pal_os_rwlock_get_stats(
+    const az_ulib_pal_os_rwlock* rwlock,
+    az_ulib_pal_os_lock_stats* stats);
+
+/**
+ * @brief   This API initialize a counting semaphore.
+ *
+ * @param[in,out]   semaphore       The #az_ulib_pal_os_semaphore* that points to the semaphore.
+ * @param[in]       initial_count   The `uint32_t` with the initial count of the semaphore.
+ *
+ * @return The #az_result with the semaphore creation result.
+ *  @retval #AZ_OK                  If the semaphore was created with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM   If the create API in the OS return error.
+ */
+az_result az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count);
+
+/**
+ * @brief   The semaphore instance is destroyed.
+ *
+ * @param[in]       semaphore       The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ */
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore);
+
+/**
+ * @brief   Take one count from the semaphore, waiting for it if the count is zero.
+ *
+ * @param[in]       semaphore       The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ * @param[in]       wait_option_ms  The `uint32_t` with the maximum number of milliseconds to wait.
+ *                                  It can be #AZ_ULIB_NO_WAIT or #AZ_ULIB_WAIT_FOREVER.
+ *
+ * @return The #az_result with the result of the take.
+ *  @retval #AZ_OK                  If the semaphore was taken.
+ *  @retval #AZ_ERROR_ULIB_TIMEOUT  If the count was still zero when the wait time was over.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM   If the wait API in the OS return error.
+ */
+az_result az_pal_os_semaphore_take(az_ulib_pal_os_semaphore* semaphore, uint32_t wait_option_ms);
+
+/**
+ * @brief   Give one count to the semaphore, waking up one thread waiting for it.
+ *
+ * @param[in]       semaphore       The #az_ulib_pal_os_semaphore* that points to a valid semaphore.
+ */
+void az_pal_os_semaphore_give(az_ulib_pal_os_semaphore* semaphore);
+
+/**
+ * @brief   This API initialize an event.
+ *
+ * A set event wakes up the threads waiting for it. An auto-reset event wakes up a single thread
+ * and goes back to reset. A manual-reset event wakes up all threads, and stays set up to
+ * az_pal_os_event_reset().
+ *
+ * @param[in,out]   event           The #az_ulib_pal_os_event* that points to the event.
+ * @param[in]       manual_reset    The `bool` that selects a manual-reset event, if `true`, or an
+ *                                  auto-reset event, if `false`.
+ * @param[in]       initial_state   The `bool` with the initial state, `true` for set.
+ *
+ * @return The #az_result with the event creation result.
+ *  @retval #AZ_OK                  If the event was created with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM   If the create API in the OS return error.
+ */
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state);
+
+/**
+ * @brief   The event instance is destroyed.
+ *
+ * @param[in]       event           The #az_ulib_pal_os_event* that points to a valid event.
+ */
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   Set the event.
+ *
+ * @param[in]       event           The #az_ulib_pal_os_event* that points to a valid event.
+ */
+void az_pal_os_event_set(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   Reset the event.
+ *
+ * @param[in]       event           The #az_ulib_pal_os_event* that points to a valid event.
+ */
+void az_pal_os_event_reset(az_ulib_pal_os_event* event);
+
+/**
+ * @brief   Wait for the event to be set.
+ *
+ * @param[in]       event           The #az_ulib_pal_os_event* that points to a valid event.
+ * @param[in]       wait_option_ms  The `uint32_t` with the maximum number of milliseconds to wait.
+ *                                  It can be #AZ_ULIB_NO_WAIT or #AZ_ULIB_WAIT_FOREVER.
+ *
+ * @return The #az_result with the result of the wait.
+ *  @retval #AZ_OK                  If the event was set.
+ *  @retval #AZ_ERROR_ULIB_TIMEOUT  If the event was not set when the wait time was over.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM   If the wait API in the OS return error.
+ */
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms);
+
+/**
+ * @brief   Start the work queue.
+ *
+ * The work queue runs work items in a fixed pool of worker threads, so packages can run deferred
+ * and periodic work without owning a thread. It shall be started before any work is scheduled.
+ *
+ * @return The #az_result with the result of the start.
+ *  @retval #AZ_OK                      If the work queue started with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM       If the OS failed to create the worker threads.
+ *  @retval #AZ_ERROR_NOT_IMPLEMENTED   If the platform does not support the work queue.
+ */
+az_result az_pal_os_work_queue_init(void);
+
+/**
+ * @brief   Stop the work queue.
+ *
+ * Work that is running finishes before this function returns, and scheduled work is dropped.
+ */
+void az_pal_os_work_queue_deinit(void);
+
+/**
+ * @brief   Initialize a work item.
+ *
+ * @param[in,out]   work            The #az_ulib_pal_os_work* that points to the work item. It shall
+ *                                  stay valid up to az_pal_os_work_deinit().
+ * @param[in]       function        The #az_ulib_pal_os_work_function to call when the work runs.
+ * @param[in]       context         The `void*` to pass to the \p function.
+ *
+ * @return The #az_result with the result of the initialization.
+ *  @retval #AZ_OK                  If the work item was initialized with success.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM   If the OS failed to create the work item.
+ */
+az_result az_pal_os_work_init(
+    az_ulib_pal_os_work* work,
+    az_ulib_pal_os_work_function function,
+    void* context);
+
+/**
+ * @brief   Cancel and release a work item.
+ *
+ * @param[in]       work            The #az_ulib_pal_os_work* that points to a valid work item.
+ */
+void az_pal_os_work_deinit(az_ulib_pal_os_work* work);
+
+/**
+ * @brief   Schedule a work item.
+ *
+ * If the work is already scheduled, the new delay and period replace the old ones.
+ *
+ * @param[in]       work            The #az_ulib_pal_os_work* that points to a valid work item.
+ * @param[in]       delay_ms        The `uint32_t` with the number of milliseconds to wait before
+ *                                  the first run. It can be `0` to run as soon as possible.
+ * @param[in]       period_ms       The `uint32_t` with the number of milliseconds between runs of a
+ *                                  periodic work. It shall be `0` for a work that runs once.
+ *
+ * @return The #az_result with the result of the schedule.
+ *  @retval #AZ_OK                      If the work was scheduled.
+ *  @retval #AZ_ERROR_ULIB_SYSTEM       If the work queue is not running.
+ *  @retval #AZ_ERROR_NOT_IMPLEMENTED   If the platform does not support the work queue.
+ */
+az_result az_pal_os_work_schedule(az_ulib_pal_os_work* work, uint32_t delay_ms, uint32_t period_ms);
+
+/**
+ * @brief   Cancel a work item.
+ *
+ * The work will not run again, up to the next az_pal_os_work_schedule(). If the work is running in
+ * another thread, this function waits for it to return. A work may cancel itself.
+ *
+ * @param[in]       work            The #az_ulib_pal_os_work* that points to a valid work item.
+ */
+void az_pal_os_work_cancel(az_ulib_pal_os_work* work);
+
+/**
+ * @brief   Get the time of the monotonic clock.
+ *
+ * The monotonic clock starts at an arbitrary point and never goes back, so the difference between
+ * two calls is the elapsed time. The resolution depends on the platform.
+ *
+ * @return The `uint64_t` with the time in nanoseconds.
+ */
+uint64_t az_pal_os_get_time_ns(void);
+
+/**
+ * @brief   Get the tick counter.
+ *
+ * The tick counter is cheaper than az_pal_os_get_time_ns(), and wraps around at 32 bits, so the
+ * elapsed ticks shall be computed with an unsigned subtraction. Its resolution can be coarser than
+ * one tick, for example, Linux reads it from the coarse monotonic clock, that only advances with
+ * the kernel timer interrupt.
+ *
+ * @return The `uint32_t` with the number of ticks since an arbitrary point.
+ */
+uint32_t az_pal_os_get_ticks(void);
+
+/**
+ * @brief   Get the rate of the tick counter.
+ *
+ * @return The `uint32_t` with the number of ticks in one second.
+ */
+uint32_t az_pal_os_get_ticks_per_second(void);
+
 /**
  * @brief   Sleep for some milliseconds.
  *
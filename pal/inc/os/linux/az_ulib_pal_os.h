@@ -6,6 +6,8 @@
 #define AZ_ULIB_PAL_OS_LINUX_H
 
 #include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -13,9 +15,103 @@ extern "C"
 #endif
 
   /*
-   *  @brief  Pointer to a platform specific lock handle.
+   *  @brief  Number of times that a busy lock is tried again before it blocks the thread.
+   *
+   * Short critical sections are usually released while the thread spins, which saves the system
+   * calls of a blocking wait. Define it as `0` to block at once.
+   */
+#ifndef AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT
+#define AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT 100
+#endif
+
+  /*
+   *  @brief  Platform specific lock counters. The locks only have them if the PAL is built with
+   *          AZ_ULIB_PAL_OS_LOCK_STATISTICS, read them with az_pal_os_lock_get_stats().
+   *
+   * The definition changes the size of the locks, so the PAL and its users shall agree on it.
+   */
+  typedef struct
+  {
+    uint32_t acquire_count;
+    uint32_t contended_count;
+    uint32_t blocked_count;
+    uint64_t wait_time_ns;
+    uint64_t hold_time_ns;
+    uint64_t hold_start_ns;
+  } az_ulib_pal_os_lock_counters;
+
+  /*
+   *  @brief  Platform specific lock handle.
    */
-  typedef pthread_mutex_t az_ulib_pal_os_lock;
+  typedef struct
+  {
+    pthread_mutex_t mutex;
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+    az_ulib_pal_os_lock_counters counters;
+#endif
+  } az_ulib_pal_os_lock;
+
+  /*
+   *  @brief  Platform specific reader-writer lock handle.
+   */
+  typedef struct
+  {
+    pthread_rwlock_t rwlock;
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+    az_ulib_pal_os_lock_counters counters;
+#endif
+  } az_ulib_pal_os_rwlock;
+
+  /*
+   *  @brief  Platform specific counting semaphore.
+   */
+  typedef struct
+  {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    uint32_t count;
+  } az_ulib_pal_os_semaphore;
+
+  /*
+   *  @brief  Platform specific event.
+   */
+  typedef struct
+  {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    bool signaled;
+    bool manual_reset;
+  } az_ulib_pal_os_event;
+
+  /*
+   *  @brief  Function that runs a work item in the work queue.
+   *
+   * @param[in]     context     The `void*` with the context given to az_pal_os_work_init().
+   */
+  typedef void (*az_ulib_pal_os_work_function)(void* context);
+
+  /*
+   *  @brief  Number of worker threads in the work queue.
+   */
+#ifndef AZ_ULIB_PAL_OS_WORK_QUEUE_THREADS
+#define AZ_ULIB_PAL_OS_WORK_QUEUE_THREADS 2
+#endif
+
+  /*
+   *  @brief  Platform specific work item, in a list of items sorted by deadline.
+   */
+  typedef struct az_ulib_pal_os_work_tag
+  {
+    struct az_ulib_pal_os_work_tag* next;
+    az_ulib_pal_os_work_function function;
+    void* context;
+    uint64_t deadline_ns;
+    uint32_t period_ms;
+    bool queued;
+    bool running;
+    bool canceled;
+    pthread_t runner;
+  } az_ulib_pal_os_work;
 
   /*
    *  @brief  Pointer to a platform specific thread handle.
@@ -41,6 +137,14 @@ extern "C"
    */
   typedef az_ulib_pal_thread_ret (*az_ulib_pal_start_function_ptr)(az_ulib_pal_thread_args args);
 
+  /*
+   *  @brief  Return from a platform specific thread function.
+   *
+   * @param[in]     result      The `int` with the result of the thread, returned by
+   *                            az_pal_os_thread_join().
+   */
+#define AZ_ULIB_PAL_THREAD_RETURN(result) return (az_ulib_pal_thread_ret)(intptr_t)(result)
+
 #ifdef __cplusplus
 }
 #endif
@@ -17,6 +17,50 @@ extern "C"
    */
   typedef TX_MUTEX az_ulib_pal_os_lock;
 
+  /*
+   *  @brief  Platform specific reader-writer lock handle.
+   *
+   *  ThreadX has no reader-writer lock, so the first reader takes the `exclusive` semaphore for
+   *  all readers, and the last reader gives it back.
+   */
+  typedef struct
+  {
+    TX_MUTEX readers_lock;
+    TX_SEMAPHORE exclusive;
+    ULONG readers;
+  } az_ulib_pal_os_rwlock;
+
+  /*
+   *  @brief  Platform specific counting semaphore.
+   */
+  typedef TX_SEMAPHORE az_ulib_pal_os_semaphore;
+
+  /*
+   *  @brief  Platform specific event, a single flag in an event flags group.
+   */
+  typedef struct
+  {
+    TX_EVENT_FLAGS_GROUP group;
+    UINT manual_reset;
+  } az_ulib_pal_os_event;
+
+  /*
+   *  @brief  Function that runs a work item in the work queue.
+   *
+   * @param[in]     context     The `void*` with the context given to az_pal_os_work_init().
+   */
+  typedef void (*az_ulib_pal_os_work_function)(void* context);
+
+  /*
+   *  @brief  Platform specific work item. The work queue needs worker threads, which are not
+   *          implemented for ThreadX yet.
+   */
+  typedef struct
+  {
+    az_ulib_pal_os_work_function function;
+    void* context;
+  } az_ulib_pal_os_work;
+
   /*
    *  @brief  Pointer to a platform specific thread handle.
    */
@@ -41,6 +85,19 @@ extern "C"
    */
   typedef az_ulib_pal_thread_ret (*az_ulib_pal_start_function_ptr)(az_ulib_pal_thread_args args);
 
+  /*
+   *  @brief  Return from a platform specific thread function.
+   *
+   * @param[in]     result      The `int` with the result of the thread, returned by
+   *                            az_pal_os_thread_join().
+   */
+#define AZ_ULIB_PAL_THREAD_RETURN(result) \
+  do                                      \
+  {                                       \
+    (void)(result);                       \
+    return;                               \
+  } while (0)
+
 #ifdef __cplusplus
 }
 #endif
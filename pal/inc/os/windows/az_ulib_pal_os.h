@@ -13,9 +13,80 @@ extern "C"
 #endif
 
   /*
-   *  @brief  Pointer to a platform specific lock handle.
+   *  @brief  Number of times that a busy lock is tried again before it blocks the thread.
+   *
+   * Short critical sections are usually released while the thread spins, which saves the system
+   * calls of a blocking wait. Define it as `0` to block at once.
+   */
+#ifndef AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT
+#define AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT 100
+#endif
+
+  /*
+   *  @brief  Platform specific lock counters. The locks only have them if the PAL is built with
+   *          AZ_ULIB_PAL_OS_LOCK_STATISTICS, read them with az_pal_os_lock_get_stats().
+   *
+   * The definition changes the size of the locks, so the PAL and its users shall agree on it.
+   */
+  typedef struct
+  {
+    LONG acquire_count;
+    LONG contended_count;
+    LONG blocked_count;
+    LONG64 wait_time_ns;
+    LONG64 hold_time_ns;
+    LONG64 hold_start_ns;
+  } az_ulib_pal_os_lock_counters;
+
+  /*
+   *  @brief  Platform specific lock handle.
+   */
+  typedef struct
+  {
+    SRWLOCK srwlock;
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+    az_ulib_pal_os_lock_counters counters;
+#endif
+  } az_ulib_pal_os_lock;
+
+  /*
+   *  @brief  Platform specific reader-writer lock handle.
    */
-  typedef SRWLOCK az_ulib_pal_os_lock;
+  typedef struct
+  {
+    SRWLOCK srwlock;
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+    az_ulib_pal_os_lock_counters counters;
+#endif
+  } az_ulib_pal_os_rwlock;
+
+  /*
+   *  @brief  Platform specific counting semaphore.
+   */
+  typedef HANDLE az_ulib_pal_os_semaphore;
+
+  /*
+   *  @brief  Platform specific event.
+   */
+  typedef HANDLE az_ulib_pal_os_event;
+
+  /*
+   *  @brief  Function that runs a work item in the work queue.
+   *
+   * @param[in]     context     The `void*` with the context given to az_pal_os_work_init().
+   */
+  typedef void (*az_ulib_pal_os_work_function)(void* context);
+
+  /*
+   *  @brief  Platform specific work item, a timer in the system thread pool.
+   */
+  typedef struct
+  {
+    PTP_TIMER timer;
+    az_ulib_pal_os_work_function function;
+    void* context;
+    volatile DWORD runner;
+  } az_ulib_pal_os_work;
 
   /*
    *  @brief  Pointer to a platform specific thread handle.
@@ -41,6 +112,14 @@ extern "C"
    */
 #define az_ulib_pal_start_function_ptr LPTHREAD_START_ROUTINE
 
+  /*
+   *  @brief  Return from a platform specific thread function.
+   *
+   * @param[in]     result      The `int` with the result of the thread, returned by
+   *                            az_pal_os_thread_join().
+   */
+#define AZ_ULIB_PAL_THREAD_RETURN(result) return (DWORD)(result)
+
 #ifdef __cplusplus
 }
 #endif
@@ -5,6 +5,7 @@
 #include "az_ulib_result.h"
 
 #include <stdint.h>
+#include <string.h>
 
 az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t source)
 {
@@ -14,11 +15,16 @@ az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t
 
 az_result _az_ulib_pal_flash_driver_erase(uint64_t* destination_ptr, uint32_t size)
 {
-  for (uint8_t* runner = (uint8_t*)destination_ptr; runner < ((uint8_t*)destination_ptr + size);
-       runner++)
-  {
-    *runner = 0xFF;
-  }
+  (void)memset(destination_ptr, 0xFF, size);
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_read(
+    const uint8_t* source_ptr,
+    uint8_t* destination_ptr,
+    uint32_t size)
+{
+  (void)memcpy(destination_ptr, source_ptr, size);
   return AZ_OK;
 }
 
@@ -36,15 +42,34 @@ az_result _az_ulib_pal_flash_driver_write(
     uint8_t* source_ptr,
     uint32_t size)
 {
-  for (uint32_t i = 0; i < size; i++)
+  /* Complete the double-word left open by the previous write. */
+  while ((size > 0) && (flash_cb->remainder_count != 0))
   {
     flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
     if (flash_cb->remainder_count == 8)
     {
       *flash_cb->destination_ptr++ = flash_cb->write_buffer.uint64;
       flash_cb->remainder_count = 0;
     }
   }
+
+  /* Program full double-words straight from the source. */
+  for (; size >= sizeof(uint64_t); size -= (uint32_t)sizeof(uint64_t))
+  {
+    uint64_t word;
+    (void)memcpy(&word, source_ptr, sizeof(uint64_t));
+    *flash_cb->destination_ptr++ = word;
+    source_ptr += sizeof(uint64_t);
+  }
+
+  /* Keep the tail for the next write or the close. */
+  while (size > 0)
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+  }
+
   return AZ_OK;
 }
 
@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "_az_ulib_pal_flash_driver.h"
+#include "az_ulib_result.h"
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * All flash drivers on Linux share this queue. A single worker thread runs the operations with the
+ * synchronous driver API, in the order that they were submitted, so the caller can overlap the
+ * flash latency with its own work. The synchronous API is not thread safe, so callers shall not use
+ * it while they have operations in the queue.
+ */
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t queue_changed = PTHREAD_COND_INITIALIZER;
+static pthread_once_t worker_once = PTHREAD_ONCE_INIT;
+static bool worker_started = false;
+static _az_ulib_pal_flash_driver_operation* queue_head = NULL;
+static _az_ulib_pal_flash_driver_operation* queue_tail = NULL;
+static _az_ulib_pal_flash_driver_operation* running = NULL;
+static bool running_resubmitted = false;
+
+static az_result run_operation(_az_ulib_pal_flash_driver_operation* operation)
+{
+  az_result result;
+
+  if (operation->type == _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_ERASE)
+  {
+    result = _az_ulib_pal_flash_driver_erase(operation->destination_ptr, operation->size);
+  }
+  else
+  {
+    _az_ulib_pal_flash_driver_control_block flash_cb;
+    result = _az_ulib_pal_flash_driver_open(&flash_cb, operation->destination_ptr);
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_pal_flash_driver_write(&flash_cb, operation->source_ptr, operation->size);
+    }
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_pal_flash_driver_close(&flash_cb, operation->pad);
+    }
+  }
+
+  return result;
+}
+
+static void* flash_worker(void* args)
+{
+  (void)args;
+
+  (void)pthread_mutex_lock(&queue_lock);
+  while (true)
+  {
+    while (queue_head == NULL)
+    {
+      (void)pthread_cond_wait(&queue_changed, &queue_lock);
+    }
+
+    /* The operation leaves the queue before it runs, so the callback may submit it again. There is
+     * a single worker, so the new operations still wait for it. */
+    _az_ulib_pal_flash_driver_operation* operation = queue_head;
+    queue_head = operation->next;
+    if (queue_head == NULL)
+    {
+      queue_tail = NULL;
+    }
+    running = operation;
+    running_resubmitted = false;
+    (void)pthread_mutex_unlock(&queue_lock);
+
+    az_result result = run_operation(operation);
+
+    /* The callback runs before the result is published, because the caller may release the
+     * operation as soon as it sees the result. */
+    if (operation->callback != NULL)
+    {
+      operation->callback(result, operation->context);
+    }
+
+    /* If the callback submitted the operation again, it stays pending for the new run. */
+    (void)pthread_mutex_lock(&queue_lock);
+    if (!running_resubmitted)
+    {
+      operation->result = result;
+    }
+    running = NULL;
+    (void)pthread_cond_broadcast(&queue_changed);
+  }
+
+  return NULL;
+}
+
+static void start_worker(void)
+{
+  pthread_attr_t attr;
+  pthread_t worker;
+
+  if (pthread_attr_init(&attr) == 0)
+  {
+    worker_started = (pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED) == 0)
+        && (pthread_create(&worker, &attr, flash_worker, NULL) == 0);
+    (void)pthread_attr_destroy(&attr);
+  }
+}
+
+static az_result submit_operation(_az_ulib_pal_flash_driver_operation* operation)
+{
+  (void)pthread_once(&worker_once, start_worker);
+  if (!worker_started)
+  {
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  /* The result changes under the lock, so a poll or a wait never sees it half updated. */
+  (void)pthread_mutex_lock(&queue_lock);
+  operation->next = NULL;
+  operation->result = AZ_ULIB_PENDING;
+  if (operation == running)
+  {
+    running_resubmitted = true;
+  }
+  if (queue_tail == NULL)
+  {
+    queue_head = operation;
+  }
+  else
+  {
+    queue_tail->next = operation;
+  }
+  queue_tail = operation;
+  (void)pthread_cond_broadcast(&queue_changed);
+  (void)pthread_mutex_unlock(&queue_lock);
+
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_write_async(
+    _az_ulib_pal_flash_driver_operation* operation,
+    uint64_t* destination_ptr,
+    uint8_t* source_ptr,
+    uint32_t size,
+    uint8_t pad,
+    _az_ulib_pal_flash_driver_callback callback,
+    void* context)
+{
+  operation->type = _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_WRITE;
+  operation->destination_ptr = destination_ptr;
+  operation->source_ptr = source_ptr;
+  operation->size = size;
+  operation->pad = pad;
+  operation->callback = callback;
+  operation->context = context;
+
+  return submit_operation(operation);
+}
+
+az_result _az_ulib_pal_flash_driver_erase_async(
+    _az_ulib_pal_flash_driver_operation* operation,
+    uint64_t* destination_ptr,
+    uint32_t size,
+    _az_ulib_pal_flash_driver_callback callback,
+    void* context)
+{
+  operation->type = _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_ERASE;
+  operation->destination_ptr = destination_ptr;
+  operation->source_ptr = NULL;
+  operation->size = size;
+  operation->pad = 0;
+  operation->callback = callback;
+  operation->context = context;
+
+  return submit_operation(operation);
+}
+
+az_result _az_ulib_pal_flash_driver_poll(const _az_ulib_pal_flash_driver_operation* operation)
+{
+  (void)pthread_mutex_lock(&queue_lock);
+  az_result result = operation->result;
+  (void)pthread_mutex_unlock(&queue_lock);
+
+  return result;
+}
+
+az_result _az_ulib_pal_flash_driver_wait(const _az_ulib_pal_flash_driver_operation* operation)
+{
+  (void)pthread_mutex_lock(&queue_lock);
+  while (operation->result == AZ_ULIB_PENDING)
+  {
+    (void)pthread_cond_wait(&queue_changed, &queue_lock);
+  }
+  az_result result = operation->result;
+  (void)pthread_mutex_unlock(&queue_lock);
+
+  return result;
+}
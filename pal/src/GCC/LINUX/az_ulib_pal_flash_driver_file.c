@@ -0,0 +1,233 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "_az_ulib_pal_flash_driver.h"
+#include "az_ulib_pal_flash_file.h"
+#include "az_ulib_result.h"
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define ERASED_BYTE 0xFF
+
+/*
+ * Single file mapped as flash, and the range of bytes changed since the last msync.
+ */
+static int flash_file = -1;
+static uint8_t* flash_start = NULL;
+static size_t flash_size = 0;
+static uint8_t* dirty_start = NULL;
+static uint8_t* dirty_end = NULL;
+
+static void mark_dirty(void* ptr, size_t size)
+{
+  uint8_t* start = (uint8_t*)ptr;
+  uint8_t* end = start + size;
+
+  if ((flash_start == NULL) || (start < flash_start) || (end > (flash_start + flash_size)))
+  {
+    /* Out of the file, there is nothing to flush. */
+    return;
+  }
+
+  if ((dirty_start == NULL) || (start < dirty_start))
+  {
+    dirty_start = start;
+  }
+  if ((dirty_end == NULL) || (end > dirty_end))
+  {
+    dirty_end = end;
+  }
+}
+
+static az_result flush_dirty(void)
+{
+  az_result result = AZ_OK;
+
+  if (dirty_start != NULL)
+  {
+    /* msync requires the address to be aligned to the system page. */
+    uintptr_t page_mask = (uintptr_t)sysconf(_SC_PAGESIZE) - 1;
+    uint8_t* start = (uint8_t*)((uintptr_t)dirty_start & ~page_mask);
+    if (msync(start, (size_t)(dirty_end - start), MS_SYNC) != 0)
+    {
+      result = AZ_ERROR_ULIB_SYSTEM;
+    }
+    dirty_start = NULL;
+    dirty_end = NULL;
+  }
+
+  return result;
+}
+
+/* NOR flash can only clear bits, programming a 1 over a 0 keeps the 0. */
+static inline void program_64(uint64_t* destination_ptr, uint64_t value)
+{
+  *destination_ptr &= value;
+}
+
+az_result az_ulib_pal_flash_file_open(
+    const char* path,
+    void* base_address,
+    size_t size,
+    void** flash_start_ptr)
+{
+  if (flash_start != NULL)
+  {
+    return AZ_ERROR_ULIB_ALREADY_INITIALIZED;
+  }
+
+  int file = open(path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  if (file < 0)
+  {
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  struct stat file_stat;
+  if ((fstat(file, &file_stat) != 0)
+      || (((size_t)file_stat.st_size < size) && (ftruncate(file, (off_t)size) != 0)))
+  {
+    (void)close(file);
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  void* map = mmap(base_address, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+  if (map == MAP_FAILED)
+  {
+    (void)close(file);
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+  if ((base_address != NULL) && (map != base_address))
+  {
+    /* The address is only a hint, and the pointers stored in the flash require this exact
+     * address. */
+    (void)munmap(map, size);
+    (void)close(file);
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  flash_file = file;
+  flash_start = (uint8_t*)map;
+  flash_size = size;
+
+  /* ftruncate fills the new bytes with 0x00, so erase them. */
+  if ((size_t)file_stat.st_size < size)
+  {
+    (void)memset(
+        flash_start + file_stat.st_size, ERASED_BYTE, size - (size_t)file_stat.st_size);
+    mark_dirty(flash_start + file_stat.st_size, size - (size_t)file_stat.st_size);
+    (void)flush_dirty();
+  }
+
+  *flash_start_ptr = map;
+  return AZ_OK;
+}
+
+void az_ulib_pal_flash_file_close(void)
+{
+  if (flash_start != NULL)
+  {
+    (void)flush_dirty();
+    (void)munmap(flash_start, flash_size);
+    (void)close(flash_file);
+    flash_file = -1;
+    flash_start = NULL;
+    flash_size = 0;
+  }
+}
+
+az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t source)
+{
+  program_64(destination_ptr, source);
+  mark_dirty(destination_ptr, sizeof(uint64_t));
+  return flush_dirty();
+}
+
+az_result _az_ulib_pal_flash_driver_erase(uint64_t* destination_ptr, uint32_t size)
+{
+  (void)memset(destination_ptr, ERASED_BYTE, size);
+  mark_dirty(destination_ptr, size);
+  return flush_dirty();
+}
+
+az_result _az_ulib_pal_flash_driver_read(
+    const uint8_t* source_ptr,
+    uint8_t* destination_ptr,
+    uint32_t size)
+{
+  (void)memcpy(destination_ptr, source_ptr, size);
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_open(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint64_t* destination_ptr)
+{
+  flash_cb->destination_ptr = destination_ptr;
+  flash_cb->remainder_count = 0;
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_write(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint8_t* source_ptr,
+    uint32_t size)
+{
+  uint64_t* words_start;
+
+  /* Complete the double-word left open by the previous write. */
+  while ((size > 0) && (flash_cb->remainder_count != 0))
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+    if (flash_cb->remainder_count == 8)
+    {
+      program_64(flash_cb->destination_ptr, flash_cb->write_buffer.uint64);
+      mark_dirty(flash_cb->destination_ptr++, sizeof(uint64_t));
+      flash_cb->remainder_count = 0;
+    }
+  }
+
+  /* Program full double-words straight from the source, and mark them dirty at once. */
+  words_start = flash_cb->destination_ptr;
+  for (; size >= sizeof(uint64_t); size -= (uint32_t)sizeof(uint64_t))
+  {
+    uint64_t word;
+    (void)memcpy(&word, source_ptr, sizeof(uint64_t));
+    program_64(flash_cb->destination_ptr++, word);
+    source_ptr += sizeof(uint64_t);
+  }
+  if (flash_cb->destination_ptr != words_start)
+  {
+    mark_dirty(words_start, (size_t)(flash_cb->destination_ptr - words_start) * sizeof(uint64_t));
+  }
+
+  /* Keep the tail for the next write or the close. */
+  while (size > 0)
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+  }
+
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_close(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint8_t pad)
+{
+  if (flash_cb->remainder_count != 0)
+  {
+    for (uint32_t i = flash_cb->remainder_count; i < 8; i++)
+    {
+      flash_cb->write_buffer.uint8[i] = pad;
+    }
+    program_64(flash_cb->destination_ptr, flash_cb->write_buffer.uint64);
+    mark_dirty(flash_cb->destination_ptr, sizeof(uint64_t));
+  }
+  return flush_dirty();
+}
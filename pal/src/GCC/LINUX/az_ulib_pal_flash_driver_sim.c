@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "_az_ulib_pal_flash_driver.h"
+#include "az_ulib_pal_flash_sim.h"
+#include "az_ulib_result.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define ERASED_BYTE 0xFF
+#define DEFAULT_PAGE_SIZE 0x800
+
+typedef struct
+{
+  uint8_t* start;
+  uint8_t* end;
+  uint32_t* program_count;
+  uint32_t* erase_count;
+} flash_region;
+
+static az_ulib_pal_flash_sim_config sim_config
+    = { .page_size = DEFAULT_PAGE_SIZE,
+        .program_latency_ns = 0,
+        .erase_latency_ns = 0,
+        .read_latency_ns = 0,
+        .block_on_latency = false,
+        .fail_on_illegal_program = false };
+static az_ulib_pal_flash_sim_stats sim_stats;
+static flash_region sim_regions[AZ_ULIB_PAL_FLASH_SIM_MAX_REGIONS];
+static uint32_t sim_region_count = 0;
+
+static void spend(uint64_t latency_ns)
+{
+  sim_stats.busy_time_ns += latency_ns;
+
+  if (sim_config.block_on_latency && (latency_ns != 0))
+  {
+    struct timespec delay = { .tv_sec = (time_t)(latency_ns / 1000000000),
+                              .tv_nsec = (long)(latency_ns % 1000000000) };
+    (void)nanosleep(&delay, NULL);
+  }
+}
+
+static flash_region* find_region(const uint8_t* ptr)
+{
+  for (uint32_t i = 0; i < sim_region_count; i++)
+  {
+    if ((ptr >= sim_regions[i].start) && (ptr < sim_regions[i].end))
+    {
+      return &sim_regions[i];
+    }
+  }
+  return NULL;
+}
+
+static inline uint32_t get_page(const flash_region* region, const uint8_t* ptr)
+{
+  return (uint32_t)((size_t)(ptr - region->start) / sim_config.page_size);
+}
+
+/* NOR flash can only clear bits, programming a 1 over a 0 keeps the 0. */
+static az_result program_64(uint64_t* destination_ptr, uint64_t value)
+{
+  az_result result = AZ_OK;
+  flash_region* region = find_region((uint8_t*)destination_ptr);
+
+  sim_stats.program_count++;
+  if (region != NULL)
+  {
+    region->program_count[get_page(region, (uint8_t*)destination_ptr)]++;
+  }
+
+  if ((~(*destination_ptr) & value) != 0)
+  {
+    sim_stats.illegal_program_count++;
+    if (sim_config.fail_on_illegal_program)
+    {
+      result = AZ_ERROR_ULIB_SYSTEM;
+    }
+  }
+
+  *destination_ptr &= value;
+  spend(sim_config.program_latency_ns);
+
+  return result;
+}
+
+void az_ulib_pal_flash_sim_configure(const az_ulib_pal_flash_sim_config* config)
+{
+  az_ulib_pal_flash_sim_remove_all_regions();
+
+  if (config == NULL)
+  {
+    sim_config = (az_ulib_pal_flash_sim_config){ .page_size = DEFAULT_PAGE_SIZE,
+                                                 .program_latency_ns = 0,
+                                                 .erase_latency_ns = 0,
+                                                 .read_latency_ns = 0,
+                                                 .block_on_latency = false,
+                                                 .fail_on_illegal_program = false };
+  }
+  else
+  {
+    sim_config = *config;
+    if (sim_config.page_size == 0)
+    {
+      sim_config.page_size = DEFAULT_PAGE_SIZE;
+    }
+  }
+
+  (void)memset(&sim_stats, 0, sizeof(sim_stats));
+}
+
+az_result az_ulib_pal_flash_sim_add_region(void* start, size_t size)
+{
+  if ((((uintptr_t)start % sim_config.page_size) != 0) || ((size % sim_config.page_size) != 0)
+      || (size == 0))
+  {
+    return AZ_ERROR_ARG;
+  }
+  if (sim_region_count == AZ_ULIB_PAL_FLASH_SIM_MAX_REGIONS)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  size_t pages = size / sim_config.page_size;
+  uint32_t* program_count = (uint32_t*)calloc(pages, sizeof(uint32_t));
+  uint32_t* erase_count = (uint32_t*)calloc(pages, sizeof(uint32_t));
+  if ((program_count == NULL) || (erase_count == NULL))
+  {
+    free(program_count);
+    free(erase_count);
+    return AZ_ERROR_OUT_OF_MEMORY;
+  }
+
+  sim_regions[sim_region_count++] = (flash_region){ .start = (uint8_t*)start,
+                                                    .end = (uint8_t*)start + size,
+                                                    .program_count = program_count,
+                                                    .erase_count = erase_count };
+  return AZ_OK;
+}
+
+void az_ulib_pal_flash_sim_remove_all_regions(void)
+{
+  for (uint32_t i = 0; i < sim_region_count; i++)
+  {
+    free(sim_regions[i].program_count);
+    free(sim_regions[i].erase_count);
+  }
+  sim_region_count = 0;
+}
+
+void az_ulib_pal_flash_sim_get_stats(az_ulib_pal_flash_sim_stats* stats) { *stats = sim_stats; }
+
+az_result az_ulib_pal_flash_sim_get_page_counters(
+    uint32_t region,
+    uint32_t page,
+    uint32_t* program_count,
+    uint32_t* erase_count)
+{
+  if (page >= az_ulib_pal_flash_sim_get_page_count(region))
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  *program_count = sim_regions[region].program_count[page];
+  *erase_count = sim_regions[region].erase_count[page];
+  return AZ_OK;
+}
+
+uint32_t az_ulib_pal_flash_sim_get_page_count(uint32_t region)
+{
+  if (region >= sim_region_count)
+  {
+    return 0;
+  }
+
+  return (uint32_t)(
+      (size_t)(sim_regions[region].end - sim_regions[region].start) / sim_config.page_size);
+}
+
+az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t source)
+{
+  return program_64(destination_ptr, source);
+}
+
+az_result _az_ulib_pal_flash_driver_erase(uint64_t* destination_ptr, uint32_t size)
+{
+  uint8_t* start = (uint8_t*)destination_ptr;
+  uint8_t* end = start + size;
+  flash_region* region = find_region(start);
+
+  if (region == NULL)
+  {
+    /* Out of the regions there is no page geometry, so only the requested bytes are erased. */
+    (void)memset(start, ERASED_BYTE, size);
+    sim_stats.erase_count++;
+    spend(sim_config.erase_latency_ns);
+    return AZ_OK;
+  }
+
+  /* Erase all pages touched by the requested range. */
+  uint32_t first_page = get_page(region, start);
+  uint32_t last_page = (end > region->end) ? get_page(region, region->end - 1)
+                                           : get_page(region, end - 1);
+  for (uint32_t page = first_page; page <= last_page; page++)
+  {
+    (void)memset(
+        region->start + ((size_t)page * sim_config.page_size), ERASED_BYTE, sim_config.page_size);
+    region->erase_count[page]++;
+    sim_stats.erase_count++;
+    spend(sim_config.erase_latency_ns);
+  }
+
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_read(
+    const uint8_t* source_ptr,
+    uint8_t* destination_ptr,
+    uint32_t size)
+{
+  sim_stats.read_count++;
+  sim_stats.read_bytes += size;
+  (void)memcpy(destination_ptr, source_ptr, size);
+  spend(sim_config.read_latency_ns);
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_open(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint64_t* destination_ptr)
+{
+  flash_cb->destination_ptr = destination_ptr;
+  flash_cb->remainder_count = 0;
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_write(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint8_t* source_ptr,
+    uint32_t size)
+{
+  az_result result = AZ_OK;
+
+  /* Complete the double-word left open by the previous write. */
+  while ((size > 0) && (flash_cb->remainder_count != 0) && (result == AZ_OK))
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+    if (flash_cb->remainder_count == 8)
+    {
+      result = program_64(flash_cb->destination_ptr++, flash_cb->write_buffer.uint64);
+      flash_cb->remainder_count = 0;
+    }
+  }
+
+  /* Program full double-words straight from the source. */
+  while ((size >= sizeof(uint64_t)) && (result == AZ_OK))
+  {
+    uint64_t word;
+    (void)memcpy(&word, source_ptr, sizeof(uint64_t));
+    result = program_64(flash_cb->destination_ptr++, word);
+    source_ptr += sizeof(uint64_t);
+    size -= (uint32_t)sizeof(uint64_t);
+  }
+
+  /* Keep the tail for the next write or the close. */
+  while ((size > 0) && (result == AZ_OK))
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+  }
+
+  return result;
+}
+
+az_result _az_ulib_pal_flash_driver_close(
+    _az_ulib_pal_flash_driver_control_block* flash_cb,
+    uint8_t pad)
+{
+  az_result result = AZ_OK;
+
+  if (flash_cb->remainder_count != 0)
+  {
+    for (uint32_t i = flash_cb->remainder_count; i < 8; i++)
+    {
+      flash_cb->write_buffer.uint8[i] = pad;
+    }
+    result = program_64(flash_cb->destination_ptr, flash_cb->write_buffer.uint64);
+  }
+  return result;
+}
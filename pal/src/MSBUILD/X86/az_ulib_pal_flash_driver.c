@@ -4,7 +4,10 @@
 #include "_az_ulib_pal_flash_driver.h"
 #include "az_ulib_result.h"
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t source)
 {
@@ -14,11 +17,16 @@ az_result _az_ulib_pal_flash_driver_write_64(uint64_t* destination_ptr, uint64_t
 
 az_result _az_ulib_pal_flash_driver_erase(uint64_t* destination_ptr, uint32_t size)
 {
-  for (uint8_t* runner = (uint8_t*)destination_ptr; runner < ((uint8_t*)destination_ptr + size);
-       runner++)
-  {
-    *runner = 0xFF;
-  }
+  (void)memset(destination_ptr, 0xFF, size);
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_read(
+    const uint8_t* source_ptr,
+    uint8_t* destination_ptr,
+    uint32_t size)
+{
+  (void)memcpy(destination_ptr, source_ptr, size);
   return AZ_OK;
 }
 
@@ -36,15 +44,34 @@ az_result _az_ulib_pal_flash_driver_write(
     uint8_t* source_ptr,
     uint32_t size)
 {
-  for (uint32_t i = 0; i < size; i++)
+  /* Complete the double-word left open by the previous write. */
+  while ((size > 0) && (flash_cb->remainder_count != 0))
   {
     flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
     if (flash_cb->remainder_count == 8)
     {
       *flash_cb->destination_ptr++ = flash_cb->write_buffer.uint64;
       flash_cb->remainder_count = 0;
     }
   }
+
+  /* Program full double-words straight from the source. */
+  for (; size >= sizeof(uint64_t); size -= (uint32_t)sizeof(uint64_t))
+  {
+    uint64_t word;
+    (void)memcpy(&word, source_ptr, sizeof(uint64_t));
+    *flash_cb->destination_ptr++ = word;
+    source_ptr += sizeof(uint64_t);
+  }
+
+  /* Keep the tail for the next write or the close. */
+  while (size > 0)
+  {
+    flash_cb->write_buffer.uint8[flash_cb->remainder_count++] = *source_ptr++;
+    size--;
+  }
+
   return AZ_OK;
 }
 
@@ -62,3 +89,142 @@ az_result _az_ulib_pal_flash_driver_close(
   }
   return AZ_OK;
 }
+
+/*
+ * There is no background programming on this target, so the asynchronous operations run in the
+ * call that submits them. An operation submitted by a callback waits in this queue until the
+ * callback returns, and the outermost submit runs it, so a callback that always submits again
+ * loops instead of growing the stack. As the synchronous API, this is not thread safe.
+ */
+static _az_ulib_pal_flash_driver_operation* queue_head = NULL;
+static _az_ulib_pal_flash_driver_operation* queue_tail = NULL;
+static _az_ulib_pal_flash_driver_operation* running = NULL;
+static bool running_resubmitted = false;
+
+static az_result run_operation(_az_ulib_pal_flash_driver_operation* operation)
+{
+  az_result result;
+
+  if (operation->type == _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_ERASE)
+  {
+    result = _az_ulib_pal_flash_driver_erase(operation->destination_ptr, operation->size);
+  }
+  else
+  {
+    _az_ulib_pal_flash_driver_control_block flash_cb;
+    result = _az_ulib_pal_flash_driver_open(&flash_cb, operation->destination_ptr);
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_pal_flash_driver_write(&flash_cb, operation->source_ptr, operation->size);
+    }
+    if (result == AZ_OK)
+    {
+      result = _az_ulib_pal_flash_driver_close(&flash_cb, operation->pad);
+    }
+  }
+
+  return result;
+}
+
+static az_result submit_operation(_az_ulib_pal_flash_driver_operation* operation)
+{
+  operation->next = NULL;
+  operation->result = AZ_ULIB_PENDING;
+  if (operation == running)
+  {
+    running_resubmitted = true;
+  }
+  if (queue_tail == NULL)
+  {
+    queue_head = operation;
+  }
+  else
+  {
+    queue_tail->next = operation;
+  }
+  queue_tail = operation;
+
+  /* Submitted from a callback, the loop below runs it when the callback returns. */
+  if (running != NULL)
+  {
+    return AZ_OK;
+  }
+
+  while (queue_head != NULL)
+  {
+    /* The operation leaves the queue before it runs, so the callback may submit it again. */
+    operation = queue_head;
+    queue_head = operation->next;
+    if (queue_head == NULL)
+    {
+      queue_tail = NULL;
+    }
+    running = operation;
+    running_resubmitted = false;
+
+    az_result result = run_operation(operation);
+
+    /* The callback runs before the result is published, because the caller may release the
+     * operation as soon as it sees the result. If the callback submitted the operation again, it
+     * stays pending for the new run. */
+    if (operation->callback != NULL)
+    {
+      operation->callback(result, operation->context);
+    }
+    if (!running_resubmitted)
+    {
+      operation->result = result;
+    }
+    running = NULL;
+  }
+
+  return AZ_OK;
+}
+
+az_result _az_ulib_pal_flash_driver_write_async(
+    _az_ulib_pal_flash_driver_operation* operation,
+    uint64_t* destination_ptr,
+    uint8_t* source_ptr,
+    uint32_t size,
+    uint8_t pad,
+    _az_ulib_pal_flash_driver_callback callback,
+    void* context)
+{
+  operation->type = _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_WRITE;
+  operation->destination_ptr = destination_ptr;
+  operation->source_ptr = source_ptr;
+  operation->size = size;
+  operation->pad = pad;
+  operation->callback = callback;
+  operation->context = context;
+
+  return submit_operation(operation);
+}
+
+az_result _az_ulib_pal_flash_driver_erase_async(
+    _az_ulib_pal_flash_driver_operation* operation,
+    uint64_t* destination_ptr,
+    uint32_t size,
+    _az_ulib_pal_flash_driver_callback callback,
+    void* context)
+{
+  operation->type = _AZ_ULIB_PAL_FLASH_DRIVER_OPERATION_ERASE;
+  operation->destination_ptr = destination_ptr;
+  operation->source_ptr = NULL;
+  operation->size = size;
+  operation->pad = 0;
+  operation->callback = callback;
+  operation->context = context;
+
+  return submit_operation(operation);
+}
+
+az_result _az_ulib_pal_flash_driver_poll(const _az_ulib_pal_flash_driver_operation* operation)
+{
+  return operation->result;
+}
+
+az_result _az_ulib_pal_flash_driver_wait(const _az_ulib_pal_flash_driver_operation* operation)
+{
+  return operation->result;
+}
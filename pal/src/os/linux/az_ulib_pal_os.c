@@ -12,30 +12,426 @@
 #include <unistd.h>
 #endif
 
+#include "az_ulib_base.h"
 #include "az_ulib_pal_os.h"
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_result.h"
 
-void az_pal_os_lock_init(az_ulib_pal_os_lock* lock)
+/* Timeouts are relative, so they shall not move with the wall clock. */
+static az_result monotonic_cond_init(pthread_cond_t* cond)
+{
+  pthread_condattr_t attr;
+  az_result result = AZ_ERROR_ULIB_SYSTEM;
+
+  if (pthread_condattr_init(&attr) == 0)
+  {
+    if ((pthread_condattr_setclock(&attr, CLOCK_MONOTONIC) == 0)
+        && (pthread_cond_init(cond, &attr) == 0))
+    {
+      result = AZ_OK;
+    }
+    (void)pthread_condattr_destroy(&attr);
+  }
+
+  return result;
+}
+
+static az_result cond_init(pthread_mutex_t* mutex, pthread_cond_t* cond)
+{
+  if (pthread_mutex_init(mutex, NULL) != 0)
+  {
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  if (monotonic_cond_init(cond) != AZ_OK)
+  {
+    (void)pthread_mutex_destroy(mutex);
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  return AZ_OK;
+}
+
+static void get_deadline(struct timespec* deadline, uint32_t wait_option_ms)
+{
+  (void)clock_gettime(CLOCK_MONOTONIC, deadline);
+  deadline->tv_sec += (time_t)(wait_option_ms / 1000);
+  deadline->tv_nsec += (long)(wait_option_ms % 1000) * 1000000L;
+  if (deadline->tv_nsec >= 1000000000L)
+  {
+    deadline->tv_sec++;
+    deadline->tv_nsec -= 1000000000L;
+  }
+}
+
+/*
+ * Wait, with the mutex acquired, for the condition to signal. Returns AZ_ERROR_ULIB_TIMEOUT when
+ * the deadline is over, the caller shall check its predicate again in any case.
+ */
+static az_result cond_wait(
+    pthread_mutex_t* mutex,
+    pthread_cond_t* cond,
+    uint32_t wait_option_ms,
+    const struct timespec* deadline)
+{
+  int ret;
+
+  if (wait_option_ms == AZ_ULIB_NO_WAIT)
+  {
+    return AZ_ERROR_ULIB_TIMEOUT;
+  }
+  else if (wait_option_ms == AZ_ULIB_WAIT_FOREVER)
+  {
+    ret = pthread_cond_wait(cond, mutex);
+  }
+  else
+  {
+    ret = pthread_cond_timedwait(cond, mutex, deadline);
+  }
+
+  return (ret == 0) ? AZ_OK : ((ret == ETIMEDOUT) ? AZ_ERROR_ULIB_TIMEOUT : AZ_ERROR_ULIB_SYSTEM);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+#define CPU_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define CPU_RELAX()
+#endif
+
+typedef int (*acquire_function)(void* handle);
+
+/* The lock holder cannot run while another thread spins in a single CPU, so it blocks at once. */
+static uint32_t get_spin_count(void)
+{
+  static volatile long spin_count = -1;
+
+  if (spin_count < 0)
+  {
+#ifdef _SC_NPROCESSORS_ONLN
+    spin_count = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT : 0;
+#else
+    spin_count = AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT;
+#endif
+  }
+
+  return (uint32_t)spin_count;
+}
+
+static int try_lock_mutex(void* handle) { return pthread_mutex_trylock((pthread_mutex_t*)handle); }
+
+static int lock_mutex(void* handle) { return pthread_mutex_lock((pthread_mutex_t*)handle); }
+
+static int try_lock_shared(void* handle)
+{
+  return pthread_rwlock_tryrdlock((pthread_rwlock_t*)handle);
+}
+
+static int lock_shared(void* handle) { return pthread_rwlock_rdlock((pthread_rwlock_t*)handle); }
+
+static int try_lock_exclusive(void* handle)
+{
+  return pthread_rwlock_trywrlock((pthread_rwlock_t*)handle);
+}
+
+static int lock_exclusive(void* handle) { return pthread_rwlock_wrlock((pthread_rwlock_t*)handle); }
+
+/* The locks only have counters if the statistics are enabled. */
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+#define LOCK_COUNTERS(lock) (&(lock)->counters)
+#else
+#define LOCK_COUNTERS(lock) ((void)(lock), (az_ulib_pal_os_lock_counters*)NULL)
+#endif
+
+/*
+ * Spin on try_acquire, with a pause hint to the CPU, before it blocks on acquire. If the statistics
+ * are enabled, an exclusive holder also records when it acquired the lock.
+ */
+static void spin_then_block(
+    void* handle,
+    acquire_function try_acquire,
+    acquire_function acquire,
+    az_ulib_pal_os_lock_counters* counters,
+    bool exclusive)
 {
-  pthread_mutex_init((pthread_mutex_t*)lock, NULL);
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  uint64_t start_ns = az_pal_os_get_time_ns();
+#endif
+  bool contended = false;
+  bool blocked = false;
+
+  if (try_acquire(handle) != 0)
+  {
+    contended = true;
+    blocked = true;
+    uint32_t spin_count = get_spin_count();
+    for (uint32_t spin = 0; spin < spin_count; spin++)
+    {
+      CPU_RELAX();
+      if (try_acquire(handle) == 0)
+      {
+        blocked = false;
+        break;
+      }
+    }
+    if (blocked)
+    {
+      (void)acquire(handle);
+    }
+  }
+
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  /* Shared holders update the counters at the same time. */
+  uint64_t now_ns = az_pal_os_get_time_ns();
+  (void)__atomic_fetch_add(&counters->acquire_count, 1, __ATOMIC_RELAXED);
+  (void)__atomic_fetch_add(&counters->contended_count, contended ? 1 : 0, __ATOMIC_RELAXED);
+  (void)__atomic_fetch_add(&counters->blocked_count, blocked ? 1 : 0, __ATOMIC_RELAXED);
+  (void)__atomic_fetch_add(&counters->wait_time_ns, now_ns - start_ns, __ATOMIC_RELAXED);
+  if (exclusive)
+  {
+    counters->hold_start_ns = now_ns;
+  }
+#else
+  (void)counters;
+  (void)exclusive;
+  (void)contended;
+  (void)blocked;
+#endif
 }
 
-void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock)
+static void count_release_exclusive(az_ulib_pal_os_lock_counters* counters)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  (void)__atomic_fetch_add(
+      &counters->hold_time_ns, az_pal_os_get_time_ns() - counters->hold_start_ns, __ATOMIC_RELAXED);
+#else
+  (void)counters;
+#endif
+}
+
+static void init_counters(az_ulib_pal_os_lock_counters* counters)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  counters->acquire_count = 0;
+  counters->contended_count = 0;
+  counters->blocked_count = 0;
+  counters->wait_time_ns = 0;
+  counters->hold_time_ns = 0;
+  counters->hold_start_ns = 0;
+#else
+  (void)counters;
+#endif
+}
+
+static void get_counters(
+    const az_ulib_pal_os_lock_counters* counters,
+    az_ulib_pal_os_lock_stats* stats)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  stats->acquire_count = __atomic_load_n(&counters->acquire_count, __ATOMIC_RELAXED);
+  stats->contended_count = __atomic_load_n(&counters->contended_count, __ATOMIC_RELAXED);
+  stats->blocked_count = __atomic_load_n(&counters->blocked_count, __ATOMIC_RELAXED);
+  stats->wait_time_ns = __atomic_load_n(&counters->wait_time_ns, __ATOMIC_RELAXED);
+  stats->hold_time_ns = __atomic_load_n(&counters->hold_time_ns, __ATOMIC_RELAXED);
+#else
+  (void)counters;
+  stats->acquire_count = 0;
+  stats->contended_count = 0;
+  stats->blocked_count = 0;
+  stats->wait_time_ns = 0;
+  stats->hold_time_ns = 0;
+#endif
+}
+
+void az_pal_os_lock_init(az_ulib_pal_os_lock* lock)
 {
-  pthread_mutex_destroy((pthread_mutex_t*)lock);
+  init_counters(LOCK_COUNTERS(lock));
+  pthread_mutex_init(&lock->mutex, NULL);
 }
 
+void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock) { pthread_mutex_destroy(&lock->mutex); }
+
 void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock)
 {
-  pthread_mutex_lock((pthread_mutex_t*)lock);
+  spin_then_block(&lock->mutex, try_lock_mutex, lock_mutex, LOCK_COUNTERS(lock), true);
 }
 
 void az_pal_os_lock_release(az_ulib_pal_os_lock* lock)
 {
-  pthread_mutex_unlock((pthread_mutex_t*)lock);
+  count_release_exclusive(LOCK_COUNTERS(lock));
+  pthread_mutex_unlock(&lock->mutex);
+}
+
+void az_pal_os_lock_get_stats(const az_ulib_pal_os_lock* lock, az_ulib_pal_os_lock_stats* stats)
+{
+  get_counters(LOCK_COUNTERS(lock), stats);
 }
 
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock)
+{
+  init_counters(LOCK_COUNTERS(rwlock));
+  pthread_rwlock_init(&rwlock->rwlock, NULL);
+}
+
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock)
+{
+  pthread_rwlock_destroy(&rwlock->rwlock);
+}
+
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  spin_then_block(&rwlock->rwlock, try_lock_shared, lock_shared, LOCK_COUNTERS(rwlock), false);
+}
+
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  pthread_rwlock_unlock(&rwlock->rwlock);
+}
+
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  spin_then_block(
+      &rwlock->rwlock, try_lock_exclusive, lock_exclusive, LOCK_COUNTERS(rwlock), true);
+}
+
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  count_release_exclusive(LOCK_COUNTERS(rwlock));
+  pthread_rwlock_unlock(&rwlock->rwlock);
+}
+
+void az_pal_os_rwlock_get_stats(
+    const az_ulib_pal_os_rwlock* rwlock,
+    az_ulib_pal_os_lock_stats* stats)
+{
+  get_counters(LOCK_COUNTERS(rwlock), stats);
+}
+
+az_result az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  semaphore->count = initial_count;
+  return cond_init(&semaphore->mutex, &semaphore->cond);
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)pthread_cond_destroy(&semaphore->cond);
+  (void)pthread_mutex_destroy(&semaphore->mutex);
+}
+
+az_result az_pal_os_semaphore_take(az_ulib_pal_os_semaphore* semaphore, uint32_t wait_option_ms)
+{
+  az_result result = AZ_OK;
+  struct timespec deadline;
+
+  get_deadline(&deadline, wait_option_ms);
+
+  (void)pthread_mutex_lock(&semaphore->mutex);
+  while ((semaphore->count == 0) && (result == AZ_OK))
+  {
+    result = cond_wait(&semaphore->mutex, &semaphore->cond, wait_option_ms, &deadline);
+  }
+  if (semaphore->count != 0)
+  {
+    semaphore->count--;
+    result = AZ_OK;
+  }
+  (void)pthread_mutex_unlock(&semaphore->mutex);
+
+  return result;
+}
+
+void az_pal_os_semaphore_give(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)pthread_mutex_lock(&semaphore->mutex);
+  semaphore->count++;
+  (void)pthread_cond_signal(&semaphore->cond);
+  (void)pthread_mutex_unlock(&semaphore->mutex);
+}
+
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state)
+{
+  event->signaled = initial_state;
+  event->manual_reset = manual_reset;
+  return cond_init(&event->mutex, &event->cond);
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event)
+{
+  (void)pthread_cond_destroy(&event->cond);
+  (void)pthread_mutex_destroy(&event->mutex);
+}
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  (void)pthread_mutex_lock(&event->mutex);
+  event->signaled = true;
+  if (event->manual_reset)
+  {
+    (void)pthread_cond_broadcast(&event->cond);
+  }
+  else
+  {
+    (void)pthread_cond_signal(&event->cond);
+  }
+  (void)pthread_mutex_unlock(&event->mutex);
+}
+
+void az_pal_os_event_reset(az_ulib_pal_os_event* event)
+{
+  (void)pthread_mutex_lock(&event->mutex);
+  event->signaled = false;
+  (void)pthread_mutex_unlock(&event->mutex);
+}
+
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  az_result result = AZ_OK;
+  struct timespec deadline;
+
+  get_deadline(&deadline, wait_option_ms);
+
+  (void)pthread_mutex_lock(&event->mutex);
+  while (!event->signaled && (result == AZ_OK))
+  {
+    result = cond_wait(&event->mutex, &event->cond, wait_option_ms, &deadline);
+  }
+  if (event->signaled)
+  {
+    if (!event->manual_reset)
+    {
+      event->signaled = false;
+    }
+    result = AZ_OK;
+  }
+  (void)pthread_mutex_unlock(&event->mutex);
+
+  return result;
+}
+
+uint64_t az_pal_os_get_time_ns(void)
+{
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/* One tick is one millisecond. The coarse clock is read without the time counter of the CPU, and
+ * the math is in 32 bits, so it wraps around with the ticks. */
+uint32_t az_pal_os_get_ticks(void)
+{
+  struct timespec now;
+#ifdef CLOCK_MONOTONIC_COARSE
+  (void)clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+#else
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+#endif
+  return ((uint32_t)now.tv_sec * 1000U) + ((uint32_t)now.tv_nsec / 1000000U);
+}
+
+uint32_t az_pal_os_get_ticks_per_second(void) { return 1000; }
+
 void az_pal_os_sleep(uint32_t sleep_time_ms)
 {
 #ifdef TI_RTOS
@@ -79,3 +475,205 @@ az_result az_pal_os_thread_join(az_ulib_pal_thread_handle handle, int* res)
 
   return AZ_OK;
 }
+
+/*
+ * The worker threads share a list of work items sorted by deadline. They wait on the condition for
+ * the first deadline of a work that is not running, or for a change in the list or in a running
+ * work.
+ */
+static pthread_mutex_t work_queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t work_queue_changed;
+static pthread_t work_queue_workers[AZ_ULIB_PAL_OS_WORK_QUEUE_THREADS];
+static uint32_t work_queue_worker_count = 0;
+static bool work_queue_running = false;
+static az_ulib_pal_os_work* work_queue_head = NULL;
+
+static void insert_work(az_ulib_pal_os_work* work)
+{
+  az_ulib_pal_os_work** position = &work_queue_head;
+
+  while ((*position != NULL) && ((*position)->deadline_ns <= work->deadline_ns))
+  {
+    position = &((*position)->next);
+  }
+  work->next = *position;
+  *position = work;
+  work->queued = true;
+}
+
+static void remove_work(az_ulib_pal_os_work* work)
+{
+  for (az_ulib_pal_os_work** position = &work_queue_head; *position != NULL;
+       position = &((*position)->next))
+  {
+    if (*position == work)
+    {
+      *position = work->next;
+      break;
+    }
+  }
+  work->next = NULL;
+  work->queued = false;
+}
+
+static void* work_queue_worker(void* args)
+{
+  (void)args;
+
+  (void)pthread_mutex_lock(&work_queue_lock);
+  while (work_queue_running)
+  {
+    /* A work scheduled again while it runs waits for the current run, so it never runs in two
+     * threads at the same time. The works behind it do not wait. */
+    az_ulib_pal_os_work* work = work_queue_head;
+    while ((work != NULL) && work->running)
+    {
+      work = work->next;
+    }
+
+    if (work == NULL)
+    {
+      (void)pthread_cond_wait(&work_queue_changed, &work_queue_lock);
+    }
+    else if (work->deadline_ns > az_pal_os_get_time_ns())
+    {
+      struct timespec deadline = { .tv_sec = (time_t)(work->deadline_ns / 1000000000ULL),
+                                   .tv_nsec = (long)(work->deadline_ns % 1000000000ULL) };
+      (void)pthread_cond_timedwait(&work_queue_changed, &work_queue_lock, &deadline);
+    }
+    else
+    {
+      remove_work(work);
+      work->running = true;
+      work->runner = pthread_self();
+      (void)pthread_mutex_unlock(&work_queue_lock);
+
+      work->function(work->context);
+
+      (void)pthread_mutex_lock(&work_queue_lock);
+      work->running = false;
+
+      /* A periodic work runs again, unless it was canceled or scheduled again while running, or
+       * the work queue was deinitialized. A late work skips the runs that it missed. */
+      if (work_queue_running && (work->period_ms != 0) && !work->queued && !work->canceled)
+      {
+        uint64_t now = az_pal_os_get_time_ns();
+        work->deadline_ns += (uint64_t)work->period_ms * 1000000ULL;
+        if (work->deadline_ns < now)
+        {
+          work->deadline_ns = now;
+        }
+        insert_work(work);
+      }
+      (void)pthread_cond_broadcast(&work_queue_changed);
+    }
+  }
+  (void)pthread_mutex_unlock(&work_queue_lock);
+
+  return NULL;
+}
+
+az_result az_pal_os_work_queue_init(void)
+{
+  if (monotonic_cond_init(&work_queue_changed) != AZ_OK)
+  {
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+
+  work_queue_head = NULL;
+  work_queue_running = true;
+  for (work_queue_worker_count = 0;
+       work_queue_worker_count < AZ_ULIB_PAL_OS_WORK_QUEUE_THREADS;
+       work_queue_worker_count++)
+  {
+    if (pthread_create(
+            &work_queue_workers[work_queue_worker_count], NULL, work_queue_worker, NULL)
+        != 0)
+    {
+      az_pal_os_work_queue_deinit();
+      return AZ_ERROR_ULIB_SYSTEM;
+    }
+  }
+
+  return AZ_OK;
+}
+
+void az_pal_os_work_queue_deinit(void)
+{
+  (void)pthread_mutex_lock(&work_queue_lock);
+  work_queue_running = false;
+  while (work_queue_head != NULL)
+  {
+    remove_work(work_queue_head);
+  }
+  (void)pthread_cond_broadcast(&work_queue_changed);
+  (void)pthread_mutex_unlock(&work_queue_lock);
+
+  for (uint32_t index = 0; index < work_queue_worker_count; index++)
+  {
+    (void)pthread_join(work_queue_workers[index], NULL);
+  }
+  work_queue_worker_count = 0;
+  (void)pthread_cond_destroy(&work_queue_changed);
+}
+
+az_result az_pal_os_work_init(
+    az_ulib_pal_os_work* work,
+    az_ulib_pal_os_work_function function,
+    void* context)
+{
+  work->next = NULL;
+  work->function = function;
+  work->context = context;
+  work->deadline_ns = 0;
+  work->period_ms = 0;
+  work->queued = false;
+  work->running = false;
+  work->canceled = false;
+
+  return AZ_OK;
+}
+
+void az_pal_os_work_deinit(az_ulib_pal_os_work* work) { az_pal_os_work_cancel(work); }
+
+az_result az_pal_os_work_schedule(az_ulib_pal_os_work* work, uint32_t delay_ms, uint32_t period_ms)
+{
+  az_result result;
+
+  (void)pthread_mutex_lock(&work_queue_lock);
+  if (!work_queue_running)
+  {
+    result = AZ_ERROR_ULIB_SYSTEM;
+  }
+  else
+  {
+    if (work->queued)
+    {
+      remove_work(work);
+    }
+    work->canceled = false;
+    work->period_ms = period_ms;
+    work->deadline_ns = az_pal_os_get_time_ns() + ((uint64_t)delay_ms * 1000000ULL);
+    insert_work(work);
+    (void)pthread_cond_broadcast(&work_queue_changed);
+    result = AZ_OK;
+  }
+  (void)pthread_mutex_unlock(&work_queue_lock);
+
+  return result;
+}
+
+void az_pal_os_work_cancel(az_ulib_pal_os_work* work)
+{
+  (void)pthread_mutex_lock(&work_queue_lock);
+  work->canceled = true;
+  if (work->queued)
+  {
+    remove_work(work);
+  }
+  while (work->running && !pthread_equal(work->runner, pthread_self()))
+  {
+    (void)pthread_cond_wait(&work_queue_changed, &work_queue_lock);
+  }
+  (void)pthread_mutex_unlock(&work_queue_lock);
+}
@@ -4,6 +4,7 @@
 
 #include <tx_api.h>
 
+#include "az_ulib_base.h"
 #include "az_ulib_pal_os.h"
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_result.h"
@@ -16,7 +17,192 @@ void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock) { tx_mutex_get(lock, TX_W
 
 void az_pal_os_lock_release(az_ulib_pal_os_lock* lock) { tx_mutex_put(lock); }
 
-void az_pal_os_sleep(uint32_t sleep_time_ms) { tx_thread_sleep(sleep_time_ms); }
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_mutex_create(&rwlock->readers_lock, NULL, TX_NO_INHERIT);
+  tx_semaphore_create(&rwlock->exclusive, NULL, 1);
+  rwlock->readers = 0;
+}
+
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_semaphore_delete(&rwlock->exclusive);
+  tx_mutex_delete(&rwlock->readers_lock);
+}
+
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_mutex_get(&rwlock->readers_lock, TX_WAIT_FOREVER);
+  if (rwlock->readers++ == 0)
+  {
+    tx_semaphore_get(&rwlock->exclusive, TX_WAIT_FOREVER);
+  }
+  tx_mutex_put(&rwlock->readers_lock);
+}
+
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_mutex_get(&rwlock->readers_lock, TX_WAIT_FOREVER);
+  if (--rwlock->readers == 0)
+  {
+    tx_semaphore_put(&rwlock->exclusive);
+  }
+  tx_mutex_put(&rwlock->readers_lock);
+}
+
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_semaphore_get(&rwlock->exclusive, TX_WAIT_FOREVER);
+}
+
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  tx_semaphore_put(&rwlock->exclusive);
+}
+
+az_result az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  return (tx_semaphore_create(semaphore, NULL, (ULONG)initial_count) == TX_SUCCESS)
+      ? AZ_OK
+      : AZ_ERROR_ULIB_SYSTEM;
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore)
+{
+  tx_semaphore_delete(semaphore);
+}
+
+/* One tick is one millisecond, unless the port defines the tick rate. */
+#ifndef TX_TIMER_TICKS_PER_SECOND
+#define TX_TIMER_TICKS_PER_SECOND 1000
+#endif
+
+/* AZ_ULIB_NO_WAIT and AZ_ULIB_WAIT_FOREVER have the same values as TX_NO_WAIT and
+ * TX_WAIT_FOREVER. Any other time is rounded up to the next tick, so ThreadX never waits less than
+ * asked, and clamped below TX_WAIT_FOREVER, so a long finite wait never becomes infinite. */
+static ULONG convert_ms_to_ticks(uint32_t time_ms)
+{
+  if (time_ms == AZ_ULIB_WAIT_FOREVER)
+  {
+    return TX_WAIT_FOREVER;
+  }
+
+  uint64_t ticks = (((uint64_t)time_ms * TX_TIMER_TICKS_PER_SECOND) + 999) / 1000;
+  return (ticks >= (uint64_t)TX_WAIT_FOREVER) ? (TX_WAIT_FOREVER - 1) : (ULONG)ticks;
+}
+
+static az_result convert_wait_status(UINT status)
+{
+  switch (status)
+  {
+    case TX_SUCCESS:
+      return AZ_OK;
+    case TX_NO_INSTANCE:
+    case TX_NO_EVENTS:
+      return AZ_ERROR_ULIB_TIMEOUT;
+    default:
+      return AZ_ERROR_ULIB_SYSTEM;
+  }
+}
+
+az_result az_pal_os_semaphore_take(az_ulib_pal_os_semaphore* semaphore, uint32_t wait_option_ms)
+{
+  return convert_wait_status(tx_semaphore_get(semaphore, convert_ms_to_ticks(wait_option_ms)));
+}
+
+void az_pal_os_semaphore_give(az_ulib_pal_os_semaphore* semaphore) { tx_semaphore_put(semaphore); }
+
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state)
+{
+  event->manual_reset = manual_reset ? TX_TRUE : TX_FALSE;
+  if (tx_event_flags_create(&event->group, NULL) != TX_SUCCESS)
+  {
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+  if (initial_state)
+  {
+    tx_event_flags_set(&event->group, 1, TX_OR);
+  }
+  return AZ_OK;
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event) { tx_event_flags_delete(&event->group); }
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  tx_event_flags_set(&event->group, 1, TX_OR);
+}
+
+void az_pal_os_event_reset(az_ulib_pal_os_event* event)
+{
+  tx_event_flags_set(&event->group, 0, TX_AND);
+}
+
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  ULONG actual_flags;
+
+  return convert_wait_status(tx_event_flags_get(
+      &event->group,
+      1,
+      (event->manual_reset == TX_TRUE) ? TX_OR : TX_OR_CLEAR,
+      &actual_flags,
+      convert_ms_to_ticks(wait_option_ms)));
+}
+
+uint64_t az_pal_os_get_time_ns(void)
+{
+  static ULONG last_ticks = 0;
+  static uint64_t wraps = 0;
+  uint64_t ticks;
+  TX_INTERRUPT_SAVE_AREA
+
+  /* Extend the 32 bits tick counter to 64 bits, counting the wraps. */
+  TX_DISABLE
+  ULONG now = tx_time_get();
+  if (now < last_ticks)
+  {
+    wraps++;
+  }
+  last_ticks = now;
+  ticks = (wraps << 32) | (uint64_t)now;
+  TX_RESTORE
+
+  uint64_t rate = (uint64_t)TX_TIMER_TICKS_PER_SECOND;
+  return ((ticks / rate) * 1000000000ULL) + (((ticks % rate) * 1000000000ULL) / rate);
+}
+
+uint32_t az_pal_os_get_ticks(void) { return (uint32_t)tx_time_get(); }
+
+uint32_t az_pal_os_get_ticks_per_second(void) { return (uint32_t)TX_TIMER_TICKS_PER_SECOND; }
+
+/* ThreadX locks do not spin and have no counters. */
+void az_pal_os_lock_get_stats(const az_ulib_pal_os_lock* lock, az_ulib_pal_os_lock_stats* stats)
+{
+  (void)lock;
+  stats->acquire_count = 0;
+  stats->contended_count = 0;
+  stats->blocked_count = 0;
+  stats->wait_time_ns = 0;
+  stats->hold_time_ns = 0;
+}
+
+void az_pal_os_rwlock_get_stats(
+    const az_ulib_pal_os_rwlock* rwlock,
+    az_ulib_pal_os_lock_stats* stats)
+{
+  (void)rwlock;
+  stats->acquire_count = 0;
+  stats->contended_count = 0;
+  stats->blocked_count = 0;
+  stats->wait_time_ns = 0;
+  stats->hold_time_ns = 0;
+}
+
+void az_pal_os_sleep(uint32_t sleep_time_ms)
+{
+  tx_thread_sleep(convert_ms_to_ticks(sleep_time_ms));
+}
 
 az_result az_pal_os_thread_create(
     az_ulib_pal_start_function_ptr function_ptr,
@@ -35,3 +221,29 @@ az_result az_pal_os_thread_join(az_ulib_pal_thread_handle handle, int* res)
   (void)res;
   return AZ_ERROR_NOT_IMPLEMENTED;
 }
+
+az_result az_pal_os_work_queue_init(void) { return AZ_ERROR_NOT_IMPLEMENTED; }
+
+void az_pal_os_work_queue_deinit(void) {}
+
+az_result az_pal_os_work_init(
+    az_ulib_pal_os_work* work,
+    az_ulib_pal_os_work_function function,
+    void* context)
+{
+  work->function = function;
+  work->context = context;
+  return AZ_OK;
+}
+
+void az_pal_os_work_deinit(az_ulib_pal_os_work* work) { (void)work; }
+
+az_result az_pal_os_work_schedule(az_ulib_pal_os_work* work, uint32_t delay_ms, uint32_t period_ms)
+{
+  (void)work;
+  (void)delay_ms;
+  (void)period_ms;
+  return AZ_ERROR_NOT_IMPLEMENTED;
+}
+
+void az_pal_os_work_cancel(az_ulib_pal_os_work* work) { (void)work; }
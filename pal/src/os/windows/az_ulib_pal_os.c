@@ -2,19 +2,265 @@
 // Licensed under the MIT license.
 // See LICENSE file in the project root for full license information.
 
+#include <limits.h>
+#include <stdbool.h>
 #include <windows.h>
 
 #include "az_ulib_pal_os.h"
 #include "az_ulib_pal_os_api.h"
 #include "az_ulib_result.h"
 
-void az_pal_os_lock_init(az_ulib_pal_os_lock* lock) { InitializeSRWLock((SRWLOCK*)lock); }
+/* The locks only have counters if the statistics are enabled. */
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+#define LOCK_COUNTERS(lock) (&(lock)->counters)
+#else
+#define LOCK_COUNTERS(lock) ((void)(lock), (az_ulib_pal_os_lock_counters*)NULL)
+#endif
+
+/*
+ * Spin on the try function, with a pause hint to the CPU, before it blocks on the acquire function.
+ * If the statistics are enabled, an exclusive holder also records when it acquired the lock.
+ */
+static void spin_then_block(
+    SRWLOCK* srwlock,
+    BOOLEAN(WINAPI* try_acquire)(PSRWLOCK),
+    VOID(WINAPI* acquire)(PSRWLOCK),
+    az_ulib_pal_os_lock_counters* counters,
+    bool exclusive)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  uint64_t start_ns = az_pal_os_get_time_ns();
+#endif
+  bool contended = false;
+  bool blocked = false;
+
+  if (!try_acquire(srwlock))
+  {
+    contended = true;
+    blocked = true;
+    for (uint32_t spin = 0; spin < AZ_ULIB_PAL_OS_LOCK_SPIN_COUNT; spin++)
+    {
+      YieldProcessor();
+      if (try_acquire(srwlock))
+      {
+        blocked = false;
+        break;
+      }
+    }
+    if (blocked)
+    {
+      acquire(srwlock);
+    }
+  }
+
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  /* Shared holders update the counters at the same time. */
+  uint64_t now_ns = az_pal_os_get_time_ns();
+  (void)InterlockedIncrement(&counters->acquire_count);
+  (void)InterlockedExchangeAdd(&counters->contended_count, contended ? 1 : 0);
+  (void)InterlockedExchangeAdd(&counters->blocked_count, blocked ? 1 : 0);
+  (void)InterlockedExchangeAdd64(&counters->wait_time_ns, (LONG64)(now_ns - start_ns));
+  if (exclusive)
+  {
+    counters->hold_start_ns = (LONG64)now_ns;
+  }
+#else
+  (void)counters;
+  (void)exclusive;
+  (void)contended;
+  (void)blocked;
+#endif
+}
+
+static void count_release_exclusive(az_ulib_pal_os_lock_counters* counters)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  (void)InterlockedExchangeAdd64(
+      &counters->hold_time_ns, (LONG64)az_pal_os_get_time_ns() - counters->hold_start_ns);
+#else
+  (void)counters;
+#endif
+}
+
+static void init_counters(az_ulib_pal_os_lock_counters* counters)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  counters->acquire_count = 0;
+  counters->contended_count = 0;
+  counters->blocked_count = 0;
+  counters->wait_time_ns = 0;
+  counters->hold_time_ns = 0;
+  counters->hold_start_ns = 0;
+#else
+  (void)counters;
+#endif
+}
+
+static void get_counters(
+    const az_ulib_pal_os_lock_counters* counters,
+    az_ulib_pal_os_lock_stats* stats)
+{
+#ifdef AZ_ULIB_PAL_OS_LOCK_STATISTICS
+  stats->acquire_count = (uint32_t)counters->acquire_count;
+  stats->contended_count = (uint32_t)counters->contended_count;
+  stats->blocked_count = (uint32_t)counters->blocked_count;
+  stats->wait_time_ns = (uint64_t)counters->wait_time_ns;
+  stats->hold_time_ns = (uint64_t)counters->hold_time_ns;
+#else
+  (void)counters;
+  stats->acquire_count = 0;
+  stats->contended_count = 0;
+  stats->blocked_count = 0;
+  stats->wait_time_ns = 0;
+  stats->hold_time_ns = 0;
+#endif
+}
+
+void az_pal_os_lock_init(az_ulib_pal_os_lock* lock)
+{
+  init_counters(LOCK_COUNTERS(lock));
+  InitializeSRWLock(&lock->srwlock);
+}
 
 void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock) { (void)lock; }
 
-void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock) { AcquireSRWLockExclusive((SRWLOCK*)lock); }
+void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock)
+{
+  spin_then_block(
+      &lock->srwlock,
+      TryAcquireSRWLockExclusive,
+      AcquireSRWLockExclusive,
+      LOCK_COUNTERS(lock),
+      true);
+}
+
+void az_pal_os_lock_release(az_ulib_pal_os_lock* lock)
+{
+  count_release_exclusive(LOCK_COUNTERS(lock));
+  ReleaseSRWLockExclusive(&lock->srwlock);
+}
+
+void az_pal_os_lock_get_stats(const az_ulib_pal_os_lock* lock, az_ulib_pal_os_lock_stats* stats)
+{
+  get_counters(LOCK_COUNTERS(lock), stats);
+}
+
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock)
+{
+  init_counters(LOCK_COUNTERS(rwlock));
+  InitializeSRWLock(&rwlock->srwlock);
+}
+
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock) { (void)rwlock; }
+
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  spin_then_block(
+      &rwlock->srwlock,
+      TryAcquireSRWLockShared,
+      AcquireSRWLockShared,
+      LOCK_COUNTERS(rwlock),
+      false);
+}
+
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock)
+{
+  ReleaseSRWLockShared(&rwlock->srwlock);
+}
+
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  spin_then_block(
+      &rwlock->srwlock,
+      TryAcquireSRWLockExclusive,
+      AcquireSRWLockExclusive,
+      LOCK_COUNTERS(rwlock),
+      true);
+}
+
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  count_release_exclusive(LOCK_COUNTERS(rwlock));
+  ReleaseSRWLockExclusive(&rwlock->srwlock);
+}
+
+void az_pal_os_rwlock_get_stats(
+    const az_ulib_pal_os_rwlock* rwlock,
+    az_ulib_pal_os_lock_stats* stats)
+{
+  get_counters(LOCK_COUNTERS(rwlock), stats);
+}
+
+az_result az_pal_os_semaphore_init(az_ulib_pal_os_semaphore* semaphore, uint32_t initial_count)
+{
+  *semaphore = CreateSemaphore(NULL, (LONG)initial_count, LONG_MAX, NULL);
+  return (*semaphore == NULL) ? AZ_ERROR_ULIB_SYSTEM : AZ_OK;
+}
+
+void az_pal_os_semaphore_deinit(az_ulib_pal_os_semaphore* semaphore) { CloseHandle(*semaphore); }
+
+static az_result wait_for_object(HANDLE handle, uint32_t wait_option_ms)
+{
+  /* AZ_ULIB_WAIT_FOREVER has the same value as INFINITE. */
+  switch (WaitForSingleObject(handle, (DWORD)wait_option_ms))
+  {
+    case WAIT_OBJECT_0:
+      return AZ_OK;
+    case WAIT_TIMEOUT:
+      return AZ_ERROR_ULIB_TIMEOUT;
+    default:
+      return AZ_ERROR_ULIB_SYSTEM;
+  }
+}
+
+az_result az_pal_os_semaphore_take(az_ulib_pal_os_semaphore* semaphore, uint32_t wait_option_ms)
+{
+  return wait_for_object(*semaphore, wait_option_ms);
+}
+
+void az_pal_os_semaphore_give(az_ulib_pal_os_semaphore* semaphore)
+{
+  (void)ReleaseSemaphore(*semaphore, 1, NULL);
+}
+
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state)
+{
+  *event = CreateEvent(NULL, manual_reset ? TRUE : FALSE, initial_state ? TRUE : FALSE, NULL);
+  return (*event == NULL) ? AZ_ERROR_ULIB_SYSTEM : AZ_OK;
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event) { CloseHandle(*event); }
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event) { (void)SetEvent(*event); }
+
+void az_pal_os_event_reset(az_ulib_pal_os_event* event) { (void)ResetEvent(*event); }
+
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  return wait_for_object(*event, wait_option_ms);
+}
+
+uint64_t az_pal_os_get_time_ns(void)
+{
+  static LARGE_INTEGER frequency = { 0 };
+  LARGE_INTEGER counter;
+
+  if (frequency.QuadPart == 0)
+  {
+    (void)QueryPerformanceFrequency(&frequency);
+  }
+  (void)QueryPerformanceCounter(&counter);
+
+  /* Split the conversion to avoid overflow of the counter multiplied by 10^9. */
+  uint64_t count = (uint64_t)counter.QuadPart;
+  uint64_t rate = (uint64_t)frequency.QuadPart;
+  return ((count / rate) * 1000000000ULL) + (((count % rate) * 1000000000ULL) / rate);
+}
 
-void az_pal_os_lock_release(az_ulib_pal_os_lock* lock) { ReleaseSRWLockExclusive((SRWLOCK*)lock); }
+/* One tick is one millisecond. */
+uint32_t az_pal_os_get_ticks(void) { return (uint32_t)GetTickCount(); }
+
+uint32_t az_pal_os_get_ticks_per_second(void) { return 1000; }
 
 void az_pal_os_sleep(uint32_t sleep_time_ms) { Sleep(sleep_time_ms); }
 
@@ -61,3 +307,59 @@ az_result az_pal_os_thread_join(az_ulib_pal_thread_handle handle, int* res)
   CloseHandle(handle);
   return result;
 }
+
+/* The work queue is the system thread pool, so there is nothing to start or stop. */
+az_result az_pal_os_work_queue_init(void) { return AZ_OK; }
+
+void az_pal_os_work_queue_deinit(void) {}
+
+static VOID CALLBACK run_work(PTP_CALLBACK_INSTANCE instance, PVOID context, PTP_TIMER timer)
+{
+  az_ulib_pal_os_work* work = (az_ulib_pal_os_work*)context;
+  (void)instance;
+  (void)timer;
+
+  work->runner = GetCurrentThreadId();
+  work->function(work->context);
+  work->runner = 0;
+}
+
+az_result az_pal_os_work_init(
+    az_ulib_pal_os_work* work,
+    az_ulib_pal_os_work_function function,
+    void* context)
+{
+  work->function = function;
+  work->context = context;
+  work->runner = 0;
+  work->timer = CreateThreadpoolTimer(run_work, work, NULL);
+  return (work->timer == NULL) ? AZ_ERROR_ULIB_SYSTEM : AZ_OK;
+}
+
+void az_pal_os_work_deinit(az_ulib_pal_os_work* work)
+{
+  az_pal_os_work_cancel(work);
+  CloseThreadpoolTimer(work->timer);
+}
+
+az_result az_pal_os_work_schedule(az_ulib_pal_os_work* work, uint32_t delay_ms, uint32_t period_ms)
+{
+  /* A negative due time is relative to now, in units of 100 nanoseconds. */
+  ULARGE_INTEGER due;
+  FILETIME due_time;
+  due.QuadPart = (ULONGLONG)(-((LONGLONG)delay_ms * 10000));
+  due_time.dwLowDateTime = due.LowPart;
+  due_time.dwHighDateTime = due.HighPart;
+
+  SetThreadpoolTimer(work->timer, &due_time, (DWORD)period_ms, 0);
+  return AZ_OK;
+}
+
+void az_pal_os_work_cancel(az_ulib_pal_os_work* work)
+{
+  SetThreadpoolTimer(work->timer, NULL, 0, 0);
+  if (work->runner != GetCurrentThreadId())
+  {
+    WaitForThreadpoolTimerCallbacks(work->timer, TRUE);
+  }
+}
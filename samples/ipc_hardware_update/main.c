@@ -41,6 +41,13 @@ int main(void)
 
   (void)printf("Start ipc_call_interface sample.\r\n\r\n");
 
+  /* Start the work queue, it runs the periodic work of the packages. */
+  if ((result = az_pal_os_work_queue_init()) != AZ_OK)
+  {
+    (void)printf("Initialize work queue failed with code %" PRIi32 ".\r\n", result);
+    return 0;
+  }
+
   /* Start Registry. */
   az_ulib_registry_init(&registry_cb);
   az_ulib_registry_clean_all();
@@ -60,7 +67,7 @@ int main(void)
     contoso_display_200401_create();
     (void)printf("\r\n");
 
-    /* Consumer will use the display interface in a new thread. */
+    /* Consumer will use the display interface in a periodic work. */
     my_consumer_create();
     (void)printf("\r\n");
 
@@ -111,6 +118,7 @@ int main(void)
   }
 
   az_ulib_registry_deinit();
+  az_pal_os_work_queue_deinit();
 
   return 0;
 }
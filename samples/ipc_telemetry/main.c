@@ -40,6 +40,13 @@ int main(void)
 
   (void)printf("Start ipc_telemetry sample.\r\n\r\n");
 
+  /* Start the work queue, it runs the periodic work of the packages. */
+  if ((result = az_pal_os_work_queue_init()) != AZ_OK)
+  {
+    (void)printf("Initialize work queue failed with code %" PRIi32 ".\r\n", result);
+    return 0;
+  }
+
   /* Start Registry. */
   az_ulib_registry_init(&registry_cb);
   az_ulib_registry_clean_all();
@@ -56,7 +63,7 @@ int main(void)
   {
     /* Publish sensors.1 interface.
      * After this point anybody can subscribe for telemetries in sensors.1.
-     * To simulate sensors reading, sensor_v1i1 will spin a thread.
+     * To simulate sensors reading, sensor_v1i1 will schedule periodic work.
      */
     sensors_1_create();
     (void)printf("\r\n");
@@ -93,6 +100,7 @@ int main(void)
   }
 
   az_ulib_registry_deinit();
+  az_pal_os_work_queue_deinit();
 
   return 0;
 }
@@ -8,7 +8,6 @@
 #include "sensors_1_capabilities.h"
 #include "sensors_1_model.h"
 #include <inttypes.h>
-#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -30,51 +29,54 @@ typedef struct
 
 typedef struct
 {
-  bool end_thread;
-  az_ulib_pal_thread_handle temperature_thread;
+  az_ulib_pal_os_work temperature_work;
   subscription temperature_subscription;
   uint32_t temperature_interval;
-  az_ulib_pal_thread_handle accelerometer_thread;
+  az_ulib_pal_os_work accelerometer_work;
   subscription accelerometer_subscription;
   uint32_t accelerometer_interval;
 } sensor_1_cb;
 
-static sensor_1_cb cb = { .end_thread = false,
-                          .temperature_subscription = { 0 },
+static sensor_1_cb cb = { .temperature_subscription = { 0 },
                           .temperature_interval = 1000,
                           .accelerometer_subscription = { 0 },
                           .accelerometer_interval = 200 };
 
-static az_ulib_pal_thread_ret read_and_notify_temperature(az_ulib_pal_thread_args args)
+static void read_and_notify_temperature(void* context)
 {
-  (void)args;
-  while (!cb.end_thread)
-  {
-    (void)printf("Send temperature...\r\n");
-    if (cb.temperature_subscription.callback != NULL)
-    {
-      sensors_1_temperature_model_in in = { .t_c = 20 };
-      cb.temperature_subscription.callback(cb.temperature_subscription.context, &in);
-    }
-    az_pal_os_sleep(cb.temperature_interval);
-  }
-  return 0;
+  (void)context;
+  (void)printf("Send temperature...\r\n");
+  if (cb.temperature_subscription.callback != NULL)
+  {
+    sensors_1_temperature_model_in in = { .t_c = 20 };
+    cb.temperature_subscription.callback(cb.temperature_subscription.context, &in);
+  }
+}
+
+static void read_and_notify_accelerometer(void* context)
+{
+  (void)context;
+  (void)printf("Send accelerometer...\r\n");
+  if (cb.accelerometer_subscription.callback != NULL)
+  {
+    sensors_1_accelerometer_model_in in = { .x = 20, .y = 15, .z = 30 };
+    cb.accelerometer_subscription.callback(cb.accelerometer_subscription.context, &in);
+  }
 }
 
-static az_ulib_pal_thread_ret read_and_notify_accelerometer(az_ulib_pal_thread_args args)
+static az_result start_periodic_work(
+    az_ulib_pal_os_work* work,
+    az_ulib_pal_os_work_function function,
+    uint32_t interval)
 {
-  (void)args;
-  while (!cb.end_thread)
-  {
-    (void)printf("Send accelerometer...\r\n");
-    if (cb.accelerometer_subscription.callback != NULL)
-    {
-      sensors_1_accelerometer_model_in in = { .x = 20, .y = 15, .z = 30 };
-      cb.accelerometer_subscription.callback(cb.accelerometer_subscription.context, &in);
-    }
-    az_pal_os_sleep(cb.accelerometer_interval);
-  }
-  return 0;
+  AZ_ULIB_TRY
+  {
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_pal_os_work_init(work, function, NULL));
+    AZ_ULIB_THROW_IF_AZ_ERROR(az_pal_os_work_schedule(work, 0, interval));
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
 }
 
 static az_result sensors_1_subscribe_temperature_concrete(
@@ -154,6 +156,7 @@ static az_result sensors_1_temperature_interval_concrete(
   if (in != NULL)
   {
     cb.temperature_interval = *in;
+    (void)az_pal_os_work_schedule(&cb.temperature_work, *in, *in);
   }
 
   if (out != NULL)
@@ -171,6 +174,7 @@ static az_result sensors_1_accelerometer_interval_concrete(
   if (in != NULL)
   {
     cb.accelerometer_interval = *in;
+    (void)az_pal_os_work_schedule(&cb.accelerometer_work, *in, *in);
   }
 
   if (out != NULL)
@@ -196,25 +200,26 @@ void sensors_1_create(void)
     (void)printf("Interface sensors.1 published with success\r\n");
   }
 
-  if ((result = az_pal_os_thread_create(read_and_notify_temperature, NULL, &cb.temperature_thread))
+  if ((result = start_periodic_work(
+           &cb.temperature_work, read_and_notify_temperature, cb.temperature_interval))
       != AZ_OK)
   {
-    (void)printf("Notification thread for temperature failed with error %" PRIi32 "\r\n", result);
+    (void)printf("Notification work for temperature failed with error %" PRIi32 "\r\n", result);
   }
   else
   {
-    (void)printf("Notification thread for temperature started with success\r\n");
+    (void)printf("Notification work for temperature scheduled with success\r\n");
   }
 
-  if ((result
-       = az_pal_os_thread_create(read_and_notify_accelerometer, NULL, &cb.accelerometer_thread))
+  if ((result = start_periodic_work(
+           &cb.accelerometer_work, read_and_notify_accelerometer, cb.accelerometer_interval))
       != AZ_OK)
   {
-    (void)printf("Notification thread for accelerometer failed with error %" PRIi32 "\r\n", result);
+    (void)printf("Notification work for accelerometer failed with error %" PRIi32 "\r\n", result);
   }
   else
   {
-    (void)printf("Notification thread for accelerometer started with success\r\n");
+    (void)printf("Notification work for accelerometer scheduled with success\r\n");
   }
 }
 
@@ -222,9 +227,8 @@ void sensors_1_destroy(void)
 {
   az_result result;
 
-  cb.end_thread = true;
-  az_pal_os_thread_join(cb.temperature_thread, NULL);
-  az_pal_os_thread_join(cb.accelerometer_thread, NULL);
+  az_pal_os_work_deinit(&cb.temperature_work);
+  az_pal_os_work_deinit(&cb.accelerometer_work);
 
   if ((result = az_ulib_ipc_unpublish(&SENSORS_1_DESCRIPTOR, AZ_ULIB_WAIT_FOREVER)) != AZ_OK)
   {
@@ -4,6 +4,7 @@
 
 #include "az_ulib_result.h"
 #include "az_ulib_ustream.h"
+#include "az_ulib_ustream_pool.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -45,8 +46,9 @@ static az_result print_buffer(az_ulib_ustream* ustream)
  *      Content of ustream one: "Hello "
  *      Content of ustream two: "World"
  *      Content of concatenated ustream: "Hello World"
- * With both instances, the az_ulib_ustream lives on the stack while the control blocks use stdlib
- * malloc for allocation and stdlib free to free the memory.
+ * With both instances, the az_ulib_ustream lives on the stack while the control blocks come from
+ * the ustream pool, and return to it when the ustreams are disposed. The buffer of the second
+ * ustream uses stdlib malloc for allocation and stdlib free to free the memory.
  *
  * Steps followed:
  *      1) Create the first ustream for a buffer in static memory. Print the size of the ustream.
@@ -80,13 +82,12 @@ int main(void)
 
     // Create the first az_ulib_ustream from constant memory
     az_ulib_ustream ustream_one;
-    az_ulib_ustream_data_cb* ustream_control_block_one
-        = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+    az_ulib_ustream_data_cb* ustream_control_block_one = az_ulib_ustream_pool_alloc_data_cb();
     size_t ustream_size;
     if ((result = az_ulib_ustream_init(
              &ustream_one,
              ustream_control_block_one,
-             free,
+             az_ulib_ustream_pool_release_data_cb,
              (const uint8_t*)USTREAM_ONE_STRING,
              sizeof(USTREAM_ONE_STRING) - 1,
              NULL))
@@ -103,14 +104,13 @@ int main(void)
       (void)printf("Size of ustream_one: %zu\r\n", ustream_size);
 
       // Create the second az_ulib_ustream from the string in the heap, passing standard free
-      // function as release callback
+      // function as release callback for the data
       az_ulib_ustream ustream_two;
-      az_ulib_ustream_data_cb* ustream_control_block_two
-          = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+      az_ulib_ustream_data_cb* ustream_control_block_two = az_ulib_ustream_pool_alloc_data_cb();
       if ((result = az_ulib_ustream_init(
                &ustream_two,
                ustream_control_block_two,
-               free,
+               az_ulib_ustream_pool_release_data_cb,
                (const uint8_t*)ustream_two_string,
                ustream_two_string_len,
                free))
@@ -126,10 +126,13 @@ int main(void)
       {
         (void)printf("Size of ustream_two: %zu\r\n", ustream_size);
 
-        az_ulib_ustream_multi_data_cb* multi_data
-            = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+        az_ulib_ustream_multi_data_cb* multi_data = az_ulib_ustream_pool_alloc_multi_data_cb();
         // Concat the second az_ulib_ustream to the first az_ulib_ustream
-        if ((result = az_ulib_ustream_concat(&ustream_one, &ustream_two, multi_data, free))
+        if ((result = az_ulib_ustream_concat(
+                 &ustream_one,
+                 &ustream_two,
+                 multi_data,
+                 az_ulib_ustream_pool_release_multi_data_cb))
             != AZ_OK)
         {
           printf("Couldn't concat ustream_two to ustream_one\r\n");
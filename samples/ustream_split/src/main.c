@@ -4,6 +4,7 @@
 
 #include "az_ulib_result.h"
 #include "az_ulib_ustream.h"
+#include "az_ulib_ustream_pool.h"
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -53,13 +54,13 @@ int main(void)
   az_result result;
 
   az_ulib_ustream_data_cb* data_cb;
-  if ((data_cb = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb))) != NULL)
+  if ((data_cb = az_ulib_ustream_pool_alloc_data_cb()) != NULL)
   {
     az_ulib_ustream ustream_instance;
     if ((result = az_ulib_ustream_init(
              &ustream_instance,
              data_cb,
-             free,
+             az_ulib_ustream_pool_release_data_cb,
              (const uint8_t*)USTREAM_ONE_STRING,
              sizeof(USTREAM_ONE_STRING),
              NULL))
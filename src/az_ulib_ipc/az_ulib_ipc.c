@@ -151,13 +151,15 @@ static az_result try_lock_interface(_az_ulib_ipc_interface* ipc_interface)
   {
     result = AZ_ERROR_ITEM_NOT_FOUND;
   }
-  else if (ipc_interface->ref_count > AZ_ULIB_CONFIG_MAX_IPC_INSTANCES)
+  /* Other threads may share the IPC lock, so the reference is added atomically. */
+  else if (
+      AZ_ULIB_PORT_ATOMIC_INC_W(&ipc_interface->ref_count) > (AZ_ULIB_CONFIG_MAX_IPC_INSTANCES + 1))
   {
+    (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&ipc_interface->ref_count);
     result = AZ_ERROR_NOT_ENOUGH_SPACE;
   }
   else
   {
-    ipc_interface->ref_count++;
     result = AZ_OK;
   }
 
@@ -195,7 +197,12 @@ AZ_NODISCARD az_result az_ulib_ipc_init(az_ulib_ipc_control_block* ipc_control_b
   _az_ipc_control_block = ipc_control_block;
 
   // Prepare lock mechanism.
-  az_pal_os_lock_init(&(_az_ipc_control_block->_internal.lock));
+  if (az_pal_os_event_init(&(_az_ipc_control_block->_internal.released), true, false) != AZ_OK)
+  {
+    _az_ipc_control_block = NULL;
+    return AZ_ERROR_ULIB_SYSTEM;
+  }
+  az_pal_os_rwlock_init(&(_az_ipc_control_block->_internal.lock));
 
   // Random magic number. Just to avoid start from 0.
   _az_ipc_control_block->_internal.publish_count = 1;
@@ -353,8 +360,8 @@ static az_result update_interface_information_in_registry(_az_ulib_ipc_interface
               & AZ_ULIB_IPC_FLAGS_DEFAULT))
       {
         registry_data.flags = (ipc_interface->flags & AZ_ULIB_IPC_FLAGS_DEFAULT);
-        AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_registry_delete(interface_span));
-        AZ_ULIB_THROW_IF_AZ_ERROR(az_ulib_registry_add(interface_span, new_registry_data_span));
+        AZ_ULIB_THROW_IF_AZ_ERROR(
+            az_ulib_registry_update(interface_span, new_registry_data_span, NULL));
       }
     }
     else
@@ -395,80 +402,96 @@ AZ_NODISCARD az_result az_ulib_ipc_deinit(void)
   if (result == AZ_OK)
   {
     (void)unpublish_ipc_owned_interfaces();
-    az_pal_os_lock_deinit(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_rwlock_deinit(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_event_deinit(&(_az_ipc_control_block->_internal.released));
     _az_ipc_control_block = NULL;
   }
 
   return result;
 }
 
-AZ_NODISCARD az_result az_ulib_ipc_set_default(
+/* Shall be called with the IPC lock acquired in exclusive mode. */
+static az_result set_default_interface(
     az_span package_name,
     az_ulib_version package_version,
     az_span interface_name,
     az_ulib_version interface_version)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ipc_control_block);
-  _az_PRECONDITION_VALID_SPAN(package_name, 1, false);
-  _az_PRECONDITION_VALID_SPAN(interface_name, 1, false);
-
   az_result result;
   _az_ulib_ipc_interface* new_default_interface;
 
-  if ((package_version == AZ_ULIB_VERSION_DEFAULT)
-      || (interface_version == AZ_ULIB_VERSION_DEFAULT))
+  // Find the interface to be the new default.
+  if ((new_default_interface
+       = lookup_interface(package_name, package_version, interface_name, interface_version))
+      == NULL)
   {
-    // Do not allows any default in this function.
     result = AZ_ERROR_ITEM_NOT_FOUND;
   }
   else
   {
-    az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+    result = AZ_OK;
+    _az_ulib_ipc_interface* old_default_interface;
+    // Try to find the old default.
+    if ((old_default_interface = lookup_interface(
+             package_name, AZ_ULIB_VERSION_DEFAULT, interface_name, interface_version))
+        != NULL)
     {
-      // Find the interface to be the new default.
-      if ((new_default_interface
-           = lookup_interface(package_name, package_version, interface_name, interface_version))
-          == NULL)
+      if (old_default_interface == new_default_interface)
       {
-        result = AZ_ERROR_ITEM_NOT_FOUND;
+        result = AZ_ERROR_ARG;
       }
       else
       {
-        result = AZ_OK;
-        _az_ulib_ipc_interface* old_default_interface;
-        // Try to find the old default.
-        if ((old_default_interface = lookup_interface(
-                 package_name, AZ_ULIB_VERSION_DEFAULT, interface_name, interface_version))
-            != NULL)
-        {
-          if (old_default_interface == new_default_interface)
-          {
-            result = AZ_ERROR_ARG;
-          }
-          else
-          {
-            // Set as not default anymore.
-            old_default_interface->flags &= !AZ_ULIB_IPC_FLAGS_DEFAULT;
+        // Set as not default anymore.
+        old_default_interface->flags &= !AZ_ULIB_IPC_FLAGS_DEFAULT;
 
-            // Force all old handle to renew and get the new default.
-            old_default_interface->hash = (_az_ipc_control_block->_internal.publish_count++);
+        // Force all old handle to renew and get the new default.
+        old_default_interface->hash = (_az_ipc_control_block->_internal.publish_count++);
 
-            // Change default in registry.
-            result = update_interface_information_in_registry(old_default_interface);
-          }
-        }
+        // Change default in registry.
+        result = update_interface_information_in_registry(old_default_interface);
+      }
+    }
 
-        if (result == AZ_OK)
-        {
-          // Set new default interface.
-          new_default_interface->flags |= AZ_ULIB_IPC_FLAGS_DEFAULT;
+    if (result == AZ_OK)
+    {
+      // Set new default interface.
+      new_default_interface->flags |= AZ_ULIB_IPC_FLAGS_DEFAULT;
 
-          // Change default in registry.
-          result = update_interface_information_in_registry(new_default_interface);
-        }
-      }
+      // Change default in registry.
+      result = update_interface_information_in_registry(new_default_interface);
     }
-    az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ipc_set_default(
+    az_span package_name,
+    az_ulib_version package_version,
+    az_span interface_name,
+    az_ulib_version interface_version)
+{
+  _az_PRECONDITION_NOT_NULL(_az_ipc_control_block);
+  _az_PRECONDITION_VALID_SPAN(package_name, 1, false);
+  _az_PRECONDITION_VALID_SPAN(interface_name, 1, false);
+
+  az_result result;
+
+  if ((package_version == AZ_ULIB_VERSION_DEFAULT)
+      || (interface_version == AZ_ULIB_VERSION_DEFAULT))
+  {
+    // Do not allows any default in this function.
+    result = AZ_ERROR_ITEM_NOT_FOUND;
+  }
+  else
+  {
+    az_pal_os_rwlock_acquire_exclusive(&(_az_ipc_control_block->_internal.lock));
+    {
+      result = set_default_interface(
+          package_name, package_version, interface_name, interface_version);
+    }
+    az_pal_os_rwlock_release_exclusive(&(_az_ipc_control_block->_internal.lock));
   }
 
   return result;
@@ -491,7 +514,7 @@ az_ulib_ipc_publish(const az_ulib_interface_descriptor* const interface_descript
   }
   else
   {
-    az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_rwlock_acquire_exclusive(&(_az_ipc_control_block->_internal.lock));
     {
       if (lookup_interface(
               interface_descriptor->_internal.pkg_name,
@@ -524,7 +547,8 @@ az_ulib_ipc_publish(const az_ulib_interface_descriptor* const interface_descript
           {
             if (AZ_ULIB_FLAGS_IS_SET(registry_data.flags, AZ_ULIB_IPC_FLAGS_DEFAULT))
             {
-              result = az_ulib_ipc_set_default(
+              // The lock is already acquired, so do not call az_ulib_ipc_set_default().
+              result = set_default_interface(
                   interface_descriptor->_internal.pkg_name,
                   interface_descriptor->_internal.pkg_version,
                   interface_descriptor->_internal.intf_name,
@@ -554,7 +578,7 @@ az_ulib_ipc_publish(const az_ulib_interface_descriptor* const interface_descript
         }
       }
     }
-    az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_rwlock_release_exclusive(&(_az_ipc_control_block->_internal.lock));
   }
 
   return result;
@@ -569,11 +593,12 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
 
   az_result result;
 
-  // We are using a retry loop to wait for the interface to be free. A semaphore would
-  // probably be a better solution, however, our PAL does not support it yet. So, we will
-  // implement it in a separated Feature [10869774].
+  // The release of an interface on hold sets the released event. The event is shared by all
+  // interfaces, so a concurrent unpublish may reset it first; the wait is bounded by the retry
+  // interval to recheck the interface in this case. The timeout is measured by the monotonic clock.
+  uint64_t start_time_ns = az_pal_os_get_time_ns();
   uint32_t retry_interval;
-  uint32_t retry_total_time = 0;
+  uint32_t wait_interval = 0;
   if (wait_option_ms == AZ_ULIB_WAIT_FOREVER)
   {
     retry_interval = 100;
@@ -597,7 +622,12 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
   {
     do
     {
-      az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+      // Wait forever does not count the time.
+      uint64_t elapsed_ms = (wait_option_ms == AZ_ULIB_WAIT_FOREVER)
+          ? 0
+          : ((az_pal_os_get_time_ns() - start_time_ns) / 1000000);
+
+      az_pal_os_rwlock_acquire_exclusive(&(_az_ipc_control_block->_internal.lock));
       {
         if (release_interface->interface_descriptor != interface_descriptor)
         {
@@ -617,16 +647,15 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
             }
           }
           // Someone is using this interface.
-          else if (retry_total_time < wait_option_ms) // Shall keep waiting.
+          else if (elapsed_ms < wait_option_ms) // Shall keep waiting.
           {
-            if (wait_option_ms != AZ_ULIB_WAIT_FOREVER)
-            {
-              // It will not wait forever, so increment the waiting time.
-              retry_total_time += retry_interval;
-            }
             // Put this interface on hold, so try_get_interface will fail, it will give
             // this interface chance to be unpublished.
             release_interface->flags |= AZ_ULIB_IPC_FLAGS_ON_HOLD;
+            az_pal_os_event_reset(&(_az_ipc_control_block->_internal.released));
+            wait_interval = ((wait_option_ms - elapsed_ms) < retry_interval)
+                ? (uint32_t)(wait_option_ms - elapsed_ms)
+                : retry_interval;
             result = AZ_ULIB_PENDING;
           }
           else
@@ -637,13 +666,13 @@ AZ_NODISCARD az_result az_ulib_ipc_unpublish(
           }
         }
       }
-      az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+      az_pal_os_rwlock_release_exclusive(&(_az_ipc_control_block->_internal.lock));
 
       if (result == AZ_ULIB_PENDING)
       {
         // Give other threads chance to release this interface. It shall be outside of the
         // "lock".
-        az_pal_os_sleep(retry_interval);
+        (void)az_pal_os_event_wait(&(_az_ipc_control_block->_internal.released), wait_interval);
       }
 
     } while (result == AZ_ULIB_PENDING);
@@ -675,7 +704,7 @@ AZ_NODISCARD az_result az_ulib_ipc_try_get_interface(
   }
   else
   {
-    az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_rwlock_acquire_shared(&(_az_ipc_control_block->_internal.lock));
     {
       _az_ulib_ipc_interface* ipc_interface = interface_handle->_internal.ipc_interface;
 
@@ -705,7 +734,7 @@ AZ_NODISCARD az_result az_ulib_ipc_try_get_interface(
         }
       }
     }
-    az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+    az_pal_os_rwlock_release_shared(&(_az_ipc_control_block->_internal.lock));
   }
 
   return result;
@@ -739,11 +768,18 @@ AZ_NODISCARD az_result az_ulib_ipc_release_interface(az_ulib_ipc_interface_handl
 {
   _az_PRECONDITION_NOT_NULL(_az_ipc_control_block);
 
-  az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+  /* The shared lock keeps the unpublish away, other threads may release at the same time. */
+  az_pal_os_rwlock_acquire_shared(&(_az_ipc_control_block->_internal.lock));
   {
-    interface_handle._internal.ipc_interface->ref_count--;
+    _az_ulib_ipc_interface* ipc_interface = interface_handle._internal.ipc_interface;
+    if ((AZ_ULIB_PORT_ATOMIC_DEC_W(&ipc_interface->ref_count) == 1)
+        && AZ_ULIB_FLAGS_IS_SET(ipc_interface->flags, AZ_ULIB_IPC_FLAGS_ON_HOLD))
+    {
+      // The last user released the interface, wake up the unpublish.
+      az_pal_os_event_set(&(_az_ipc_control_block->_internal.released));
+    }
   }
-  az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+  az_pal_os_rwlock_release_shared(&(_az_ipc_control_block->_internal.lock));
 
   return AZ_OK;
 }
@@ -1030,7 +1066,7 @@ az_ulib_ipc_query(az_span query, az_span* result, uint32_t* continuation_token)
   _az_PRECONDITION_NOT_NULL(continuation_token);
   az_result res;
 
-  az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+  az_pal_os_rwlock_acquire_shared(&(_az_ipc_control_block->_internal.lock));
   {
     ipc_continuation_token* token = (ipc_continuation_token*)continuation_token;
 
@@ -1047,7 +1083,7 @@ az_ulib_ipc_query(az_span query, az_span* result, uint32_t* continuation_token)
       res = AZ_ERROR_NOT_SUPPORTED;
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+  az_pal_os_rwlock_release_shared(&(_az_ipc_control_block->_internal.lock));
 
   return res;
 }
@@ -1060,7 +1096,7 @@ AZ_NODISCARD az_result az_ulib_ipc_query_next(uint32_t* continuation_token, az_s
   _az_PRECONDITION_NOT_NULL(continuation_token);
   az_result res;
 
-  az_pal_os_lock_acquire(&(_az_ipc_control_block->_internal.lock));
+  az_pal_os_rwlock_acquire_shared(&(_az_ipc_control_block->_internal.lock));
   {
     ipc_continuation_token* token = (ipc_continuation_token*)continuation_token;
 
@@ -1073,7 +1109,7 @@ AZ_NODISCARD az_result az_ulib_ipc_query_next(uint32_t* continuation_token, az_s
       res = AZ_ERROR_NOT_SUPPORTED;
     }
   }
-  az_pal_os_lock_release(&(_az_ipc_control_block->_internal.lock));
+  az_pal_os_rwlock_release_shared(&(_az_ipc_control_block->_internal.lock));
 
   return res;
 }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "_az_ulib_pal_flash_driver.h"
+#include "az_ulib_config.h"
 #include "az_ulib_ipc_api.h"
 #include "az_ulib_ipc_function_table.h"
 #include "az_ulib_registry_api.h"
@@ -12,24 +13,26 @@
 #include <stdint.h>
 #include <string.h>
 
-/**
- * @brief   Registry single instance.
- *
- * Registry shall be singleton, so we need a static variable to handle the
- * single instance. This variable is initialized in the az_ulib_registry_init() function.
- */
-static const az_ulib_registry_control_block* _az_ulib_registry_cb = NULL;
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+#if (AZ_ULIB_CONFIG_REGISTRY_CACHE_NODE_BLOCKS < 1) \
+    || (AZ_ULIB_CONFIG_REGISTRY_CACHE_NODE_BLOCKS >= AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS)
+#error "The registry cache needs at least one block for the nodes, and one for the data."
+#endif
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
 
 /**
- * @brief   Registry lock to make APIs thread safe.
+ * @brief   Default registry instance.
+ *
+ * Instance used by the registry APIs that do not receive an instance. It is initialized in the
+ * az_ulib_registry_init() function.
  */
-static az_ulib_pal_os_lock registry_lock;
+static az_ulib_registry_instance default_registry;
 
 /**
  * @brief   Key value pair.
  *
  * Structure including two #az_span that each contains a pointer and a size for each key and
- * value to be stored in the flash. Used exclusively in #registry_node.
+ * value to be stored in the flash. Used exclusively in #registry_legacy_node.
  */
 typedef struct
 {
@@ -43,10 +46,11 @@ typedef struct
 } registry_key_value_ptrs;
 
 /**
- * @brief   Structure for the registry control node.
+ * @brief   Structure for the legacy registry control node.
  *
- * Every entry into the registry of the device will have a registry control node that contains
- * relevant information to restore the state of the registry after device power cycle.
+ * Registry control node used before the registry header was introduced. Its size and layout depend
+ * on the size of the pointers in the device. The registry can still read it, but new entries are
+ * always stored in a #registry_node.
  */
 typedef struct
 {
@@ -62,8 +66,119 @@ typedef struct
    * and size.*/
   registry_key_value_ptrs key_value;
 
+} registry_legacy_node;
+
+/**
+ * @brief   Structure for the registry control node.
+ *
+ * Every entry into the registry of the device will have a registry control node that contains
+ * relevant information to restore the state of the registry after device power cycle. The node
+ * does not store pointers, the key starts at `data_offset` bytes from the registry start, and the
+ * value follows the key in the next 64 bits boundary. So, the same registry image can be used by
+ * 32 and 64 bits systems.
+ */
+typedef struct _az_ulib_registry_node
+{
+  /** Two flags that shows the status of a node in the registry (ready, deleted). If both flags
+   * are set, the node is deleted and cannot be used again. */
+  uint64_t ready_flag;
+
+  /** Flag that shows the status of a node in the registry. If this flag is 0xFFFFFFFFFFFFFFFF, the
+   * data was not deleted anything else represents a deleted data. */
+  uint64_t delete_flag;
+
+  /** Offset of the key from the registry start in bytes. */
+  uint32_t data_offset;
+
+  /** Size of the key in bytes. If #REGISTRY_CHUNKED_KEY is set, the value is a list with the
+   * `uint32_t` index of each chunk node. A chunk node has no key, and its value is one piece of
+   * the value. */
+  uint16_t key_size;
+
+  /** Size of the value in bytes. */
+  uint16_t value_size;
+
 } registry_node;
 
+/**
+ * @brief   Structure for the registry header.
+ *
+ * The header is stored in the first 64 bits of the registry information, and identifies the
+ * format of the nodes that follow it. A registry without header uses #registry_legacy_node.
+ */
+typedef struct
+{
+  /** Header magic number, #REGISTRY_HEADER_MAGIC. */
+  uint32_t magic;
+
+  /** Version of the node format. */
+  uint16_t version;
+
+  /** Size of each node in bytes. */
+  uint16_t node_size;
+} registry_header;
+
+#define REGISTRY_HEADER_MAGIC 0x4752415A // "ZARG"
+#define REGISTRY_NODE_VERSION 1
+
+#define REGISTRY_CHUNKED_KEY 0x8000
+#define REGISTRY_KEY_SIZE_MASK 0x7FFF
+#define REGISTRY_MAX_CHUNK_SIZE UINT16_MAX
+
+/**
+ * @brief   Registry node formats.
+ */
+typedef enum
+{
+  /** Nodes with a header and #registry_node. */
+  REGISTRY_FORMAT_COMPACT,
+
+  /** Nodes without a header and #registry_legacy_node. Read only. */
+  REGISTRY_FORMAT_LEGACY,
+
+  /** Header with an unknown version, no node can be used. */
+  REGISTRY_FORMAT_UNKNOWN
+} registry_format;
+
+/**
+ * @brief   Structure for the registry checkpoint record.
+ *
+ * A checkpoint stores the registry cursors and counters, so the next init can resume from it
+ * instead of scanning all nodes. Records are appended in the checkpoint memory, and the last one
+ * with the ready flag set is the current checkpoint.
+ */
+typedef struct _az_ulib_registry_checkpoint
+{
+  /** Flag set after the whole record was written. */
+  uint64_t ready_flag;
+
+  /** Flag set when a registry entry was deleted after the checkpoint, so the counters in this
+   * record are not valid anymore. */
+  uint64_t stale_flag;
+
+  /** Number of registry nodes used, including deleted ones. */
+  uint32_t used_nodes;
+
+  /** Number of bytes used in the registry data, including deleted ones. */
+  uint32_t used_data;
+
+  /** Number of live registry nodes. */
+  uint32_t in_use_nodes;
+
+  /** Number of bytes used by live registry nodes. */
+  uint32_t in_use_data;
+} registry_checkpoint;
+
+/**
+ * @brief   Copy of a registry structure read from a flash that is not memory mapped.
+ */
+typedef union
+{
+  registry_node node;
+  registry_legacy_node legacy_node;
+  registry_checkpoint checkpoint;
+} registry_flash_buffer;
+
 #define AZ_ULIB_REGISTRY_FLAG_SIZE 8 // in bytes
 
 #define NUMBER_OF_64BITS(x) (x >> 3) + (((x & 0x7) == 0) ? 0 : 1)
@@ -74,315 +189,2547 @@ typedef struct
 #define REGISTRY_READY 0x0000000000000000
 #define REGISTRY_DELETED 0x0000000000000000
 
-static inline az_result set_registry_node_ready_flag(registry_node* address)
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+static inline bool is_external_flash(az_ulib_registry_instance* registry)
 {
-  return _az_ulib_pal_flash_driver_write_64(&(address->ready_flag), REGISTRY_READY);
+  return registry->_internal.control_block->external_flash;
 }
 
-static inline az_result set_registry_node_delete_flag(registry_node* address)
+/* Find the region of the registry memory that contains the address, so a cache block never reads
+ * out of it. */
+static bool get_flash_region(
+    az_ulib_registry_instance* registry,
+    const uint8_t* address,
+    const uint8_t** start,
+    const uint8_t** end)
 {
-  return _az_ulib_pal_flash_driver_write_64(&(address->delete_flag), REGISTRY_DELETED);
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  const void* regions[3][2]
+      = { { registry_cb->registry_info_start, registry_cb->registry_info_end },
+          { registry_cb->registry_start, registry_cb->registry_end },
+          { registry_cb->registry_checkpoint_start, registry_cb->registry_checkpoint_end } };
+
+  for (uint32_t index = 0; index < 3; index++)
+  {
+    if ((address >= (const uint8_t*)regions[index][0])
+        && (address < (const uint8_t*)regions[index][1]))
+    {
+      *start = (const uint8_t*)regions[index][0];
+      *end = (const uint8_t*)regions[index][1];
+      return true;
+    }
+  }
+
+  return false;
 }
 
-static bool is_empty_buf(uint8_t* test_buf, int32_t buf_size)
+/* Return the cache block with the address, replacing the least recently used one on a miss. Returns
+ * NULL if the address is out of the registry memory, or if the flash failed to read it.
+ *
+ * The first blocks only cache the nodes, and the others the keys, values and checkpoints. A lookup
+ * reads the nodes in sequence, so without this split each node it reads would evict the keys and
+ * values, and the other way around. */
+static _az_ulib_registry_cache_block*
+get_cache_block(az_ulib_registry_instance* registry, const uint8_t* address)
 {
-  while (buf_size > 3)
+  const uint8_t* region_start;
+  const uint8_t* region_end;
+  if (!get_flash_region(registry, address, &region_start, &region_end))
+  {
+    return NULL;
+  }
+
+  uint32_t first = 0;
+  uint32_t last = AZ_ULIB_CONFIG_REGISTRY_CACHE_NODE_BLOCKS;
+  if (region_start != (const uint8_t*)registry->_internal.control_block->registry_info_start)
+  {
+    first = AZ_ULIB_CONFIG_REGISTRY_CACHE_NODE_BLOCKS;
+    last = AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS;
+  }
+
+  _az_ulib_registry_cache_block* victim = &registry->_internal.cache.blocks[first];
+  uint32_t clock = ++registry->_internal.cache.clock;
+
+  for (uint32_t index = first; index < last; index++)
   {
-    if (*(uint32_t*)(test_buf) != 0xFFFFFFFF)
+    _az_ulib_registry_cache_block* block = &registry->_internal.cache.blocks[index];
+    if ((block->address != NULL) && (address >= block->address)
+        && (address < (block->address + block->size)))
     {
-      return false;
+      block->last_use = clock;
+      registry->_internal.cache.hit_count++;
+      return block;
+    }
+    if (block->last_use < victim->last_use)
+    {
+      victim = block;
     }
-    test_buf += 4;
-    buf_size -= 4;
   }
-  while ((buf_size--) > 0)
+
+  /* Blocks are aligned to the start of the region. */
+  const uint8_t* block_start = region_start
+      + (((size_t)(address - region_start) / AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE)
+         * AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE);
+  uint32_t block_size = ((region_end - block_start) < AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE)
+      ? (uint32_t)(region_end - block_start)
+      : AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE;
+
+  registry->_internal.cache.read_count++;
+  az_result result
+      = _az_ulib_pal_flash_driver_read(block_start, (uint8_t*)victim->data, block_size);
+  if (result != AZ_OK)
   {
-    // leftover, compare byte by byte
-    if (*(test_buf++) != 0xFF)
+    if (registry->_internal.cache.read_result == AZ_OK)
     {
-      return false;
+      registry->_internal.cache.read_result = result;
     }
+    victim->address = NULL;
+    victim->last_use = 0;
+    return NULL;
   }
 
-  return true;
+  victim->address = block_start;
+  victim->size = block_size;
+  victim->last_use = clock;
+  return victim;
 }
 
-static az_result store_registry_node(registry_node node, registry_node** node_ptr)
+/* Copy bytes from the flash to the RAM. Bytes that cannot be read are returned as 0x00, which the
+ * registry sees as deleted nodes, so it never writes over them. The error is kept for the API to
+ * return it, see take_read_result(). */
+static void read_from_flash(
+    az_ulib_registry_instance* registry,
+    const uint8_t* address,
+    uint8_t* buffer,
+    uint32_t size)
 {
-  AZ_ULIB_TRY
+  if (!is_external_flash(registry))
   {
-    registry_node* runner;
+    (void)memcpy(buffer, address, size);
+    return;
+  }
 
-    /* Look for next available spot */
-    for (runner = (registry_node*)_az_ulib_registry_cb->registry_info_start;
-         runner < (registry_node*)_az_ulib_registry_cb->registry_info_end;
-         runner++)
+  while (size > 0)
+  {
+    _az_ulib_registry_cache_block* block = get_cache_block(registry, address);
+    uint32_t chunk = size;
+    if (block == NULL)
+    {
+      (void)memset(buffer, 0x00, chunk);
+    }
+    else
     {
-      if (is_empty_buf((uint8_t*)(runner), sizeof(registry_node)))
+      uint32_t offset = (uint32_t)(address - block->address);
+      if (chunk > (block->size - offset))
       {
-        break;
+        chunk = block->size - offset;
       }
+      (void)memcpy(buffer, (uint8_t*)block->data + offset, chunk);
     }
+    address += chunk;
+    buffer += chunk;
+    size -= chunk;
+  }
+}
 
-    /* Handle case if all nodes were used */
-    AZ_ULIB_THROW_IF_ERROR(
-        (runner < (registry_node*)_az_ulib_registry_cb->registry_info_end),
-        AZ_ERROR_NOT_ENOUGH_SPACE);
-
-    /* Store az_span (pointer + size) to key value pair into flash. */
-    _az_ulib_pal_flash_driver_control_block key_value_cb;
-    AZ_ULIB_THROW_IF_AZ_ERROR(
-        _az_ulib_pal_flash_driver_open(&key_value_cb, (uint64_t*)&(runner->key_value)));
-    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
-        &key_value_cb, (uint8_t*)&(node.key_value), (uint32_t)sizeof(registry_key_value_ptrs)));
-    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&key_value_cb, 0x00));
+/* Return and clear the error of the first flash read that failed since the last call, or AZ_OK if
+ * all reads succeeded. */
+static inline az_result take_read_result(az_ulib_registry_instance* registry)
+{
+  az_result result = registry->_internal.cache.read_result;
+  registry->_internal.cache.read_result = AZ_OK;
+  return result;
+}
+#else
+/* Without the external flash support, the registry memory is always memory mapped. */
+static inline bool is_external_flash(az_ulib_registry_instance* registry)
+{
+  (void)registry;
+  return false;
+}
 
-    /* Return pointer to this node for setting flags later */
-    *node_ptr = runner;
-  }
-  AZ_ULIB_CATCH(...) {}
+static inline void read_from_flash(
+    az_ulib_registry_instance* registry,
+    const uint8_t* address,
+    uint8_t* buffer,
+    uint32_t size)
+{
+  (void)registry;
+  (void)memcpy(buffer, address, size);
+}
 
-  return AZ_ULIB_TRY_RESULT;
+static inline az_result take_read_result(az_ulib_registry_instance* registry)
+{
+  (void)registry;
+  return AZ_OK;
 }
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
 
-/* Find pointer to the next available space in flash to store registry key/value. */
-static uint64_t* get_start_registry_data_free_space()
+/* Return a pointer to read the flash. It is the flash itself if it is memory mapped, so there is
+ * no copy, or the buffer with a copy of the flash otherwise. */
+static inline const void* map_flash(
+    az_ulib_registry_instance* registry,
+    const void* address,
+    void* buffer,
+    uint32_t size)
 {
-  /* Find occupied node that has maximum address such that a new key-value pair can be stored. */
-  for (uint64_t* runner = (uint64_t*)_az_ulib_registry_cb->registry_end - 1;
-       runner >= (uint64_t*)_az_ulib_registry_cb->registry_start;
-       runner--)
+  if (!is_external_flash(registry))
   {
-    if (*runner != REGISTRY_FREE)
-    {
-      return runner + 1;
-    }
+    return address;
   }
 
-  return (uint64_t*)_az_ulib_registry_cb->registry_start;
+  read_from_flash(registry, (const uint8_t*)address, (uint8_t*)buffer, size);
+  return buffer;
 }
 
-static registry_node* find_node_in_registry(az_span key)
+static inline const registry_node* map_node(
+    az_ulib_registry_instance* registry,
+    const registry_node* node,
+    registry_flash_buffer* buffer)
 {
-  /* Loop through registry for entry that matches the key */
-  for (registry_node* runner = (registry_node*)_az_ulib_registry_cb->registry_info_start;
-       runner < (registry_node*)_az_ulib_registry_cb->registry_info_end;
-       runner++)
+  return (const registry_node*)map_flash(
+      registry, node, buffer, (uint32_t)registry->_internal.node_size);
+}
+
+static inline const registry_checkpoint* map_checkpoint(
+    az_ulib_registry_instance* registry,
+    const registry_checkpoint* checkpoint,
+    registry_flash_buffer* buffer)
+{
+  return (const registry_checkpoint*)map_flash(
+      registry, checkpoint, buffer, sizeof(registry_checkpoint));
+}
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+/* Drop the cached copy of a flash range that is about to change. */
+static void
+invalidate_cache(az_ulib_registry_instance* registry, const void* address, uint32_t size)
+{
+  const uint8_t* start = (const uint8_t*)address;
+
+  for (uint32_t index = 0; index < AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS; index++)
   {
-    if (runner->delete_flag == REGISTRY_FREE)
+    _az_ulib_registry_cache_block* block = &registry->_internal.cache.blocks[index];
+    if ((block->address != NULL) && (start < (block->address + block->size))
+        && ((start + size) > block->address))
     {
-      if (runner->ready_flag == REGISTRY_READY)
-      {
-        if (az_span_is_content_equal(key, runner->key_value.key))
-        {
-          return runner;
-        }
-      }
-      else if (runner->ready_flag == REGISTRY_FREE)
-      {
-        // Hit empty node entry, node, not found
-        return NULL;
-      }
+      block->address = NULL;
+      block->last_use = 0;
     }
   }
-
-  return NULL;
 }
 
-void az_ulib_registry_init(const az_ulib_registry_control_block* registry_cb)
+static void reset_cache(az_ulib_registry_instance* registry)
 {
-  _az_PRECONDITION_NOT_NULL(registry_cb);
-  _az_PRECONDITION_IS_NULL(_az_ulib_registry_cb);
-
-  /* Initialize the registry control block. */
-  _az_ulib_registry_cb = registry_cb;
+  for (uint32_t index = 0; index < AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCKS; index++)
+  {
+    registry->_internal.cache.blocks[index].address = NULL;
+    registry->_internal.cache.blocks[index].last_use = 0;
+  }
+}
 
-  /* Initialize lock */
-  az_pal_os_lock_init(&registry_lock);
+/* Empty the cache and clear its counters. */
+static void init_cache(az_ulib_registry_instance* registry)
+{
+  registry->_internal.cache.read_count = 0;
+  registry->_internal.cache.hit_count = 0;
+  registry->_internal.cache.read_result = AZ_OK;
+  reset_cache(registry);
 }
 
-void az_ulib_registry_deinit(void)
+static inline void get_cache_info(az_ulib_registry_instance* registry, az_ulib_registry_info* info)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
+  info->read_count = registry->_internal.cache.read_count;
+  info->cache_hit_count = registry->_internal.cache.hit_count;
+}
+#else
+static inline void
+invalidate_cache(az_ulib_registry_instance* registry, const void* address, uint32_t size)
+{
+  (void)registry;
+  (void)address;
+  (void)size;
+}
 
-  /* Deinitialize lock */
-  az_pal_os_lock_deinit(&registry_lock);
+static inline void reset_cache(az_ulib_registry_instance* registry) { (void)registry; }
 
-  /* Release the single instance. */
-  _az_ulib_registry_cb = NULL;
+static inline void init_cache(az_ulib_registry_instance* registry) { (void)registry; }
+
+static inline void get_cache_info(az_ulib_registry_instance* registry, az_ulib_registry_info* info)
+{
+  (void)registry;
+  info->read_count = 0;
+  info->cache_hit_count = 0;
 }
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
 
-AZ_NODISCARD az_result az_ulib_registry_delete(az_span key)
+static az_result
+write_64_to_flash(az_ulib_registry_instance* registry, uint64_t* destination_ptr, uint64_t value)
 {
-  /* Precondition check */
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
-  _az_PRECONDITION_VALID_SPAN(key, 1, false);
-  az_result result;
+  registry->_internal.write_count++;
+  invalidate_cache(registry, destination_ptr, sizeof(uint64_t));
+  return _az_ulib_pal_flash_driver_write_64(destination_ptr, value);
+}
 
-  az_pal_os_lock_acquire(&registry_lock);
+static bool is_empty_buf(const uint8_t* test_buf, int32_t buf_size)
+{
+  while (buf_size > 3)
   {
-    registry_node* matched_node = find_node_in_registry(key);
-    if (matched_node == NULL)
+    if (*(const uint32_t*)(test_buf) != 0xFFFFFFFF)
     {
-      /* Item not found in registry */
-      result = AZ_ERROR_ITEM_NOT_FOUND;
+      return false;
     }
-    else
+    test_buf += 4;
+    buf_size -= 4;
+  }
+  while ((buf_size--) > 0)
+  {
+    // leftover, compare byte by byte
+    if (*(test_buf++) != 0xFF)
     {
-      result = set_registry_node_delete_flag(matched_node);
+      return false;
     }
   }
-  az_pal_os_lock_release(&registry_lock);
-  return result;
+
+  return true;
 }
 
-AZ_NODISCARD az_result az_ulib_registry_try_get_value(az_span key, az_span* value)
+static bool
+is_flash_erased(az_ulib_registry_instance* registry, const uint8_t* address, uint32_t size)
 {
-  /* Precondition check */
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
-  _az_PRECONDITION_VALID_SPAN(key, 1, false);
-  _az_PRECONDITION_NOT_NULL(value);
-  az_result result;
+  if (!is_external_flash(registry))
+  {
+    return is_empty_buf(address, (int32_t)size);
+  }
 
-  az_pal_os_lock_acquire(&registry_lock);
+  uint64_t buffer[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE / sizeof(uint64_t)];
+  while (size > 0)
   {
-    registry_node* matched_node = find_node_in_registry(key);
-    if (matched_node == NULL)
-    {
-      result = AZ_ERROR_ITEM_NOT_FOUND;
-    }
-    else
+    uint32_t chunk = (size < sizeof(buffer)) ? size : (uint32_t)sizeof(buffer);
+    read_from_flash(registry, address, (uint8_t*)buffer, chunk);
+    if (!is_empty_buf((const uint8_t*)buffer, (int32_t)chunk))
     {
-      *value = matched_node->key_value.value;
-      result = AZ_OK;
+      return false;
     }
+    address += chunk;
+    size -= chunk;
   }
-  az_pal_os_lock_release(&registry_lock);
-  return result;
+  return true;
 }
 
-AZ_NODISCARD az_result az_ulib_registry_add(az_span key, az_span value)
+/* Erase the memory one page at a time, skipping the pages that are already erased. The driver may
+ * erase more than the requested bytes to keep the page alignment, so the chunks end at the page
+ * boundaries, and each page is erased only once even if the memory does not start at one. */
+static az_result
+erase_flash(az_ulib_registry_instance* registry, void* destination_ptr, uint32_t size)
 {
-  /* Precondition check */
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
-  _az_PRECONDITION_VALID_SPAN(key, 1, false);
-  _az_PRECONDITION_VALID_SPAN(value, 1, false);
-  az_result result;
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  uint32_t page_size = (registry_cb->page_size == 0) ? size : (uint32_t)registry_cb->page_size;
+  uint8_t* page = (uint8_t*)destination_ptr;
+  uint32_t page_offset
+      = (registry_cb->page_size == 0) ? 0 : (uint32_t)((uintptr_t)page % page_size);
+  az_result result = AZ_OK;
 
-  az_pal_os_lock_acquire(&registry_lock);
+  while ((size > 0) && (result == AZ_OK))
   {
-    AZ_ULIB_TRY
+    uint32_t chunk = ((size + page_offset) < page_size) ? size : (page_size - page_offset);
+    page_offset = 0;
+    if (!is_flash_erased(registry, page, chunk))
     {
-      registry_node new_node;
-      registry_node* new_node_ptr = NULL;
-      uint64_t* key_dest_ptr;
-      uint64_t* value_dest_ptr;
+      reset_cache(registry);
+      result = _az_ulib_pal_flash_driver_erase((uint64_t*)page, chunk);
+      if (result == AZ_OK)
+      {
+        registry->_internal.erase_count++;
+        if (registry_cb->erase_callback != NULL)
+        {
+          registry_cb->erase_callback(page, chunk);
+        }
+      }
+    }
+    page += chunk;
+    size -= chunk;
+  }
+
+  reset_cache(registry);
+  return result;
+}
 
-      /* Validate for duplicates before adding new entry */
-      AZ_ULIB_THROW_IF_ERROR((find_node_in_registry(key) == NULL), AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+static inline az_result
+set_registry_node_ready_flag(az_ulib_registry_instance* registry, registry_node* address)
+{
+  return write_64_to_flash(registry, &(address->ready_flag), REGISTRY_READY);
+}
+
+static inline az_result
+set_registry_node_delete_flag(az_ulib_registry_instance* registry, registry_node* address)
+{
+  return write_64_to_flash(registry, &(address->delete_flag), REGISTRY_DELETED);
+}
 
-      int32_t size_of_key_in_64_bits = NUMBER_OF_64BITS(az_span_size(key));
-      int32_t size_of_value_in_64_bits = NUMBER_OF_64BITS(az_span_size(value));
+static inline registry_node* get_next_node(az_ulib_registry_instance* registry, registry_node* node)
+{
+  return (registry_node*)((uint8_t*)node + registry->_internal.node_size);
+}
 
-      /* Find destination in flash buffer */
-      key_dest_ptr = get_start_registry_data_free_space();
-      value_dest_ptr = (uint64_t*)key_dest_ptr + size_of_key_in_64_bits;
+static inline registry_node* get_node(az_ulib_registry_instance* registry, uint32_t index)
+{
+  return (registry_node*)((uint8_t*)registry->_internal.first_node
+                          + (index * registry->_internal.node_size));
+}
 
-      /* Handle out of space scenario */
-      AZ_ULIB_THROW_IF_ERROR(
-          ((value_dest_ptr + size_of_value_in_64_bits)
-           <= (uint64_t*)(_az_ulib_registry_cb->registry_end)),
-          AZ_ERROR_OUT_OF_MEMORY);
+static inline uint32_t get_node_index(az_ulib_registry_instance* registry, registry_node* node)
+{
+  return (uint32_t)(
+      (size_t)((uint8_t*)node - (uint8_t*)registry->_internal.first_node)
+      / registry->_internal.node_size);
+}
 
-      /* Set free node information */
-      new_node.key_value.key = az_span_create((uint8_t*)key_dest_ptr, az_span_size(key));
-      new_node.key_value.value = az_span_create((uint8_t*)value_dest_ptr, az_span_size(value));
+/* The registry information may not be a multiple of the node size, the leftover is never used. */
+static inline registry_node* get_registry_info_end(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
 
-      /* Update registry node in flash */
-      AZ_ULIB_THROW_IF_AZ_ERROR(store_registry_node(new_node, &new_node_ptr));
+  if (registry->_internal.format == REGISTRY_FORMAT_UNKNOWN)
+  {
+    return registry->_internal.first_node;
+  }
 
-      /* Write key to flash */
-      _az_ulib_pal_flash_driver_control_block key_flash_cb;
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_open(&key_flash_cb, key_dest_ptr));
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
-          &key_flash_cb, az_span_ptr(key), (uint32_t)az_span_size(key)));
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&key_flash_cb, 0x00));
+  return get_node(
+      registry,
+      (uint32_t)(
+          (size_t)((uint8_t*)registry_cb->registry_info_end
+                   - (uint8_t*)registry->_internal.first_node)
+          / registry->_internal.node_size));
+}
 
-      /* Write value to flash */
-      _az_ulib_pal_flash_driver_control_block value_flash_cb;
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_open(&value_flash_cb, value_dest_ptr));
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
-          &value_flash_cb, az_span_ptr(value), (uint32_t)az_span_size(value)));
-      AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&value_flash_cb, 0x00));
+static inline az_span get_node_key(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  registry_flash_buffer buffer;
+  node = map_node(registry, node, &buffer);
 
-      /* After successful storage of registry node and actual key value pair, set flag in node to
-      indicate the entry is now ready to use.  */
-      AZ_ULIB_THROW_IF_AZ_ERROR(set_registry_node_ready_flag(new_node_ptr));
-    }
-    AZ_ULIB_CATCH(...) {}
-    result = AZ_ULIB_TRY_RESULT;
+  if (registry->_internal.format == REGISTRY_FORMAT_LEGACY)
+  {
+    return ((const registry_legacy_node*)node)->key_value.key;
   }
-  az_pal_os_lock_release(&registry_lock);
 
-  return result;
+  return az_span_create(
+      (uint8_t*)registry_cb->registry_start + node->data_offset,
+      (int32_t)(node->key_size & REGISTRY_KEY_SIZE_MASK));
 }
 
-void az_ulib_registry_clean_all(void)
+static inline az_span get_node_value(az_ulib_registry_instance* registry, const registry_node* node)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  registry_flash_buffer buffer;
+  node = map_node(registry, node, &buffer);
 
-  az_pal_os_lock_acquire(&registry_lock);
+  if (registry->_internal.format == REGISTRY_FORMAT_LEGACY)
   {
-    _az_ulib_pal_flash_driver_erase(
-      (uint64_t*)(_az_ulib_registry_cb->registry_info_start),
-      (uint32_t)((uint8_t*)(_az_ulib_registry_cb->registry_info_end) - (uint8_t*)(_az_ulib_registry_cb->registry_info_start)));
+    return ((const registry_legacy_node*)node)->key_value.value;
+  }
+
+  return az_span_create(
+      (uint8_t*)registry_cb->registry_start + node->data_offset
+          + (uint32_t)ROUND_UP_TO_64BITS((int32_t)(node->key_size & REGISTRY_KEY_SIZE_MASK)),
+      (int32_t)node->value_size);
+}
 
-    _az_ulib_pal_flash_driver_erase(
-        (uint64_t*)(_az_ulib_registry_cb->registry_start),
-        (uint32_t)((uint8_t*)(_az_ulib_registry_cb->registry_end) - (uint8_t*)(_az_ulib_registry_cb->registry_start)));
+static az_result store_registry_node(
+    az_ulib_registry_instance* registry,
+    registry_node* node,
+    registry_node* content)
+{
+  AZ_ULIB_TRY
+  {
+    /* Store offset and sizes of the key value pair into flash. */
+    registry->_internal.write_count++;
+    invalidate_cache(registry, node, sizeof(registry_node));
+    _az_ulib_pal_flash_driver_control_block key_value_cb;
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        _az_ulib_pal_flash_driver_open(&key_value_cb, (uint64_t*)&(node->data_offset)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
+        &key_value_cb,
+        (uint8_t*)&(content->data_offset),
+        (uint32_t)(sizeof(registry_node) - offsetof(registry_node, data_offset))));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&key_value_cb, 0x00));
   }
-  az_pal_os_lock_release(&registry_lock);
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
 }
 
-void az_ulib_registry_get_info(az_ulib_registry_info* info)
+/* Number of bytes that the key and value of a new node will use in the registry data. */
+static inline uint32_t get_content_data_size(const registry_node* content)
 {
-  _az_PRECONDITION_NOT_NULL(_az_ulib_registry_cb);
-  _az_PRECONDITION_NOT_NULL(info);
+  return (uint32_t)(
+      ROUND_UP_TO_64BITS((int32_t)(content->key_size & REGISTRY_KEY_SIZE_MASK))
+      + ROUND_UP_TO_64BITS((int32_t)content->value_size));
+}
 
-  az_pal_os_lock_acquire(&registry_lock);
-  {
+/* Number of bytes that the key and value of the node use in the registry data. */
+static uint32_t get_node_data_size(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  az_span value = get_node_value(registry, node);
+  return (uint32_t)(
+      (az_span_ptr(value) + ROUND_UP_TO_64BITS(az_span_size(value)))
+      - az_span_ptr(get_node_key(registry, node)));
+}
 
-    info->total_registry_info
-      = (size_t)((size_t)((uint8_t*)_az_ulib_registry_cb->registry_info_end - (uint8_t*)_az_ulib_registry_cb->registry_info_start) / sizeof(registry_node));
+/* A span in a torn node may be partially written, so it shall be checked before use. */
+static bool is_span_in_registry_data(az_ulib_registry_instance* registry, az_span span)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
 
-    info->total_registry_data
-        = (size_t)((uint8_t*)_az_ulib_registry_cb->registry_end - (uint8_t*)_az_ulib_registry_cb->registry_start);
+  uint8_t* ptr = az_span_ptr(span);
+  int32_t size = az_span_size(span);
 
-    info->free_registry_data
-        = (size_t)((uint8_t*)_az_ulib_registry_cb->registry_end - (uint8_t*)get_start_registry_data_free_space());
+  return (ptr >= (uint8_t*)registry_cb->registry_start)
+      && (ptr <= (uint8_t*)registry_cb->registry_end) && (size >= 0)
+      && (size <= ((uint8_t*)registry_cb->registry_end - ptr));
+}
 
-    info->free_registry_info = 0;
-    info->in_use_registry_info = 0;
-    info->in_use_registry_data = 0;
-    for (registry_node* runner = (registry_node*)_az_ulib_registry_cb->registry_info_start;
-         runner < (registry_node*)_az_ulib_registry_cb->registry_info_end;
-         runner++)
-    {
-      if (is_empty_buf((uint8_t*)(runner), sizeof(registry_node)))
-      {
-        info->free_registry_info++;
-      }
-      else
-      {
-        if ((runner->delete_flag == REGISTRY_FREE) && (runner->ready_flag == REGISTRY_READY))
-        {
-          info->in_use_registry_info++;
-          info->in_use_registry_data
-              += (size_t)(((az_span_ptr(runner->key_value.value) + ROUND_UP_TO_64BITS(az_span_size(runner->key_value.value))))
-                 - az_span_ptr(runner->key_value.key));
-        }
-      }
-    }
+/* The key and value of a torn node may point out of the registry data. */
+static bool is_node_data_valid(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  if (registry->_internal.format == REGISTRY_FORMAT_LEGACY)
+  {
+    return is_span_in_registry_data(registry, get_node_key(registry, node))
+        && is_span_in_registry_data(registry, get_node_value(registry, node));
   }
-  az_pal_os_lock_release(&registry_lock);
+
+  registry_flash_buffer buffer;
+  node = map_node(registry, node, &buffer);
+
+  uint64_t data_end = (uint64_t)node->data_offset
+      + (uint64_t)ROUND_UP_TO_64BITS((int32_t)(node->key_size & REGISTRY_KEY_SIZE_MASK))
+      + (uint64_t)node->value_size;
+  return data_end
+      <= (uint64_t)((uint8_t*)registry_cb->registry_end - (uint8_t*)registry_cb->registry_start);
+}
+
+/* A chunk node has no key, it is only reachable from the chunk list of a chunked entry. */
+static bool is_chunk_node(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  if (registry->_internal.format == REGISTRY_FORMAT_LEGACY)
+  {
+    return false;
+  }
+
+  registry_flash_buffer buffer;
+  return map_node(registry, node, &buffer)->key_size == 0;
+}
+
+static bool is_chunked_node(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  if (registry->_internal.format == REGISTRY_FORMAT_LEGACY)
+  {
+    return false;
+  }
+
+  registry_flash_buffer buffer;
+  return (map_node(registry, node, &buffer)->key_size & REGISTRY_CHUNKED_KEY) != 0;
+}
+
+static inline uint32_t
+get_chunk_count(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  return (uint32_t)az_span_size(get_node_value(registry, node)) / sizeof(uint32_t);
+}
+
+/* Return the node of a chunk, or NULL if the chunk list of a torn entry points to garbage. */
+static registry_node*
+get_chunk_node(az_ulib_registry_instance* registry, const registry_node* node, uint32_t chunk)
+{
+  uint32_t index;
+  read_from_flash(
+      registry,
+      az_span_ptr(get_node_value(registry, node)) + (chunk * sizeof(uint32_t)),
+      (uint8_t*)&index,
+      sizeof(uint32_t));
+
+  if (index >= get_node_index(registry, get_registry_info_end(registry)))
+  {
+    return NULL;
+  }
+
+  registry_node* chunk_node = get_node(registry, index);
+  return is_node_data_valid(registry, chunk_node) ? chunk_node : NULL;
+}
+
+/* Number of bytes in the value of an entry, including all of its chunks. */
+static uint32_t get_entry_value_size(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  if (!is_chunked_node(registry, node))
+  {
+    return (uint32_t)az_span_size(get_node_value(registry, node));
+  }
+
+  uint32_t size = 0;
+  uint32_t chunk_count = get_chunk_count(registry, node);
+  for (uint32_t chunk = 0; chunk < chunk_count; chunk++)
+  {
+    registry_node* chunk_node = get_chunk_node(registry, node, chunk);
+    if (chunk_node != NULL)
+    {
+      size += (uint32_t)az_span_size(get_node_value(registry, chunk_node));
+    }
+  }
+  return size;
+}
+
+/* Number of bytes that an entry uses in the registry data, including all of its chunks. */
+static uint32_t get_entry_data_size(az_ulib_registry_instance* registry, const registry_node* node)
+{
+  uint32_t size = get_node_data_size(registry, node);
+
+  if (is_chunked_node(registry, node))
+  {
+    uint32_t chunk_count = get_chunk_count(registry, node);
+    for (uint32_t chunk = 0; chunk < chunk_count; chunk++)
+    {
+      registry_node* chunk_node = get_chunk_node(registry, node, chunk);
+      if (chunk_node != NULL)
+      {
+        size += get_node_data_size(registry, chunk_node);
+      }
+    }
+  }
+  return size;
+}
+
+/* Copy \p size bytes of the value of an entry, starting at \p position, walking its chunks. */
+static void read_entry_value(
+    az_ulib_registry_instance* registry,
+    const registry_node* node,
+    uint32_t position,
+    uint8_t* buffer,
+    uint32_t size)
+{
+  if (!is_chunked_node(registry, node))
+  {
+    read_from_flash(registry, az_span_ptr(get_node_value(registry, node)) + position, buffer, size);
+    return;
+  }
+
+  uint32_t chunk_count = get_chunk_count(registry, node);
+  for (uint32_t chunk = 0; (chunk < chunk_count) && (size > 0); chunk++)
+  {
+    registry_node* chunk_node = get_chunk_node(registry, node, chunk);
+    az_span piece = (chunk_node == NULL) ? AZ_SPAN_EMPTY : get_node_value(registry, chunk_node);
+    uint32_t piece_size = (uint32_t)az_span_size(piece);
+
+    if (position >= piece_size)
+    {
+      position -= piece_size;
+    }
+    else
+    {
+      uint32_t copy_size = ((piece_size - position) < size) ? (piece_size - position) : size;
+      read_from_flash(registry, az_span_ptr(piece) + position, buffer, copy_size);
+      buffer += copy_size;
+      size -= copy_size;
+      position = 0;
+    }
+  }
+}
+
+static registry_checkpoint* find_latest_checkpoint(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  registry_checkpoint* latest = NULL;
+
+  for (registry_checkpoint* runner = (registry_checkpoint*)registry_cb->registry_checkpoint_start;
+       runner < (registry_checkpoint*)registry_cb->registry_checkpoint_end;
+       runner++)
+  {
+    registry_flash_buffer buffer;
+    const registry_checkpoint* record = map_checkpoint(registry, runner, &buffer);
+    if (is_empty_buf((const uint8_t*)record, sizeof(registry_checkpoint)))
+    {
+      break;
+    }
+    if (record->ready_flag == REGISTRY_READY)
+    {
+      latest = runner;
+    }
+  }
+
+  return latest;
+}
+
+static bool
+is_checkpoint_valid(az_ulib_registry_instance* registry, const registry_checkpoint* checkpoint)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  size_t total_nodes = get_node_index(registry, get_registry_info_end(registry));
+  size_t total_data
+      = (size_t)((uint8_t*)registry_cb->registry_end - (uint8_t*)registry_cb->registry_start);
+
+  if (checkpoint == NULL)
+  {
+    return false;
+  }
+
+  registry_flash_buffer buffer;
+  checkpoint = map_checkpoint(registry, checkpoint, &buffer);
+  return (checkpoint->stale_flag == REGISTRY_FREE)
+      && (checkpoint->used_nodes <= total_nodes) && (checkpoint->used_data <= total_data)
+      && (checkpoint->in_use_nodes <= checkpoint->used_nodes)
+      && (checkpoint->in_use_data <= checkpoint->used_data);
+}
+
+/* A checkpoint record can only be written once, so even after an invalidation the next record
+ * shall be the first empty one. */
+static registry_checkpoint* find_free_checkpoint(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  registry_checkpoint* runner = (registry_checkpoint*)registry_cb->registry_checkpoint_start;
+  registry_flash_buffer buffer;
+
+  while (((runner + 1) <= (registry_checkpoint*)registry_cb->registry_checkpoint_end)
+         && !is_empty_buf(
+             (const uint8_t*)map_checkpoint(registry, runner, &buffer),
+             sizeof(registry_checkpoint)))
+  {
+    runner++;
+  }
+
+  return runner;
+}
+
+static az_result write_checkpoint(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  AZ_ULIB_TRY
+  {
+    registry_checkpoint* runner = find_free_checkpoint(registry);
+
+    /* Start over when the checkpoint memory is full. */
+    if ((runner + 1) > (registry_checkpoint*)registry_cb->registry_checkpoint_end)
+    {
+      registry->_internal.checkpoint = NULL;
+      runner = (registry_checkpoint*)registry_cb->registry_checkpoint_start;
+      AZ_ULIB_THROW_IF_AZ_ERROR(erase_flash(
+          registry,
+          runner,
+          (uint32_t)((uint8_t*)registry_cb->registry_checkpoint_end - (uint8_t*)runner)));
+    }
+
+    registry_checkpoint record
+        = { .ready_flag = REGISTRY_FREE,
+            .stale_flag = REGISTRY_FREE,
+            .used_nodes = get_node_index(registry, registry->_internal.free_node),
+            .used_data
+            = (uint32_t)(registry->_internal.free_data - (uint8_t*)registry_cb->registry_start),
+            .in_use_nodes = registry->_internal.in_use_nodes,
+            .in_use_data = registry->_internal.in_use_data };
+
+    /* Write the counters first, and set the ready flag only after all of them are in the flash. */
+    registry->_internal.write_count++;
+    invalidate_cache(registry, runner, sizeof(registry_checkpoint));
+    _az_ulib_pal_flash_driver_control_block checkpoint_cb;
+    AZ_ULIB_THROW_IF_AZ_ERROR(
+        _az_ulib_pal_flash_driver_open(&checkpoint_cb, (uint64_t*)&(runner->used_nodes)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
+        &checkpoint_cb,
+        (uint8_t*)&(record.used_nodes),
+        (uint32_t)(sizeof(registry_checkpoint) - offsetof(registry_checkpoint, used_nodes))));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&checkpoint_cb, 0x00));
+    AZ_ULIB_THROW_IF_AZ_ERROR(write_64_to_flash(registry, &(runner->ready_flag), REGISTRY_READY));
+
+    registry->_internal.checkpoint = runner;
+    registry->_internal.adds_since_checkpoint = 0;
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* The counters in the checkpoint do not include deletes, so the checkpoint cannot be used after
+ * one. It shall be invalidated before the delete flag is set, so a power failure between the two
+ * never leaves a valid checkpoint that counts a deleted entry. */
+static void invalidate_checkpoint(az_ulib_registry_instance* registry)
+{
+  if (registry->_internal.checkpoint != NULL)
+  {
+    (void)write_64_to_flash(
+        registry, &(registry->_internal.checkpoint->stale_flag), REGISTRY_DELETED);
+    registry->_internal.checkpoint = NULL;
+  }
+}
+
+/* Compare the keys of two nodes in the flash, reading them in chunks if needed. */
+static bool is_node_key_equal(
+    az_ulib_registry_instance* registry,
+    const registry_node* node,
+    const registry_node* other)
+{
+  az_span key = get_node_key(registry, node);
+  az_span other_key = get_node_key(registry, other);
+
+  if (az_span_size(key) != az_span_size(other_key))
+  {
+    return false;
+  }
+
+  uint8_t chunk[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE];
+  uint8_t other_chunk[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE];
+  for (int32_t offset = 0; offset < az_span_size(key); offset += (int32_t)sizeof(chunk))
+  {
+    int32_t size = az_span_size(key) - offset;
+    if (size > (int32_t)sizeof(chunk))
+    {
+      size = (int32_t)sizeof(chunk);
+    }
+    read_from_flash(registry, az_span_ptr(key) + offset, chunk, (uint32_t)size);
+    read_from_flash(registry, az_span_ptr(other_key) + offset, other_chunk, (uint32_t)size);
+    if (memcmp(chunk, other_chunk, (size_t)size) != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* Return the last entry added to the registry after the first node that was not deleted, or NULL if
+ * there is none. */
+static registry_node*
+find_last_registry_entry(az_ulib_registry_instance* registry, registry_node* first_node)
+{
+  registry_node* runner = registry->_internal.free_node;
+  while (runner > first_node)
+  {
+    runner = (registry_node*)((uint8_t*)runner - registry->_internal.node_size);
+    registry_flash_buffer buffer;
+    const registry_node* content = map_node(registry, runner, &buffer);
+    if ((content->delete_flag == REGISTRY_FREE) && (content->ready_flag == REGISTRY_READY)
+        && !is_chunk_node(registry, runner))
+    {
+      return runner;
+    }
+  }
+
+  return NULL;
+}
+
+/* An update stores the new entry before it deletes the old one. A power failure between the two
+ * leaves the key twice in the registry, with the new value in the last entry added. Delete the old
+ * entry, so lookups find the new value.
+ *
+ * An update only counts its new entry for the next checkpoint after the delete, so a checkpoint
+ * never lands between the two. If no live entry was added after the checkpoint node, there is no
+ * torn update, and the nodes before it are not read. */
+static void recover_torn_update(az_ulib_registry_instance* registry, registry_node* checkpoint_node)
+{
+  registry_node* last_entry = find_last_registry_entry(registry, checkpoint_node);
+  if ((last_entry == NULL) || !is_node_data_valid(registry, last_entry))
+  {
+    return;
+  }
+
+  for (registry_node* runner = registry->_internal.first_node; runner < last_entry;
+       runner = get_next_node(registry, runner))
+  {
+    registry_flash_buffer buffer;
+    const registry_node* content = map_node(registry, runner, &buffer);
+    if ((content->delete_flag == REGISTRY_FREE) && (content->ready_flag == REGISTRY_READY)
+        && !is_chunk_node(registry, runner) && is_node_data_valid(registry, runner)
+        && is_node_key_equal(registry, runner, last_entry))
+    {
+      invalidate_checkpoint(registry);
+      if (set_registry_node_delete_flag(registry, runner) == AZ_OK)
+      {
+        registry->_internal.in_use_nodes--;
+        registry->_internal.in_use_data -= get_entry_data_size(registry, runner);
+      }
+      return;
+    }
+  }
+}
+
+/* Validate all nodes from the runner up to the first free one, updating the registry state. Torn
+ * nodes, where the ready flag was never set, are marked as deleted. */
+static void recover_registry_nodes(az_ulib_registry_instance* registry, registry_node* runner)
+{
+  for (; runner < get_registry_info_end(registry); runner = get_next_node(registry, runner))
+  {
+    registry_flash_buffer buffer;
+    const registry_node* content = map_node(registry, runner, &buffer);
+    if (is_empty_buf((const uint8_t*)content, (int32_t)registry->_internal.node_size))
+    {
+      break;
+    }
+
+    /* The data of the node may be partially written, but it is still in use. */
+    if (is_node_data_valid(registry, runner))
+    {
+      az_span value = get_node_value(registry, runner);
+      uint8_t* data_end = az_span_ptr(value) + ROUND_UP_TO_64BITS(az_span_size(value));
+      if (data_end > registry->_internal.free_data)
+      {
+        registry->_internal.free_data = data_end;
+      }
+    }
+
+    if (content->delete_flag == REGISTRY_FREE)
+    {
+      if (content->ready_flag == REGISTRY_READY)
+      {
+        /* Chunks are counted with the entry that owns them. */
+        if (!is_chunk_node(registry, runner))
+        {
+          registry->_internal.in_use_nodes++;
+          registry->_internal.in_use_data += get_entry_data_size(registry, runner);
+        }
+      }
+      else
+      {
+        (void)set_registry_node_delete_flag(registry, runner);
+      }
+    }
+  }
+
+  registry->_internal.free_node = runner;
+}
+
+/* Identify the format of the nodes from the registry header. An empty registry is formatted with
+ * the current version. */
+static void recover_registry_format(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+  uint8_t* info_start = (uint8_t*)registry_cb->registry_info_start;
+  registry_flash_buffer buffer;
+  const registry_header* header = (const registry_header*)map_flash(
+      registry, info_start, &buffer, sizeof(registry_legacy_node));
+
+  registry->_internal.format = REGISTRY_FORMAT_COMPACT;
+  registry->_internal.first_node = (registry_node*)(info_start + sizeof(uint64_t));
+  registry->_internal.node_size = sizeof(registry_node);
+
+  if (header->magic == REGISTRY_HEADER_MAGIC)
+  {
+    if ((header->version != REGISTRY_NODE_VERSION) || (header->node_size != sizeof(registry_node)))
+    {
+      registry->_internal.format = REGISTRY_FORMAT_UNKNOWN;
+    }
+  }
+  else if (is_empty_buf((const uint8_t*)header, sizeof(registry_legacy_node)))
+  {
+    union
+    {
+      registry_header header;
+      uint64_t uint64;
+    } new_header = { .header = { .magic = REGISTRY_HEADER_MAGIC,
+                                 .version = REGISTRY_NODE_VERSION,
+                                 .node_size = (uint16_t)sizeof(registry_node) } };
+    (void)write_64_to_flash(registry, (uint64_t*)info_start, new_header.uint64);
+  }
+  else
+  {
+    /* Registry written before the header was introduced. */
+    registry->_internal.format = REGISTRY_FORMAT_LEGACY;
+    registry->_internal.first_node = (registry_node*)info_start;
+    registry->_internal.node_size = sizeof(registry_legacy_node);
+  }
+}
+
+static void recover_registry(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  recover_registry_format(registry);
+
+  registry_node* runner = registry->_internal.first_node;
+
+  registry->_internal.free_data = (uint8_t*)registry_cb->registry_start;
+  registry->_internal.in_use_nodes = 0;
+  registry->_internal.in_use_data = 0;
+  registry->_internal.adds_since_checkpoint = 0;
+  registry->_internal.checkpoint = NULL;
+
+  if (registry_cb->registry_checkpoint_start != NULL)
+  {
+    registry_checkpoint* checkpoint = find_latest_checkpoint(registry);
+    if (is_checkpoint_valid(registry, checkpoint))
+    {
+      /* Resume from the checkpoint, only the nodes added after it need to be validated. */
+      registry_flash_buffer buffer;
+      const registry_checkpoint* record = map_checkpoint(registry, checkpoint, &buffer);
+      registry->_internal.checkpoint = checkpoint;
+      registry->_internal.free_data = (uint8_t*)registry_cb->registry_start + record->used_data;
+      registry->_internal.in_use_nodes = record->in_use_nodes;
+      registry->_internal.in_use_data = record->in_use_data;
+      runner = get_node(registry, record->used_nodes);
+    }
+  }
+
+  registry_node* checkpoint_node = runner;
+  recover_registry_nodes(registry, runner);
+  recover_torn_update(registry, checkpoint_node);
+
+  /* Store a new checkpoint if anything changed, so the next init will not repeat the scan. */
+  if ((registry_cb->registry_checkpoint_start != NULL)
+      && ((registry->_internal.checkpoint == NULL)
+          || (registry->_internal.free_node != checkpoint_node)))
+  {
+    (void)write_checkpoint(registry);
+  }
+}
+
+/* Lookups run without the registry lock. Writers, holding the lock, increment the sequence before
+ * and after any change that can invalidate an entry that a lookup may be reading, so it is odd
+ * while the change is in progress. A lookup is only valid if the sequence was even and did not
+ * change during the lookup. New entries do not need it, because they are only visible after the
+ * ready flag is set. */
+static inline void begin_registry_change(az_ulib_registry_instance* registry)
+{
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&registry->_internal.sequence);
+}
+
+static inline void end_registry_change(az_ulib_registry_instance* registry)
+{
+  (void)AZ_ULIB_PORT_ATOMIC_INC_W(&registry->_internal.sequence);
+}
+
+/* Compare a span in the flash with a span in memory, reading the flash in chunks if needed. */
+static bool is_flash_content_equal(
+    az_ulib_registry_instance* registry,
+    az_span flash_span,
+    az_span span)
+{
+  if (!is_external_flash(registry))
+  {
+    return az_span_is_content_equal(flash_span, span);
+  }
+
+  if (az_span_size(flash_span) != az_span_size(span))
+  {
+    return false;
+  }
+
+  uint8_t chunk[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE];
+  for (int32_t offset = 0; offset < az_span_size(span); offset += (int32_t)sizeof(chunk))
+  {
+    int32_t size = az_span_size(span) - offset;
+    if (size > (int32_t)sizeof(chunk))
+    {
+      size = (int32_t)sizeof(chunk);
+    }
+    read_from_flash(registry, az_span_ptr(flash_span) + offset, chunk, (uint32_t)size);
+    if (memcmp(chunk, az_span_ptr(span) + offset, (size_t)size) != 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static registry_node* find_node_in_registry(az_ulib_registry_instance* registry, az_span key)
+{
+  /* Loop through registry for entry that matches the key */
+  for (registry_node* runner = registry->_internal.first_node;
+       runner < get_registry_info_end(registry);
+       runner = get_next_node(registry, runner))
+  {
+    registry_flash_buffer buffer;
+    const registry_node* content = map_node(registry, runner, &buffer);
+    if (content->delete_flag == REGISTRY_FREE)
+    {
+      if (content->ready_flag == REGISTRY_READY)
+      {
+        /* A lookup without the lock may see a node in the middle of an erase. */
+        if (is_node_data_valid(registry, runner)
+            && is_flash_content_equal(registry, get_node_key(registry, runner), key))
+        {
+          return runner;
+        }
+      }
+      else if (content->ready_flag == REGISTRY_FREE)
+      {
+        // Hit empty node entry, node, not found
+        return NULL;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+static az_result write_span_to_flash(
+    az_ulib_registry_instance* registry,
+    uint64_t* destination_ptr,
+    az_span source)
+{
+  AZ_ULIB_TRY
+  {
+    registry->_internal.write_count++;
+    invalidate_cache(registry, destination_ptr, (uint32_t)az_span_size(source));
+    _az_ulib_pal_flash_driver_control_block flash_cb;
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_open(&flash_cb, destination_ptr));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_write(
+        &flash_cb, az_span_ptr(source), (uint32_t)az_span_size(source)));
+    AZ_ULIB_THROW_IF_AZ_ERROR(_az_ulib_pal_flash_driver_close(&flash_cb, 0x00));
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* Reserve a node and the registry data for a new key value pair. */
+static az_result reserve_registry_entry(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span value,
+    registry_node** node_ptr,
+    registry_node* content)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  AZ_ULIB_TRY
+  {
+    uint64_t* key_dest_ptr;
+    uint64_t* value_dest_ptr;
+
+    /* Only the current format can receive new entries. */
+    AZ_ULIB_THROW_IF_ERROR(
+        (registry->_internal.format == REGISTRY_FORMAT_COMPACT),
+        AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+    AZ_ULIB_THROW_IF_ERROR(
+        ((az_span_size(key) <= REGISTRY_KEY_SIZE_MASK)
+         && (az_span_size(value) <= REGISTRY_MAX_CHUNK_SIZE)),
+        AZ_ERROR_NOT_SUPPORTED);
+
+    int32_t size_of_key_in_64_bits = NUMBER_OF_64BITS(az_span_size(key));
+    int32_t size_of_value_in_64_bits = NUMBER_OF_64BITS(az_span_size(value));
+
+    /* Find destination in flash buffer */
+    key_dest_ptr = (uint64_t*)registry->_internal.free_data;
+    value_dest_ptr = (uint64_t*)key_dest_ptr + size_of_key_in_64_bits;
+
+    /* Handle out of space scenario */
+    AZ_ULIB_THROW_IF_ERROR(
+        ((value_dest_ptr + size_of_value_in_64_bits) <= (uint64_t*)(registry_cb->registry_end)),
+        AZ_ERROR_OUT_OF_MEMORY);
+
+    /* Handle case if all nodes were used */
+    AZ_ULIB_THROW_IF_ERROR(
+        (registry->_internal.free_node < get_registry_info_end(registry)),
+        AZ_ERROR_NOT_ENOUGH_SPACE);
+
+    /* Set free node information */
+    content->data_offset
+        = (uint32_t)((uint8_t*)key_dest_ptr - (uint8_t*)registry_cb->registry_start);
+    content->key_size = (uint16_t)az_span_size(key);
+    content->value_size = (uint16_t)az_span_size(value);
+
+    /* From this point, the node and the data are not free anymore, even if the write fails. */
+    *node_ptr = registry->_internal.free_node;
+    registry->_internal.free_node = get_next_node(registry, registry->_internal.free_node);
+    registry->_internal.free_data = (uint8_t*)(value_dest_ptr + size_of_value_in_64_bits);
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* Write a reserved entry to the flash. */
+static az_result commit_registry_entry(
+    az_ulib_registry_instance* registry,
+    registry_node* node,
+    registry_node* content,
+    az_span key,
+    az_span value)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  AZ_ULIB_TRY
+  {
+    uint8_t* key_dest_ptr = (uint8_t*)registry_cb->registry_start + content->data_offset;
+
+    /* Update registry node in flash */
+    AZ_ULIB_THROW_IF_AZ_ERROR(store_registry_node(registry, node, content));
+
+    /* Write key and value to flash, chunk nodes have no key. */
+    if (az_span_size(key) > 0)
+    {
+      AZ_ULIB_THROW_IF_AZ_ERROR(write_span_to_flash(registry, (uint64_t*)key_dest_ptr, key));
+    }
+    AZ_ULIB_THROW_IF_AZ_ERROR(write_span_to_flash(
+        registry, (uint64_t*)(key_dest_ptr + ROUND_UP_TO_64BITS(az_span_size(key))), value));
+
+    /* After successful storage of registry node and actual key value pair, set flag in node to
+    indicate the entry is now ready to use.  */
+    AZ_ULIB_THROW_IF_AZ_ERROR(set_registry_node_ready_flag(registry, node));
+  }
+  AZ_ULIB_CATCH(...)
+  {
+    /* Do not leave a torn node behind. */
+    (void)set_registry_node_delete_flag(registry, node);
+  }
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* A checkpoint shall only count entries that are in the flash, so it waits for an empty queue. */
+static void count_added_entry(az_ulib_registry_instance* registry)
+{
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  if ((registry_cb->registry_checkpoint_start != NULL)
+      && (++registry->_internal.adds_since_checkpoint
+          >= AZ_ULIB_CONFIG_REGISTRY_CHECKPOINT_INTERVAL)
+      && (registry->_internal.pending == 0))
+  {
+    /* A failure to store the checkpoint does not affect the new entry. */
+    (void)write_checkpoint(registry);
+  }
+}
+
+/* Store a new key value pair in the registry, without counting it for the next checkpoint. This
+ * function does not check for duplicates. */
+static az_result
+store_registry_entry(az_ulib_registry_instance* registry, az_span key, az_span value)
+{
+  AZ_ULIB_TRY
+  {
+    registry_node* node;
+    registry_node content;
+
+    AZ_ULIB_THROW_IF_AZ_ERROR(reserve_registry_entry(registry, key, value, &node, &content));
+    AZ_ULIB_THROW_IF_AZ_ERROR(commit_registry_entry(registry, node, &content, key, value));
+
+    registry->_internal.in_use_nodes++;
+    registry->_internal.in_use_data += get_content_data_size(&content);
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* Store a new key value pair in the registry. This function does not check for duplicates. */
+static az_result
+add_registry_entry(az_ulib_registry_instance* registry, az_span key, az_span value)
+{
+  az_result result = store_registry_entry(registry, key, value);
+  if (result == AZ_OK)
+  {
+    count_added_entry(registry);
+  }
+
+  return result;
+}
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+static inline az_span get_queue_entry_key(
+    az_ulib_registry_instance* registry,
+    const _az_ulib_registry_queue_entry* entry)
+{
+  return az_span_create(
+      (uint8_t*)registry->_internal.queue.buffer + entry->buffer_offset, (int32_t)entry->key_size);
+}
+
+static inline az_span get_queue_entry_value(
+    az_ulib_registry_instance* registry,
+    const _az_ulib_registry_queue_entry* entry)
+{
+  return az_span_create(
+      (uint8_t*)registry->_internal.queue.buffer + entry->buffer_offset
+          + ROUND_UP_TO_64BITS((int32_t)entry->key_size),
+      (int32_t)entry->value_size);
+}
+
+/* Look for a key in the entries that are not in the flash yet. */
+static _az_ulib_registry_queue_entry*
+find_entry_in_queue(az_ulib_registry_instance* registry, az_span key)
+{
+  for (uint32_t index = registry->_internal.queue.committed;
+       index < registry->_internal.queue.queued;
+       index++)
+  {
+    _az_ulib_registry_queue_entry* entry = &registry->_internal.queue.entries[index];
+    if (az_span_is_content_equal(key, get_queue_entry_key(registry, entry)))
+    {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+/* Store the oldest queued entry in the flash, returns AZ_ULIB_EOF if there is nothing to store. */
+static az_result commit_next_queue_entry(az_ulib_registry_instance* registry)
+{
+  if (registry->_internal.queue.committed == registry->_internal.queue.queued)
+  {
+    return AZ_ULIB_EOF;
+  }
+
+  _az_ulib_registry_queue_entry* entry
+      = &registry->_internal.queue.entries[registry->_internal.queue.committed];
+  registry_node content = { .data_offset = entry->data_offset,
+                            .key_size = entry->key_size,
+                            .value_size = entry->value_size };
+  az_result result = commit_registry_entry(
+      registry,
+      entry->node,
+      &content,
+      get_queue_entry_key(registry, entry),
+      get_queue_entry_value(registry, entry));
+  registry->_internal.queue.committed++;
+  (void)AZ_ULIB_PORT_ATOMIC_DEC_W(&registry->_internal.pending);
+
+  if (result == AZ_OK)
+  {
+    count_added_entry(registry);
+  }
+  else
+  {
+    /* The entry was visible from the queue, but it is not in the registry anymore. */
+    registry->_internal.in_use_nodes--;
+    registry->_internal.in_use_data -= get_content_data_size(&content);
+    if (registry->_internal.queue.error == AZ_OK)
+    {
+      registry->_internal.queue.error = result;
+    }
+  }
+
+  return result;
+}
+
+/* Store all queued entries in the flash and release the queue buffer. */
+static void drain_registry_queue(az_ulib_registry_instance* registry)
+{
+  while (commit_next_queue_entry(registry) != AZ_ULIB_EOF)
+  {
+  }
+
+  registry->_internal.queue.queued = 0;
+  registry->_internal.queue.committed = 0;
+  registry->_internal.queue.buffer_used = 0;
+}
+#else
+/* Without the write-behind, the queue is always empty. */
+static inline az_span get_queue_entry_value(
+    az_ulib_registry_instance* registry,
+    const _az_ulib_registry_queue_entry* entry)
+{
+  (void)registry;
+  (void)entry;
+  return AZ_SPAN_EMPTY;
+}
+
+static inline _az_ulib_registry_queue_entry*
+find_entry_in_queue(az_ulib_registry_instance* registry, az_span key)
+{
+  (void)registry;
+  (void)key;
+  return NULL;
+}
+
+static inline void drain_registry_queue(az_ulib_registry_instance* registry) { (void)registry; }
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+
+/* Operations that only read the registry share the lock, so lookups do not wait for each other.
+ * Reading an external flash changes the cache, and storing the write-behind queue changes the
+ * flash, so both need the lock in exclusive mode. Returns `true` if the lock is shared. */
+static bool acquire_registry_for_read(az_ulib_registry_instance* registry, bool drain_queue)
+{
+  if (!is_external_flash(registry))
+  {
+    az_pal_os_rwlock_acquire_shared(&registry->_internal.lock);
+    if (!drain_queue || (AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.pending) == 0))
+    {
+      return true;
+    }
+    az_pal_os_rwlock_release_shared(&registry->_internal.lock);
+  }
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  if (drain_queue)
+  {
+    drain_registry_queue(registry);
+  }
+  return false;
+}
+
+static void release_registry_for_read(az_ulib_registry_instance* registry, bool shared)
+{
+  if (shared)
+  {
+    az_pal_os_rwlock_release_shared(&registry->_internal.lock);
+  }
+  else
+  {
+    az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+  }
+}
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+static az_result
+queue_registry_entry(az_ulib_registry_instance* registry, az_span key, az_span value)
+{
+  AZ_ULIB_TRY
+  {
+    uint32_t copy_size = (uint32_t)(
+        ROUND_UP_TO_64BITS(az_span_size(key)) + ROUND_UP_TO_64BITS(az_span_size(value)));
+
+    /* Keep the order of the entries, the queue shall be empty before a synchronous add. */
+    if ((registry->_internal.queue.queued == AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE)
+        || ((registry->_internal.queue.buffer_used + copy_size)
+            > sizeof(registry->_internal.queue.buffer)))
+    {
+      drain_registry_queue(registry);
+    }
+
+    if (copy_size > sizeof(registry->_internal.queue.buffer))
+    {
+      AZ_ULIB_THROW_IF_AZ_ERROR(add_registry_entry(registry, key, value));
+    }
+    else
+    {
+      _az_ulib_registry_queue_entry* entry
+          = &registry->_internal.queue.entries[registry->_internal.queue.queued];
+      registry_node content;
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          reserve_registry_entry(registry, key, value, &entry->node, &content));
+
+      entry->data_offset = content.data_offset;
+      entry->key_size = content.key_size;
+      entry->value_size = content.value_size;
+      entry->buffer_offset = registry->_internal.queue.buffer_used;
+      az_span_copy(get_queue_entry_key(registry, entry), key);
+      az_span_copy(get_queue_entry_value(registry, entry), value);
+      registry->_internal.queue.buffer_used += copy_size;
+
+      registry->_internal.in_use_nodes++;
+      registry->_internal.in_use_data += copy_size;
+      (void)AZ_ULIB_PORT_ATOMIC_INC_W(&registry->_internal.pending);
+      registry->_internal.queue.queued++;
+      az_pal_os_event_set(&registry->_internal.queue.wakeup);
+    }
+  }
+  AZ_ULIB_CATCH(...) {}
+
+  return AZ_ULIB_TRY_RESULT;
+}
+
+/* Store entries from the queue while the registry instance is running. */
+static az_ulib_pal_thread_ret registry_worker(az_ulib_pal_thread_args args)
+{
+  az_ulib_registry_instance* registry = (az_ulib_registry_instance*)(uintptr_t)args;
+
+  while (!registry->_internal.queue.stop)
+  {
+    az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+    az_result result = commit_next_queue_entry(registry);
+    az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+    /* An entry queued after the commit leaves the event set, so the wait returns at once. */
+    if (result == AZ_ULIB_EOF)
+    {
+      (void)az_pal_os_event_wait(&registry->_internal.queue.wakeup, AZ_ULIB_WAIT_FOREVER);
+    }
+  }
+
+  AZ_ULIB_PAL_THREAD_RETURN(0);
+}
+
+static inline bool is_registry_queue_enabled(az_ulib_registry_instance* registry)
+{
+  return registry->_internal.queue.enabled;
+}
+
+/* Empty the queue, without storing its entries. */
+static void reset_registry_queue(az_ulib_registry_instance* registry)
+{
+  registry->_internal.queue.queued = 0;
+  registry->_internal.queue.committed = 0;
+  registry->_internal.queue.buffer_used = 0;
+  registry->_internal.queue.error = AZ_OK;
+  registry->_internal.pending = 0;
+}
+
+/* Start the write-behind, or store new entries synchronously if there is no thread for it. */
+static void start_registry_queue(az_ulib_registry_instance* registry)
+{
+  registry->_internal.queue.stop = false;
+  registry->_internal.queue.enabled = registry->_internal.control_block->write_behind
+      && (az_pal_os_event_init(&registry->_internal.queue.wakeup, false, false) == AZ_OK);
+  if (registry->_internal.queue.enabled
+      && (az_pal_os_thread_create(
+              registry_worker,
+              (az_ulib_pal_thread_args)(uintptr_t)registry,
+              &registry->_internal.queue.worker)
+          != AZ_OK))
+  {
+    az_pal_os_event_deinit(&registry->_internal.queue.wakeup);
+    registry->_internal.queue.enabled = false;
+  }
+}
+
+/* Stop the write-behind, and store the entries that are still in the queue. */
+static void stop_registry_queue(az_ulib_registry_instance* registry)
+{
+  if (registry->_internal.queue.enabled)
+  {
+    registry->_internal.queue.stop = true;
+    az_pal_os_event_set(&registry->_internal.queue.wakeup);
+    (void)az_pal_os_thread_join(registry->_internal.queue.worker, NULL);
+    az_pal_os_event_deinit(&registry->_internal.queue.wakeup);
+    registry->_internal.queue.enabled = false;
+    drain_registry_queue(registry);
+  }
+}
+
+/* Returns the result of the first queued entry that failed to be stored since the last call. */
+static inline az_result take_queue_error(az_ulib_registry_instance* registry)
+{
+  az_result result = registry->_internal.queue.error;
+  registry->_internal.queue.error = AZ_OK;
+  return result;
+}
+#else
+static inline az_result
+queue_registry_entry(az_ulib_registry_instance* registry, az_span key, az_span value)
+{
+  return add_registry_entry(registry, key, value);
+}
+
+static inline bool is_registry_queue_enabled(az_ulib_registry_instance* registry)
+{
+  (void)registry;
+  return false;
+}
+
+static inline void reset_registry_queue(az_ulib_registry_instance* registry)
+{
+  registry->_internal.pending = 0;
+}
+
+static inline void start_registry_queue(az_ulib_registry_instance* registry) { (void)registry; }
+
+static inline void stop_registry_queue(az_ulib_registry_instance* registry) { (void)registry; }
+
+static inline az_result take_queue_error(az_ulib_registry_instance* registry)
+{
+  (void)registry;
+  return AZ_OK;
+}
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+
+void az_ulib_registry_instance_init(
+    az_ulib_registry_instance* registry,
+    const az_ulib_registry_control_block* registry_cb)
+{
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry_cb);
+
+  /* Initialize the registry control block. */
+  registry->_internal.control_block = registry_cb;
+
+  /* Recover the registry state from the flash. */
+  registry->_internal.write_count = 0;
+  registry->_internal.erase_count = 0;
+  init_cache(registry);
+  recover_registry(registry);
+
+  /* Initialize the lock of this instance. */
+  az_pal_os_rwlock_init(&registry->_internal.lock);
+
+  /* Start the write-behind. */
+  reset_registry_queue(registry);
+  start_registry_queue(registry);
+}
+
+void az_ulib_registry_instance_deinit(az_ulib_registry_instance* registry)
+{
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+
+  /* Stop the write-behind, and store the entries that are still in the queue. */
+  stop_registry_queue(registry);
+
+  /* Deinitialize lock */
+  az_pal_os_rwlock_deinit(&registry->_internal.lock);
+
+  /* Release the instance. */
+  registry->_internal.control_block = NULL;
+}
+
+AZ_NODISCARD az_result
+az_ulib_registry_instance_delete(az_ulib_registry_instance* registry, az_span key)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    drain_registry_queue(registry);
+    registry_node* matched_node = find_node_in_registry(registry, key);
+    result = take_read_result(registry);
+    if (result != AZ_OK)
+    {
+      /* The flash failed to read the registry. */
+    }
+    else if (matched_node == NULL)
+    {
+      /* Item not found in registry */
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else
+    {
+      invalidate_checkpoint(registry);
+      begin_registry_change(registry);
+      result = set_registry_node_delete_flag(registry, matched_node);
+      end_registry_change(registry);
+      if (result == AZ_OK)
+      {
+        registry->_internal.in_use_nodes--;
+        registry->_internal.in_use_data -= get_entry_data_size(registry, matched_node);
+      }
+    }
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span* value)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_NOT_NULL(value);
+  registry_node* matched_node;
+
+  if (is_external_flash(registry))
+  {
+    return AZ_ERROR_NOT_SUPPORTED;
+  }
+
+  /* Stored entries are immutable until deleted, so try the lookup without the lock first. Entries
+   * in the write-behind queue are stored in the flash first, because the returned span shall
+   * remain valid after the queue buffer is reused. */
+  for (int32_t attempt = 0;
+       (attempt < AZ_ULIB_CONFIG_REGISTRY_LOOKUP_RETRIES)
+       && (AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.pending) == 0);
+       attempt++)
+  {
+    long sequence = AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.sequence);
+    if ((sequence & 1) == 0)
+    {
+      matched_node = find_node_in_registry(registry, key);
+      az_span found_value
+          = (matched_node == NULL) ? AZ_SPAN_EMPTY : get_node_value(registry, matched_node);
+      bool chunked = (matched_node != NULL) && is_chunked_node(registry, matched_node);
+      /* The fence keeps the reads of the node from moving after the second sequence check. */
+      AZ_ULIB_PORT_ATOMIC_THREAD_FENCE();
+      if (AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.sequence) == sequence)
+      {
+        if (matched_node == NULL)
+        {
+          return AZ_ERROR_ITEM_NOT_FOUND;
+        }
+        if (chunked)
+        {
+          return AZ_ERROR_NOT_SUPPORTED;
+        }
+        *value = found_value;
+        return AZ_OK;
+      }
+    }
+  }
+
+  /* Writers kept changing the registry, or there are queued entries, so wait for them. */
+  az_result result;
+  bool shared = acquire_registry_for_read(registry, true);
+  {
+    matched_node = find_node_in_registry(registry, key);
+    if (matched_node == NULL)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else if (is_chunked_node(registry, matched_node))
+    {
+      result = AZ_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+      *value = get_node_value(registry, matched_node);
+      result = AZ_OK;
+    }
+  }
+  release_registry_for_read(registry, shared);
+  return result;
+}
+
+static az_result copy_node_value(
+    az_ulib_registry_instance* registry,
+    const registry_node* node,
+    az_span buffer,
+    az_span* value)
+{
+  /* A lookup without the lock may see a node in the middle of an erase. */
+  if (!is_span_in_registry_data(registry, get_node_value(registry, node)))
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  uint32_t value_size = get_entry_value_size(registry, node);
+  if (value_size > (uint32_t)az_span_size(buffer))
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  read_entry_value(registry, node, 0, az_span_ptr(buffer), value_size);
+  *value = az_span_slice(buffer, 0, (int32_t)value_size);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value_copy(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span buffer,
+    az_span* value)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_VALID_SPAN(buffer, 0, false);
+  _az_PRECONDITION_NOT_NULL(value);
+  registry_node* matched_node;
+  az_result result;
+
+  /* The cache is shared by all readers, so a registry in an external flash is always read with the
+   * lock. */
+  for (int32_t attempt = 0;
+       (attempt < AZ_ULIB_CONFIG_REGISTRY_LOOKUP_RETRIES)
+       && !is_external_flash(registry)
+       && (AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.pending) == 0);
+       attempt++)
+  {
+    long sequence = AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.sequence);
+    if ((sequence & 1) == 0)
+    {
+      matched_node = find_node_in_registry(registry, key);
+      result = (matched_node == NULL) ? AZ_ERROR_ITEM_NOT_FOUND
+                                      : copy_node_value(registry, matched_node, buffer, value);
+      AZ_ULIB_PORT_ATOMIC_THREAD_FENCE();
+      if (AZ_ULIB_PORT_ATOMIC_LOAD_W(&registry->_internal.sequence) == sequence)
+      {
+        return result;
+      }
+    }
+  }
+
+  bool shared = acquire_registry_for_read(registry, false);
+  {
+    matched_node = find_node_in_registry(registry, key);
+    _az_ulib_registry_queue_entry* queued_entry
+        = (matched_node == NULL) ? find_entry_in_queue(registry, key) : NULL;
+    if (matched_node != NULL)
+    {
+      result = copy_node_value(registry, matched_node, buffer, value);
+    }
+    else if (queued_entry != NULL)
+    {
+      az_span queued_value = get_queue_entry_value(registry, queued_entry);
+      if (az_span_size(queued_value) > az_span_size(buffer))
+      {
+        result = AZ_ERROR_NOT_ENOUGH_SPACE;
+      }
+      else
+      {
+        (void)az_span_copy(buffer, queued_value);
+        *value = az_span_slice(buffer, 0, az_span_size(queued_value));
+        result = AZ_OK;
+      }
+    }
+    else
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+
+    az_result read_result = take_read_result(registry);
+    if (read_result != AZ_OK)
+    {
+      result = read_result;
+    }
+  }
+  release_registry_for_read(registry, shared);
+  return result;
+}
+
+/*
+ * ustream over a registry value. The value is immutable until the registry is erased, so all
+ * instances share the node, and only the read needs the registry lock to use the cache.
+ */
+static az_result value_ustream_set_position(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result value_ustream_reset(az_ulib_ustream* ustream_instance);
+static az_result value_ustream_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size);
+static az_result
+value_ustream_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size);
+static az_result
+value_ustream_get_position(az_ulib_ustream* ustream_instance, offset_t* const position);
+static az_result value_ustream_release(az_ulib_ustream* ustream_instance, offset_t position);
+static az_result value_ustream_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset);
+static az_result value_ustream_dispose(az_ulib_ustream* ustream_instance);
+static const az_ulib_ustream_interface value_ustream_api
+    = { value_ustream_set_position, value_ustream_reset,
+        value_ustream_read,         value_ustream_get_remaining_size,
+        value_ustream_get_position, value_ustream_release,
+        value_ustream_clone,        value_ustream_dispose,
+        NULL,                       NULL };
+
+static void init_value_ustream_instance(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_data_cb* control_block,
+    offset_t inner_current_position,
+    offset_t offset,
+    size_t length)
+{
+  ustream_instance->inner_current_position = inner_current_position;
+  ustream_instance->inner_first_valid_position = inner_current_position;
+  ustream_instance->offset_diff = offset - inner_current_position;
+  ustream_instance->control_block = control_block;
+  ustream_instance->length = length;
+  AZ_ULIB_PORT_ATOMIC_INC_W(&(control_block->ref_count));
+}
+
+static az_result value_ustream_set_position(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position > (offset_t)(ustream_instance->length))
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  ustream_instance->inner_current_position = inner_position;
+  return AZ_OK;
+}
+
+static az_result value_ustream_reset(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+
+  ustream_instance->inner_current_position = ustream_instance->inner_first_valid_position;
+
+  return AZ_OK;
+}
+
+static az_result value_ustream_read(
+    az_ulib_ustream* ustream_instance,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+  _az_PRECONDITION_NOT_NULL(buffer);
+  _az_PRECONDITION(buffer_length > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  /* The control block is the first member of the registry ustream control block. */
+  az_ulib_registry_ustream_data_cb* value_cb
+      = (az_ulib_registry_ustream_data_cb*)ustream_instance->control_block;
+  az_ulib_registry_instance* registry = value_cb->_internal.registry;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *size = 0;
+    return AZ_ULIB_EOF;
+  }
+
+  size_t remain_size = ustream_instance->length - ustream_instance->inner_current_position;
+  *size = (buffer_length < remain_size) ? buffer_length : remain_size;
+
+  bool shared = acquire_registry_for_read(registry, false);
+  read_entry_value(
+      registry,
+      value_cb->_internal.node,
+      (uint32_t)ustream_instance->inner_current_position,
+      buffer,
+      (uint32_t)*size);
+  az_result result = take_read_result(registry);
+  release_registry_for_read(registry, shared);
+
+  if (result != AZ_OK)
+  {
+    *size = 0;
+    return result;
+  }
+
+  ustream_instance->inner_current_position += *size;
+  return AZ_OK;
+}
+
+static az_result
+value_ustream_get_remaining_size(az_ulib_ustream* ustream_instance, size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+  _az_PRECONDITION_NOT_NULL(size);
+
+  *size = ustream_instance->length - ustream_instance->inner_current_position;
+
+  return AZ_OK;
+}
+
+static az_result
+value_ustream_get_position(az_ulib_ustream* ustream_instance, offset_t* const position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+  _az_PRECONDITION_NOT_NULL(position);
+
+  *position = ustream_instance->inner_current_position + ustream_instance->offset_diff;
+
+  return AZ_OK;
+}
+
+static az_result value_ustream_release(az_ulib_ustream* ustream_instance, offset_t position)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+
+  offset_t inner_position = position - ustream_instance->offset_diff;
+
+  if ((inner_position >= ustream_instance->inner_current_position)
+      || (inner_position < ustream_instance->inner_first_valid_position))
+  {
+    return AZ_ERROR_ARG;
+  }
+
+  ustream_instance->inner_first_valid_position = inner_position + (offset_t)1;
+  return AZ_OK;
+}
+
+static az_result value_ustream_clone(
+    az_ulib_ustream* ustream_instance_clone,
+    az_ulib_ustream* ustream_instance,
+    offset_t offset)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+  _az_PRECONDITION_NOT_NULL(ustream_instance_clone);
+
+  if (offset > (UINT32_MAX - ustream_instance->length))
+  {
+    return AZ_ERROR_ARG;
+  }
+
+  init_value_ustream_instance(
+      ustream_instance_clone,
+      ustream_instance->control_block,
+      ustream_instance->inner_current_position,
+      offset,
+      ustream_instance->length);
+  return AZ_OK;
+}
+
+static az_result value_ustream_dispose(az_ulib_ustream* ustream_instance)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, value_ustream_api));
+
+  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+  if ((AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count)) == 0)
+      && (control_block->control_block_release != NULL))
+  {
+    control_block->control_block_release(control_block);
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_try_get_value_ustream(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_ulib_registry_ustream_data_cb* ustream_control_block,
+    az_ulib_release_callback control_block_release,
+    az_ulib_ustream* ustream_instance)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_NOT_NULL(ustream_control_block);
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  az_result result;
+
+  /* The ustream reads the value from the flash, so queued entries shall be stored first. */
+  bool shared = acquire_registry_for_read(registry, true);
+  {
+    registry_node* matched_node = find_node_in_registry(registry, key);
+    size_t value_size = (matched_node == NULL) ? 0 : get_entry_value_size(registry, matched_node);
+    result = take_read_result(registry);
+    if (result != AZ_OK)
+    {
+      /* The flash failed to read the registry. */
+    }
+    else if (matched_node == NULL)
+    {
+      result = AZ_ERROR_ITEM_NOT_FOUND;
+    }
+    else
+    {
+      ustream_control_block->control_block.api = &value_ustream_api;
+      ustream_control_block->control_block.ptr = NULL;
+      ustream_control_block->control_block.ref_count = 0;
+      ustream_control_block->control_block.data_release = NULL;
+      ustream_control_block->control_block.control_block_release = control_block_release;
+      ustream_control_block->_internal.registry = registry;
+      ustream_control_block->_internal.node = matched_node;
+      init_value_ustream_instance(
+          ustream_instance,
+          &ustream_control_block->control_block,
+          0,
+          0,
+          value_size);
+      result = AZ_OK;
+    }
+  }
+  release_registry_for_read(registry, shared);
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_iterate(
+    az_ulib_registry_instance* registry,
+    az_span prefix,
+    uint32_t* cursor,
+    az_span* key,
+    az_span* value)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_NOT_NULL(cursor);
+  _az_PRECONDITION_NOT_NULL(key);
+  _az_PRECONDITION_NOT_NULL(value);
+  az_result result = AZ_ULIB_EOF;
+
+  if (is_external_flash(registry))
+  {
+    return AZ_ERROR_NOT_SUPPORTED;
+  }
+
+  bool shared = acquire_registry_for_read(registry, true);
+  {
+    /* Nodes are appended in order, so the cursor is the index of the next node to visit and the
+     * first free node ends the iteration. */
+    for (registry_node* runner = get_node(registry, *cursor);
+         runner < get_registry_info_end(registry);
+         runner = get_next_node(registry, runner))
+    {
+      if ((runner->ready_flag == REGISTRY_FREE) && (runner->delete_flag == REGISTRY_FREE))
+      {
+        break;
+      }
+
+      if ((runner->ready_flag == REGISTRY_READY) && (runner->delete_flag == REGISTRY_FREE))
+      {
+        az_span node_key = get_node_key(registry, runner);
+        if ((az_span_size(node_key) > 0) && (az_span_size(node_key) >= az_span_size(prefix))
+            && az_span_is_content_equal(prefix, az_span_slice(node_key, 0, az_span_size(prefix))))
+        {
+          *key = node_key;
+          *value = is_chunked_node(registry, runner) ? AZ_SPAN_EMPTY
+                                                     : get_node_value(registry, runner);
+          *cursor = get_node_index(registry, runner) + 1;
+          result = AZ_OK;
+          break;
+        }
+      }
+    }
+  }
+  release_registry_for_read(registry, shared);
+  return result;
+}
+
+/* A value can be programmed over the stored one if the flash accepts a second program, and the
+ * new value has the same size and only clears bits. */
+static bool can_update_in_place(
+    az_ulib_registry_instance* registry,
+    az_span stored_value,
+    az_span new_value)
+{
+  if (!registry->_internal.control_block->reprogrammable
+      || (az_span_size(stored_value) != az_span_size(new_value)))
+  {
+    return false;
+  }
+
+  uint8_t chunk[AZ_ULIB_CONFIG_REGISTRY_CACHE_BLOCK_SIZE];
+  uint8_t* new_ptr = az_span_ptr(new_value);
+  for (int32_t offset = 0; offset < az_span_size(new_value); offset += (int32_t)sizeof(chunk))
+  {
+    int32_t size = az_span_size(new_value) - offset;
+    if (size > (int32_t)sizeof(chunk))
+    {
+      size = (int32_t)sizeof(chunk);
+    }
+    read_from_flash(registry, az_span_ptr(stored_value) + offset, chunk, (uint32_t)size);
+    for (int32_t i = 0; i < size; i++)
+    {
+      if ((chunk[i] & new_ptr[offset + i]) != new_ptr[offset + i])
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+AZ_NODISCARD az_result
+az_ulib_registry_instance_add(az_ulib_registry_instance* registry, az_span key, az_span value)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_VALID_SPAN(value, 1, false);
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    /* Validate for duplicates before adding new entry */
+    bool duplicate = (find_node_in_registry(registry, key) != NULL)
+        || (find_entry_in_queue(registry, key) != NULL);
+    result = take_read_result(registry);
+    if (result != AZ_OK)
+    {
+      /* The flash failed to read the registry, so duplicates cannot be excluded. */
+    }
+    else if (duplicate)
+    {
+      result = AZ_ERROR_ULIB_ELEMENT_DUPLICATE;
+    }
+    else if (is_registry_queue_enabled(registry))
+    {
+      result = queue_registry_entry(registry, key, value);
+    }
+    else
+    {
+      result = add_registry_entry(registry, key, value);
+    }
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_add_begin(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_ulib_registry_writer* writer)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_NOT_NULL(writer);
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    bool duplicate = (find_node_in_registry(registry, key) != NULL)
+        || (find_entry_in_queue(registry, key) != NULL);
+    result = take_read_result(registry);
+    if (result != AZ_OK)
+    {
+      /* The flash failed to read the registry, so duplicates cannot be excluded. */
+    }
+    else if (duplicate)
+    {
+      result = AZ_ERROR_ULIB_ELEMENT_DUPLICATE;
+    }
+    else if (registry->_internal.format != REGISTRY_FORMAT_COMPACT)
+    {
+      result = AZ_ERROR_ULIB_INCOMPATIBLE_VERSION;
+    }
+    else if (az_span_size(key) > REGISTRY_KEY_SIZE_MASK)
+    {
+      result = AZ_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+      writer->_internal.registry = registry;
+      writer->_internal.key = key;
+      writer->_internal.chunk_count = 0;
+      writer->_internal.data_size = 0;
+      result = AZ_OK;
+    }
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_writer_write(az_ulib_registry_writer* writer, az_span data)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(writer);
+  _az_PRECONDITION_NOT_NULL(writer->_internal.registry);
+  _az_PRECONDITION_VALID_SPAN(data, 1, false);
+  az_ulib_registry_instance* registry = writer->_internal.registry;
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    AZ_ULIB_TRY
+    {
+      /* Keep the order of the entries, the queue shall be empty before a synchronous add. */
+      drain_registry_queue(registry);
+
+      while (az_span_size(data) > 0)
+      {
+        int32_t size = (az_span_size(data) < REGISTRY_MAX_CHUNK_SIZE) ? az_span_size(data)
+                                                                      : REGISTRY_MAX_CHUNK_SIZE;
+        az_span piece = az_span_slice(data, 0, size);
+        registry_node* node;
+        registry_node content;
+
+        AZ_ULIB_THROW_IF_ERROR(
+            (writer->_internal.chunk_count < AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS),
+            AZ_ERROR_NOT_ENOUGH_SPACE);
+        AZ_ULIB_THROW_IF_AZ_ERROR(
+            reserve_registry_entry(registry, AZ_SPAN_EMPTY, piece, &node, &content));
+        AZ_ULIB_THROW_IF_AZ_ERROR(
+            commit_registry_entry(registry, node, &content, AZ_SPAN_EMPTY, piece));
+
+        writer->_internal.chunks[writer->_internal.chunk_count++] = get_node_index(registry, node);
+        writer->_internal.data_size += get_content_data_size(&content);
+        data = az_span_slice_to_end(data, size);
+      }
+    }
+    AZ_ULIB_CATCH(...) {}
+    result = AZ_ULIB_TRY_RESULT;
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  return result;
+}
+
+/* Mark the chunks of a writer as deleted, they will never be part of an entry. */
+static void discard_writer_chunks(az_ulib_registry_writer* writer)
+{
+  az_ulib_registry_instance* registry = writer->_internal.registry;
+
+  for (uint32_t chunk = 0; chunk < writer->_internal.chunk_count; chunk++)
+  {
+    (void)set_registry_node_delete_flag(
+        registry, get_node(registry, writer->_internal.chunks[chunk]));
+  }
+}
+
+AZ_NODISCARD az_result az_ulib_registry_writer_commit(az_ulib_registry_writer* writer)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(writer);
+  _az_PRECONDITION_NOT_NULL(writer->_internal.registry);
+  _az_PRECONDITION(writer->_internal.chunk_count > 0);
+  az_ulib_registry_instance* registry = writer->_internal.registry;
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    AZ_ULIB_TRY
+    {
+      registry_node* node;
+      registry_node content;
+      az_span chunk_list = az_span_create(
+          (uint8_t*)writer->_internal.chunks,
+          (int32_t)(writer->_internal.chunk_count * sizeof(uint32_t)));
+
+      drain_registry_queue(registry);
+      registry_node* matched_node = find_node_in_registry(registry, writer->_internal.key);
+      AZ_ULIB_THROW_IF_AZ_ERROR(take_read_result(registry));
+      AZ_ULIB_THROW_IF_ERROR((matched_node == NULL), AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+
+      /* The entry only becomes visible when its ready flag is set, after all chunks are in the
+       * flash. */
+      AZ_ULIB_THROW_IF_AZ_ERROR(
+          reserve_registry_entry(registry, writer->_internal.key, chunk_list, &node, &content));
+      content.key_size |= REGISTRY_CHUNKED_KEY;
+      AZ_ULIB_THROW_IF_AZ_ERROR(commit_registry_entry(
+          registry, node, &content, writer->_internal.key, chunk_list));
+
+      registry->_internal.in_use_nodes++;
+      registry->_internal.in_use_data
+          += get_content_data_size(&content) + writer->_internal.data_size;
+      count_added_entry(registry);
+    }
+    AZ_ULIB_CATCH(...)
+    {
+      discard_writer_chunks(writer);
+    }
+    result = AZ_ULIB_TRY_RESULT;
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  writer->_internal.registry = NULL;
+  return result;
+}
+
+void az_ulib_registry_writer_abort(az_ulib_registry_writer* writer)
+{
+  _az_PRECONDITION_NOT_NULL(writer);
+  _az_PRECONDITION_NOT_NULL(writer->_internal.registry);
+  az_ulib_registry_instance* registry = writer->_internal.registry;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  discard_writer_chunks(writer);
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  writer->_internal.registry = NULL;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_update(
+    az_ulib_registry_instance* registry,
+    az_span key,
+    az_span value,
+    az_ulib_registry_update_mode* mode)
+{
+  /* Precondition check */
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_VALID_SPAN(key, 1, false);
+  _az_PRECONDITION_VALID_SPAN(value, 1, false);
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    AZ_ULIB_TRY
+    {
+      az_ulib_registry_update_mode update_mode;
+      drain_registry_queue(registry);
+      registry_node* matched_node = find_node_in_registry(registry, key);
+      AZ_ULIB_THROW_IF_AZ_ERROR(take_read_result(registry));
+      AZ_ULIB_THROW_IF_ERROR((matched_node != NULL), AZ_ERROR_ITEM_NOT_FOUND);
+
+      az_span stored_value = get_node_value(registry, matched_node);
+      bool in_place = !is_chunked_node(registry, matched_node)
+          && can_update_in_place(registry, stored_value, value);
+      bool changed = !in_place || !is_flash_content_equal(registry, stored_value, value);
+      AZ_ULIB_THROW_IF_AZ_ERROR(take_read_result(registry));
+      if (in_place)
+      {
+        /* There is nothing to program if the value did not change. */
+        if (changed)
+        {
+          begin_registry_change(registry);
+          az_result write_result
+              = write_span_to_flash(registry, (uint64_t*)az_span_ptr(stored_value), value);
+          end_registry_change(registry);
+          AZ_ULIB_THROW_IF_AZ_ERROR(write_result);
+        }
+        update_mode = AZ_ULIB_REGISTRY_UPDATE_IN_PLACE;
+      }
+      else
+      {
+        /* Store the new entry before deleting the old one, so a power failure in the middle of the
+         * update will never lose the key. A checkpoint between the two would hide the duplicate
+         * key from the recovery, so the new entry is only counted after the delete. */
+        AZ_ULIB_THROW_IF_AZ_ERROR(store_registry_entry(registry, key, value));
+        invalidate_checkpoint(registry);
+        begin_registry_change(registry);
+        az_result delete_result = set_registry_node_delete_flag(registry, matched_node);
+        end_registry_change(registry);
+        AZ_ULIB_THROW_IF_AZ_ERROR(delete_result);
+        registry->_internal.in_use_nodes--;
+        registry->_internal.in_use_data -= get_entry_data_size(registry, matched_node);
+        count_added_entry(registry);
+        update_mode = AZ_ULIB_REGISTRY_UPDATE_APPEND;
+      }
+
+      if (mode != NULL)
+      {
+        *mode = update_mode;
+      }
+    }
+    AZ_ULIB_CATCH(...) {}
+    result = AZ_ULIB_TRY_RESULT;
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_registry_instance_flush(az_ulib_registry_instance* registry)
+{
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  az_result result;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  {
+    drain_registry_queue(registry);
+    result = take_queue_error(registry);
+  }
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+
+  return result;
+}
+
+void az_ulib_registry_instance_clean_all(az_ulib_registry_instance* registry)
+{
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  az_pal_os_rwlock_acquire_exclusive(&registry->_internal.lock);
+  begin_registry_change(registry);
+  {
+    (void)erase_flash(
+        registry,
+        registry_cb->registry_info_start,
+        (uint32_t)(
+            (uint8_t*)(registry_cb->registry_info_end)
+            - (uint8_t*)(registry_cb->registry_info_start)));
+
+    (void)erase_flash(
+        registry,
+        registry_cb->registry_start,
+        (uint32_t)(
+            (uint8_t*)(registry_cb->registry_end) - (uint8_t*)(registry_cb->registry_start)));
+
+    if (registry_cb->registry_checkpoint_start != NULL)
+    {
+      (void)erase_flash(
+          registry,
+          registry_cb->registry_checkpoint_start,
+          (uint32_t)(
+              (uint8_t*)(registry_cb->registry_checkpoint_end)
+              - (uint8_t*)(registry_cb->registry_checkpoint_start)));
+    }
+
+    /* The registry is empty now, including the entries that were waiting in the queue. */
+    reset_registry_queue(registry);
+    recover_registry(registry);
+  }
+  end_registry_change(registry);
+  az_pal_os_rwlock_release_exclusive(&registry->_internal.lock);
+}
+
+void az_ulib_registry_instance_get_info(
+    az_ulib_registry_instance* registry,
+    az_ulib_registry_info* info)
+{
+  _az_PRECONDITION_NOT_NULL(registry);
+  _az_PRECONDITION_NOT_NULL(registry->_internal.control_block);
+  _az_PRECONDITION_NOT_NULL(info);
+  const az_ulib_registry_control_block* registry_cb = registry->_internal.control_block;
+
+  bool shared = acquire_registry_for_read(registry, false);
+  {
+    /* All counters are kept up to date by the registry APIs, there is no need to scan the flash. */
+    info->total_registry_info = get_node_index(registry, get_registry_info_end(registry));
+    info->free_registry_info
+        = info->total_registry_info - get_node_index(registry, registry->_internal.free_node);
+    info->in_use_registry_info = registry->_internal.in_use_nodes;
+
+    info->total_registry_data
+        = (size_t)((uint8_t*)registry_cb->registry_end - (uint8_t*)registry_cb->registry_start);
+    info->free_registry_data
+        = (size_t)((uint8_t*)registry_cb->registry_end - registry->_internal.free_data);
+    info->in_use_registry_data = registry->_internal.in_use_data;
+    info->dead_registry_data = (size_t)(
+        (registry->_internal.free_data - (uint8_t*)registry_cb->registry_start)
+        - (ptrdiff_t)registry->_internal.in_use_data);
+
+    info->write_count = registry->_internal.write_count;
+    get_cache_info(registry, info);
+    info->erase_count = registry->_internal.erase_count;
+  }
+  release_registry_for_read(registry, shared);
+}
+
+void az_ulib_registry_init(const az_ulib_registry_control_block* registry_cb)
+{
+  _az_PRECONDITION_IS_NULL(default_registry._internal.control_block);
+
+  az_ulib_registry_instance_init(&default_registry, registry_cb);
+}
+
+void az_ulib_registry_deinit(void) { az_ulib_registry_instance_deinit(&default_registry); }
+
+AZ_NODISCARD az_result az_ulib_registry_delete(az_span key)
+{
+  return az_ulib_registry_instance_delete(&default_registry, key);
+}
+
+AZ_NODISCARD az_result az_ulib_registry_try_get_value(az_span key, az_span* value)
+{
+  return az_ulib_registry_instance_try_get_value(&default_registry, key, value);
+}
+
+AZ_NODISCARD az_result
+az_ulib_registry_try_get_value_copy(az_span key, az_span buffer, az_span* value)
+{
+  return az_ulib_registry_instance_try_get_value_copy(&default_registry, key, buffer, value);
+}
+
+AZ_NODISCARD az_result az_ulib_registry_try_get_value_ustream(
+    az_span key,
+    az_ulib_registry_ustream_data_cb* ustream_control_block,
+    az_ulib_release_callback control_block_release,
+    az_ulib_ustream* ustream_instance)
+{
+  return az_ulib_registry_instance_try_get_value_ustream(
+      &default_registry, key, ustream_control_block, control_block_release, ustream_instance);
+}
+
+AZ_NODISCARD az_result
+az_ulib_registry_iterate(az_span prefix, uint32_t* cursor, az_span* key, az_span* value)
+{
+  return az_ulib_registry_instance_iterate(&default_registry, prefix, cursor, key, value);
+}
+
+AZ_NODISCARD az_result az_ulib_registry_add(az_span key, az_span value)
+{
+  return az_ulib_registry_instance_add(&default_registry, key, value);
+}
+
+AZ_NODISCARD az_result az_ulib_registry_add_begin(az_span key, az_ulib_registry_writer* writer)
+{
+  return az_ulib_registry_instance_add_begin(&default_registry, key, writer);
+}
+
+AZ_NODISCARD az_result
+az_ulib_registry_update(az_span key, az_span value, az_ulib_registry_update_mode* mode)
+{
+  return az_ulib_registry_instance_update(&default_registry, key, value, mode);
+}
+
+AZ_NODISCARD az_result az_ulib_registry_flush(void)
+{
+  return az_ulib_registry_instance_flush(&default_registry);
+}
+
+void az_ulib_registry_clean_all(void) { az_ulib_registry_instance_clean_all(&default_registry); }
+
+void az_ulib_registry_get_info(az_ulib_registry_info* info)
+{
+  az_ulib_registry_instance_get_info(&default_registry, info);
 }
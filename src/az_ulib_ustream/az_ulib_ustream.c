@@ -18,17 +18,22 @@
   _Pragma("clang diagnostic push")        \
       _Pragma("clang diagnostic ignored \"-Wincompatible-pointer-types-discards-qualifiers\"")
 #define IGNORE_MEMCPY_TO_NULL _Pragma("GCC diagnostic push")
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("clang diagnostic push") _Pragma("clang diagnostic ignored \"-Wcast-qual\"")
 #define RESUME_WARNINGS _Pragma("clang diagnostic pop")
 #elif defined(__GNUC__)
 #define IGNORE_POINTER_TYPE_QUALIFICATION \
   _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wdiscarded-qualifiers\"")
 #define IGNORE_MEMCPY_TO_NULL _Pragma("GCC diagnostic push")
+#define IGNORE_CAST_QUALIFICATION \
+  _Pragma("GCC diagnostic push") _Pragma("GCC diagnostic ignored \"-Wcast-qual\"")
 #define RESUME_WARNINGS _Pragma("GCC diagnostic pop")
 #else
 #define IGNORE_POINTER_TYPE_QUALIFICATION __pragma(warning(push));
 #define IGNORE_MEMCPY_TO_NULL \
   __pragma(warning(push));  \
   __pragma(warning(suppress: 6387));
+#define IGNORE_CAST_QUALIFICATION __pragma(warning(push));
 #define RESUME_WARNINGS __pragma(warning(pop));
 #endif // __clang__
 
@@ -47,9 +52,16 @@ static az_result concrete_clone(
     az_ulib_ustream* ustream_instance,
     offset_t offset);
 static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(az_ulib_ustream* ustream_instance, az_span* const span);
+static az_result concrete_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size);
 static const az_ulib_ustream_interface api
     = { concrete_set_position, concrete_reset,   concrete_read,  concrete_get_remaining_size,
-        concrete_get_position, concrete_release, concrete_clone, concrete_dispose };
+        concrete_get_position, concrete_release, concrete_clone, concrete_dispose,
+        concrete_peek,         concrete_readv };
 
 static void init_instance(
     az_ulib_ustream* ustream_instance,
@@ -227,8 +239,7 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
 
   az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
 
-  AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
-  if (control_block->ref_count == 0)
+  if (AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count)) == 0)
   {
     destroy_control_block(control_block);
   }
@@ -236,6 +247,82 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
   return AZ_OK;
 }
 
+static az_result concrete_peek(az_ulib_ustream* ustream_instance, az_span* const span)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(span);
+
+  az_result result;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *span = AZ_SPAN_EMPTY;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    size_t remain_size
+        = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    /* The span is read-only for the caller, so it is safe to remove the `const` qualification of
+     * the `ptr`. */
+    IGNORE_CAST_QUALIFICATION
+    *span = az_span_create(
+        (uint8_t*)ustream_instance->control_block->ptr + ustream_instance->inner_current_position,
+        (remain_size < (size_t)INT32_MAX) ? (int32_t)remain_size : INT32_MAX);
+    RESUME_WARNINGS
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
+static az_result concrete_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffers);
+  _az_PRECONDITION(buffers_count > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  const uint8_t* ptr = (const uint8_t*)ustream_instance->control_block->ptr;
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
+  {
+    *size = 0;
+    result = AZ_ULIB_EOF;
+  }
+  else
+  {
+    size_t remain_size
+        = ustream_instance->length - (size_t)ustream_instance->inner_current_position;
+    *size = 0;
+    for (size_t i = 0; (i < buffers_count) && (*size < remain_size); i++)
+    {
+      size_t copy_size = (size_t)az_span_size(buffers[i]);
+      if (copy_size > (remain_size - *size))
+      {
+        copy_size = remain_size - *size;
+      }
+      IGNORE_MEMCPY_TO_NULL
+      memcpy(
+          az_span_ptr(buffers[i]),
+          ptr + ustream_instance->inner_current_position + *size,
+          copy_size);
+      RESUME_WARNINGS
+      *size += copy_size;
+    }
+    ustream_instance->inner_current_position += *size;
+    result = AZ_OK;
+  }
+
+  return result;
+}
+
 AZ_NODISCARD az_result az_ulib_ustream_init(
     az_ulib_ustream* ustream_instance,
     az_ulib_ustream_data_cb* ustream_control_block,
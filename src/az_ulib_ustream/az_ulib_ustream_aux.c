@@ -12,6 +12,10 @@
 
 #include <azure/core/internal/az_precondition_internal.h>
 
+#if (AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS < 2)
+#error "The multi ustream needs at least 2 segments."
+#endif
+
 #ifdef __clang__
 #define IGNORE_CAST_QUALIFICATION \
   _Pragma("clang diagnostic push") _Pragma("clang diagnostic ignored \"-Wcast-qual\"")
@@ -40,9 +44,16 @@ static az_result concrete_clone(
     az_ulib_ustream* ustream_instance,
     offset_t offset);
 static az_result concrete_dispose(az_ulib_ustream* ustream_instance);
+static az_result concrete_peek(az_ulib_ustream* ustream_instance, az_span* const span);
+static az_result concrete_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size);
 static const az_ulib_ustream_interface api
     = { concrete_set_position, concrete_reset,   concrete_read,  concrete_get_remaining_size,
-        concrete_get_position, concrete_release, concrete_clone, concrete_dispose };
+        concrete_get_position, concrete_release, concrete_clone, concrete_dispose,
+        concrete_peek,         concrete_readv };
 
 static void destroy_instance(az_ulib_ustream* ustream_instance)
 {
@@ -53,6 +64,10 @@ static void destroy_instance(az_ulib_ustream* ustream_instance)
   az_ulib_ustream_multi_data_cb* multidata
       = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
   RESUME_WARNINGS
+  for (size_t i = 0; i < multidata->segments_count; i++)
+  {
+    az_ulib_ustream_dispose(&(multidata->segments[i]));
+  }
   az_pal_os_lock_deinit(&multidata->lock);
 
   if (ustream_instance->control_block->data_release != NULL)
@@ -61,6 +76,83 @@ static void destroy_instance(az_ulib_ustream* ustream_instance)
   }
 }
 
+/* Returns the index of the segment that contains the provided position, or `segments_count` if the
+ * position is after the last segment. Sequential reads start on the segment where the last read
+ * stopped, any other position uses a binary search on the end of the segments. It shall be called
+ * in the critical section. */
+static size_t find_segment(az_ulib_ustream_multi_data_cb* multi_data, offset_t position)
+{
+  size_t index = multi_data->current_segment;
+
+  if ((index >= multi_data->segments_count) || (position >= multi_data->segments_end[index])
+      || ((index > 0) && (position < multi_data->segments_end[index - 1])))
+  {
+    size_t first = 0;
+    size_t last = multi_data->segments_count;
+    while (first < last)
+    {
+      size_t middle = first + ((last - first) >> 1);
+      if (position < multi_data->segments_end[middle])
+      {
+        last = middle;
+      }
+      else
+      {
+        first = middle + 1;
+      }
+    }
+    index = first;
+  }
+
+  return index;
+}
+
+/* Reads up to `buffer_length` bytes from the segments, starting at the provided position in the
+ * segment `*index`, and moves `*index` to the segment where the read stopped. It shall be called
+ * in the critical section. */
+static az_result read_segments(
+    az_ulib_ustream_multi_data_cb* multi_data,
+    size_t* index,
+    offset_t position,
+    uint8_t* const buffer,
+    size_t buffer_length,
+    size_t* const size)
+{
+  az_result result = AZ_OK;
+
+  *size = 0;
+  while ((result == AZ_OK) && (*size < buffer_length) && (*index < multi_data->segments_count))
+  {
+    az_ulib_ustream* segment = &(multi_data->segments[*index]);
+    offset_t segment_position = position + *size;
+    size_t segment_remain_size = multi_data->segments_end[*index] - segment_position;
+    size_t copied_size;
+
+    if (((result = az_ulib_ustream_set_position(segment, segment_position)) == AZ_OK)
+        && ((result = az_ulib_ustream_read(
+                 segment,
+                 &buffer[*size],
+                 ((buffer_length - *size) < segment_remain_size) ? (buffer_length - *size)
+                                                                 : segment_remain_size,
+                 &copied_size))
+            == AZ_OK))
+    {
+      *size += copied_size;
+      if (copied_size == segment_remain_size)
+      {
+        (*index)++;
+      }
+    }
+    else if (result == AZ_ULIB_EOF)
+    {
+      (*index)++;
+      result = AZ_OK;
+    }
+  }
+
+  return ((result == AZ_OK) && (*size == 0)) ? AZ_ULIB_EOF : result;
+}
+
 static az_result concrete_set_position(az_ulib_ustream* ustream_instance, offset_t position)
 {
   _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
@@ -110,48 +202,23 @@ static az_result concrete_read(
       = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
   RESUME_WARNINGS
 
-  az_ulib_ustream* current_ustream
-      = (ustream_instance->inner_current_position < multi_data->ustream_one.length)
-      ? &multi_data->ustream_one
-      : &multi_data->ustream_two;
-
-  *size = 0;
-  az_result intermediate_result = AZ_OK;
-  while ((intermediate_result == AZ_OK) && (*size < buffer_length) && (current_ustream != NULL))
-  {
-    size_t copied_size;
-    size_t remain_size = buffer_length - *size;
-
-    // Critical section to make sure another instance doesn't set_position before this one reads
-    az_pal_os_lock_acquire(&multi_data->lock);
-    az_ulib_ustream_set_position(current_ustream, ustream_instance->inner_current_position + *size);
-    intermediate_result
-        = az_ulib_ustream_read(current_ustream, &buffer[*size], remain_size, &copied_size);
-    az_pal_os_lock_release(&multi_data->lock);
-
-    switch (intermediate_result)
-    {
-      case AZ_OK:
-        *size += copied_size;
-        _az_FALLTHROUGH;
-      case AZ_ULIB_EOF:
-        if (*size < buffer_length)
-        {
-          if (current_ustream == &multi_data->ustream_one)
-          {
-            current_ustream = &multi_data->ustream_two;
-            intermediate_result = AZ_OK;
-          }
-          else
-          {
-            current_ustream = NULL;
-          }
-        }
-        break;
-      default:
-        break;
-    }
-  }
+  /* The segments may have more data than this instance, if it was split. */
+  size_t remain_size = (ustream_instance->inner_current_position < ustream_instance->length)
+      ? ustream_instance->length - (size_t)ustream_instance->inner_current_position
+      : 0;
+
+  // Critical section to make sure another instance doesn't set_position before this one reads
+  az_pal_os_lock_acquire(&multi_data->lock);
+  size_t index = find_segment(multi_data, ustream_instance->inner_current_position);
+  az_result intermediate_result = read_segments(
+      multi_data,
+      &index,
+      ustream_instance->inner_current_position,
+      buffer,
+      (buffer_length < remain_size) ? buffer_length : remain_size,
+      size);
+  multi_data->current_segment = index;
+  az_pal_os_lock_release(&multi_data->lock);
 
   if (*size != 0)
   {
@@ -229,17 +296,8 @@ static az_result concrete_clone(
     ustream_instance_clone->control_block = ustream_instance->control_block;
     ustream_instance_clone->length = ustream_instance->length;
 
+    /* The segments belong to the multidata control block, and are disposed with it. */
     AZ_ULIB_PORT_ATOMIC_INC_W(&(ustream_instance->control_block->ref_count));
-
-    /* In multidata, `ptr` points to a internal multidata control block, and the multidata code
-     * needs write permission to execute its function. So, we have an Warning exception here to
-     * remove the `const` qualification of the `ptr`. */
-    IGNORE_CAST_QUALIFICATION
-    az_ulib_ustream_multi_data_cb* multi_data
-        = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
-    RESUME_WARNINGS
-    AZ_ULIB_PORT_ATOMIC_INC_W(&(multi_data->ustream_one_ref_count));
-    AZ_ULIB_PORT_ATOMIC_INC_W(&(multi_data->ustream_two_ref_count));
     result = AZ_OK;
   }
 
@@ -250,6 +308,23 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
 {
   _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
 
+  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+
+  if (AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count)) == 0)
+  {
+    destroy_instance(ustream_instance);
+  }
+
+  return AZ_OK;
+}
+
+static az_result concrete_peek(az_ulib_ustream* ustream_instance, az_span* const span)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(span);
+
+  az_result result;
+
   /* In multidata, `ptr` points to a internal multidata control block, and the multidata code needs
    * write permission to execute its function. So, we have an Warning exception here to remove the
    * `const` qualification of the `ptr`. */
@@ -257,26 +332,128 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
   az_ulib_ustream_multi_data_cb* multi_data
       = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
   RESUME_WARNINGS
-  AZ_ULIB_PORT_ATOMIC_DEC_W(&(multi_data->ustream_one_ref_count));
-  AZ_ULIB_PORT_ATOMIC_DEC_W(&(multi_data->ustream_two_ref_count));
-  if (multi_data->ustream_one_ref_count == 0 && multi_data->ustream_one.control_block != NULL)
+
+  if (ustream_instance->inner_current_position >= ustream_instance->length)
   {
-    az_ulib_ustream_dispose(&(multi_data->ustream_one));
+    *span = AZ_SPAN_EMPTY;
+    result = AZ_ULIB_EOF;
   }
-  if (multi_data->ustream_two_ref_count == 0 && multi_data->ustream_two.control_block != NULL)
+  else
   {
-    az_ulib_ustream_dispose(&(multi_data->ustream_two));
+    // Critical section to make sure another instance doesn't set_position before this one peeks
+    az_pal_os_lock_acquire(&multi_data->lock);
+    size_t index = find_segment(multi_data, ustream_instance->inner_current_position);
+    if (index >= multi_data->segments_count)
+    {
+      *span = AZ_SPAN_EMPTY;
+      result = AZ_ULIB_EOF;
+    }
+    else
+    {
+      az_ulib_ustream* segment = &(multi_data->segments[index]);
+      if (segment->control_block->api->peek == NULL)
+      {
+        result = AZ_ERROR_NOT_SUPPORTED;
+      }
+      else if (
+          (result = az_ulib_ustream_set_position(segment, ustream_instance->inner_current_position))
+          == AZ_OK)
+      {
+        result = segment->control_block->api->peek(segment, span);
+      }
+
+      /* The span shall not cross the end of the segment, or the end of this instance, if it was
+       * split. */
+      offset_t end = (multi_data->segments_end[index] < ustream_instance->length)
+          ? multi_data->segments_end[index]
+          : ustream_instance->length;
+      size_t remain_size = end - (size_t)ustream_instance->inner_current_position;
+      if ((result == AZ_OK) && ((size_t)az_span_size(*span) > remain_size))
+      {
+        *span = az_span_slice(*span, 0, (int32_t)remain_size);
+      }
+    }
+    az_pal_os_lock_release(&multi_data->lock);
   }
 
-  az_ulib_ustream_data_cb* control_block = ustream_instance->control_block;
+  return result;
+}
+
+static az_result concrete_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size)
+{
+  _az_PRECONDITION(AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api));
+  _az_PRECONDITION_NOT_NULL(buffers);
+  _az_PRECONDITION(buffers_count > 0);
+  _az_PRECONDITION_NOT_NULL(size);
 
-  AZ_ULIB_PORT_ATOMIC_DEC_W(&(control_block->ref_count));
-  if (control_block->ref_count == 0)
+  az_result result;
+
+  /* In multidata, `ptr` points to a internal multidata control block, and the multidata code needs
+   * write permission to execute its function. So, we have an Warning exception here to remove the
+   * `const` qualification of the `ptr`. */
+  IGNORE_CAST_QUALIFICATION
+  az_ulib_ustream_multi_data_cb* multi_data
+      = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+  RESUME_WARNINGS
+
+  /* The segments may have more data than this instance, if it was split. */
+  size_t remain_size = (ustream_instance->inner_current_position < ustream_instance->length)
+      ? ustream_instance->length - (size_t)ustream_instance->inner_current_position
+      : 0;
+
+  *size = 0;
+  az_result intermediate_result = (remain_size == 0) ? AZ_ULIB_EOF : AZ_OK;
+
+  /* Critical section to make sure another instance doesn't set_position before this one reads.
+   * All buffers are filled under the same lock, and each read continues from the segment where the
+   * previous one stopped. */
+  az_pal_os_lock_acquire(&multi_data->lock);
+  size_t index = find_segment(multi_data, ustream_instance->inner_current_position);
+  for (size_t i = 0; (intermediate_result == AZ_OK) && (i < buffers_count) && (*size < remain_size);
+       i++)
   {
-    destroy_instance(ustream_instance);
+    size_t buffer_length = (size_t)az_span_size(buffers[i]);
+    if (buffer_length > (remain_size - *size))
+    {
+      buffer_length = remain_size - *size;
+    }
+    if (buffer_length > 0)
+    {
+      size_t copied_size;
+      intermediate_result = read_segments(
+          multi_data,
+          &index,
+          ustream_instance->inner_current_position + *size,
+          az_span_ptr(buffers[i]),
+          buffer_length,
+          &copied_size);
+      *size += copied_size;
+      if (copied_size < buffer_length)
+      {
+        /* The segments ended before the instance, or a read failed. */
+        intermediate_result
+            = (intermediate_result == AZ_OK) ? AZ_ULIB_EOF : intermediate_result;
+      }
+    }
   }
+  multi_data->current_segment = index;
+  az_pal_os_lock_release(&multi_data->lock);
 
-  return AZ_OK;
+  if (*size != 0)
+  {
+    ustream_instance->inner_current_position += *size;
+    result = AZ_OK;
+  }
+  else
+  {
+    result = intermediate_result;
+  }
+
+  return result;
 }
 
 static void ustream_multi_init(
@@ -285,19 +462,15 @@ static void ustream_multi_init(
     az_ulib_ustream_multi_data_cb* multi_data,
     az_ulib_release_callback multi_data_release)
 {
-  multi_data->ustream_one.control_block = ustream_instance->control_block;
-  multi_data->ustream_one.inner_current_position = ustream_instance->inner_current_position;
-  multi_data->ustream_one.inner_first_valid_position = ustream_instance->inner_first_valid_position;
-  multi_data->ustream_one.length = ustream_instance->length;
-  multi_data->ustream_one.offset_diff = ustream_instance->offset_diff;
-  multi_data->ustream_one_ref_count = 1;
-
-  multi_data->ustream_two.control_block = NULL;
-  multi_data->ustream_two.inner_current_position = 0;
-  multi_data->ustream_two.inner_first_valid_position = 0;
-  multi_data->ustream_two.length = 0;
-  multi_data->ustream_two.offset_diff = 0;
-  multi_data->ustream_two_ref_count = 0;
+  multi_data->segments[0].control_block = ustream_instance->control_block;
+  multi_data->segments[0].inner_current_position = ustream_instance->inner_current_position;
+  multi_data->segments[0].inner_first_valid_position
+      = ustream_instance->inner_first_valid_position;
+  multi_data->segments[0].length = ustream_instance->length;
+  multi_data->segments[0].offset_diff = ustream_instance->offset_diff;
+  multi_data->segments_end[0] = ustream_instance->length;
+  multi_data->segments_count = 1;
+  multi_data->current_segment = 0;
 
   az_pal_os_lock_init(&multi_data->lock);
 
@@ -310,6 +483,60 @@ static void ustream_multi_init(
   ustream_instance->control_block = control_block;
 }
 
+/* Returns the multidata of the provided instance if the concat can append a segment to it, or
+ * `NULL` if it shall create a new multidata. The concat can append to a multi ustream with free
+ * segments that no other instance uses, and that was not split, so the new segment starts at the
+ * end of the last one. */
+static az_ulib_ustream_multi_data_cb* get_multi_data_to_append(az_ulib_ustream* ustream_instance)
+{
+  az_ulib_ustream_multi_data_cb* multi_data = NULL;
+
+  if (AZ_ULIB_USTREAM_IS_TYPE_OF(ustream_instance, api)
+      && (AZ_ULIB_PORT_ATOMIC_LOAD_W(&(ustream_instance->control_block->ref_count)) == 1))
+  {
+    /* In multidata, `ptr` points to a internal multidata control block, and the multidata code
+     * needs write permission to execute its function. So, we have an Warning exception here to
+     * remove the `const` qualification of the `ptr`. */
+    IGNORE_CAST_QUALIFICATION
+    multi_data = (az_ulib_ustream_multi_data_cb*)ustream_instance->control_block->ptr;
+    RESUME_WARNINGS
+    if ((multi_data->segments_count >= AZ_ULIB_CONFIG_USTREAM_MULTI_SEGMENTS)
+        || (multi_data->segments_end[multi_data->segments_count - 1] != ustream_instance->length))
+    {
+      multi_data = NULL;
+    }
+  }
+
+  return multi_data;
+}
+
+static az_result append_segment(
+    az_ulib_ustream* ustream_instance,
+    az_ulib_ustream_multi_data_cb* multi_data,
+    az_ulib_ustream* ustream_to_concat)
+{
+  az_result result;
+
+  az_ulib_ustream* segment = &(multi_data->segments[multi_data->segments_count]);
+  if ((result = az_ulib_ustream_clone(segment, ustream_to_concat, ustream_instance->length))
+      == AZ_OK)
+  {
+    size_t remaining_size;
+    if ((result = az_ulib_ustream_get_remaining_size(segment, &remaining_size)) == AZ_OK)
+    {
+      ustream_instance->length += remaining_size;
+      multi_data->segments_end[multi_data->segments_count] = ustream_instance->length;
+      multi_data->segments_count++;
+    }
+    else
+    {
+      az_ulib_ustream_dispose(segment);
+    }
+  }
+
+  return result;
+}
+
 AZ_NODISCARD az_result az_ulib_ustream_concat(
     az_ulib_ustream* ustream_instance,
     az_ulib_ustream* ustream_to_concat,
@@ -322,23 +549,22 @@ AZ_NODISCARD az_result az_ulib_ustream_concat(
 
   az_result result;
 
-  ustream_multi_init(ustream_instance, &multi_data->control_block, multi_data, multi_data_release);
-  if ((result = az_ulib_ustream_clone(
-           &multi_data->ustream_two, ustream_to_concat, ustream_instance->length))
-      == AZ_OK)
+  az_ulib_ustream_multi_data_cb* current_multi_data = get_multi_data_to_append(ustream_instance);
+  if (current_multi_data != NULL)
   {
-    size_t remaining_size;
-    if ((result = az_ulib_ustream_get_remaining_size(&(multi_data->ustream_two), &remaining_size))
-        == AZ_OK)
+    /* Collapse the concat in the current multidata, the provided one is not used. */
+    result = append_segment(ustream_instance, current_multi_data, ustream_to_concat);
+    if (multi_data_release != NULL)
     {
-      ustream_instance->length += remaining_size;
-      AZ_ULIB_PORT_ATOMIC_INC_W(&(multi_data->ustream_two_ref_count));
-    }
-    else
-    {
-      az_ulib_ustream_dispose(&(multi_data->ustream_two));
+      multi_data_release(multi_data);
     }
   }
+  else
+  {
+    ustream_multi_init(
+        ustream_instance, &multi_data->control_block, multi_data, multi_data_release);
+    result = append_segment(ustream_instance, multi_data, ustream_to_concat);
+  }
 
   return result;
 }
@@ -399,3 +625,108 @@ AZ_NODISCARD az_result az_ulib_ustream_split(
 
   return result;
 }
+
+AZ_NODISCARD az_result
+az_ulib_ustream_peek(az_ulib_ustream* ustream_instance, az_span buffer, az_span* const span)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(span);
+
+  *span = AZ_SPAN_EMPTY;
+
+  az_result result = (ustream_instance->control_block->api->peek == NULL)
+      ? AZ_ERROR_NOT_SUPPORTED
+      : ustream_instance->control_block->api->peek(ustream_instance, span);
+
+  /* Copying fallback for the ustreams that cannot expose their memory. */
+  if ((result == AZ_ERROR_NOT_SUPPORTED) && (az_span_size(buffer) > 0))
+  {
+    offset_t position;
+    size_t size;
+    if ((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_OK)
+    {
+      if ((result = az_ulib_ustream_read(
+               ustream_instance, az_span_ptr(buffer), (size_t)az_span_size(buffer), &size))
+          == AZ_OK)
+      {
+        *span = az_span_slice(buffer, 0, (int32_t)size);
+        result = az_ulib_ustream_set_position(ustream_instance, position);
+      }
+    }
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ustream_advance(az_ulib_ustream* ustream_instance, size_t size)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+
+  az_result result;
+
+  offset_t position;
+  size_t remaining_size;
+  if ((result = az_ulib_ustream_get_position(ustream_instance, &position)) == AZ_OK)
+  {
+    if ((result = az_ulib_ustream_get_remaining_size(ustream_instance, &remaining_size)) == AZ_OK)
+    {
+      result = (size > remaining_size)
+          ? AZ_ERROR_ITEM_NOT_FOUND
+          : az_ulib_ustream_set_position(ustream_instance, position + (offset_t)size);
+    }
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_ulib_ustream_readv(
+    az_ulib_ustream* ustream_instance,
+    const az_span* const buffers,
+    size_t buffers_count,
+    size_t* const size)
+{
+  _az_PRECONDITION_NOT_NULL(ustream_instance);
+  _az_PRECONDITION_NOT_NULL(buffers);
+  _az_PRECONDITION(buffers_count > 0);
+  _az_PRECONDITION_NOT_NULL(size);
+
+  az_result result;
+
+  if (ustream_instance->control_block->api->readv != NULL)
+  {
+    result = ustream_instance->control_block->api->readv(
+        ustream_instance, buffers, buffers_count, size);
+  }
+  else
+  {
+    /* Generic fallback, one read for each buffer until the ustream ends. */
+    *size = 0;
+    result = AZ_OK;
+    for (size_t i = 0; (i < buffers_count) && (result == AZ_OK); i++)
+    {
+      size_t buffer_length = (size_t)az_span_size(buffers[i]);
+      size_t buffer_offset = 0;
+      while ((result == AZ_OK) && (buffer_offset < buffer_length))
+      {
+        size_t copied_size;
+        if ((result = az_ulib_ustream_read(
+                 ustream_instance,
+                 az_span_ptr(buffers[i]) + buffer_offset,
+                 buffer_length - buffer_offset,
+                 &copied_size))
+            == AZ_OK)
+        {
+          buffer_offset += copied_size;
+          *size += copied_size;
+        }
+      }
+    }
+
+    if (*size != 0)
+    {
+      result = AZ_OK;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "az_ulib_config.h"
+#include "az_ulib_pal_api.h"
+#include "az_ulib_ustream_pool.h"
+
+#include <azure/core/internal/az_precondition_internal.h>
+
+#if (AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB >= 32767) \
+    || (AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB >= 32767)
+#error "The ustream pool supports up to 32766 blocks of each type."
+#endif
+
+/*
+ * Each block type has a free list of block indexes. The `head` keeps the index of the first free
+ * block in the lower 15 bits, and a tag in the next 16 bits. Every change in the `head` increments
+ * the tag, so a thread that read the `head` and the `next` of the first block, and was preempted
+ * while other threads took and returned the same block, fails the compare and exchange instead of
+ * restoring a stale `next` to the list (the ABA problem). The `head` is a `long`, so it fits in the
+ * atomics of all ports.
+ *
+ * Blocks that were never allocated are not in the free list, they are taken in order using the
+ * `unused` counter, so the pool needs no initialization.
+ */
+#define POOL_INDEX_MASK 0x7FFFL
+#define POOL_TAG_INCREMENT 0x8000L
+#define POOL_TAG_MASK 0x7FFF8000L
+#define POOL_END POOL_INDEX_MASK
+
+typedef struct
+{
+  volatile long head;
+  volatile long unused;
+  volatile long* next;
+  long size;
+} pool_free_list;
+
+static az_ulib_ustream_data_cb data_cb_blocks[AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB];
+static volatile long data_cb_next[AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB];
+static pool_free_list data_cb_pool
+    = { POOL_END, 0, data_cb_next, AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB };
+
+static az_ulib_ustream_multi_data_cb
+    multi_data_cb_blocks[AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB];
+static volatile long multi_data_cb_next[AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB];
+static pool_free_list multi_data_cb_pool
+    = { POOL_END, 0, multi_data_cb_next, AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB };
+
+static long pool_pop(pool_free_list* pool)
+{
+  long head = AZ_ULIB_PORT_ATOMIC_LOAD_ACQUIRE_W(&pool->head);
+  while ((head & POOL_INDEX_MASK) != POOL_END)
+  {
+    long index = head & POOL_INDEX_MASK;
+    long new_head = ((head + POOL_TAG_INCREMENT) & POOL_TAG_MASK)
+        | AZ_ULIB_PORT_ATOMIC_LOAD_W(&pool->next[index]);
+    if (AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(&pool->head, &head, new_head))
+    {
+      return index;
+    }
+  }
+
+  long unused = AZ_ULIB_PORT_ATOMIC_LOAD_W(&pool->unused);
+  while (unused < pool->size)
+  {
+    if (AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(&pool->unused, &unused, unused + 1))
+    {
+      return unused;
+    }
+  }
+
+  return POOL_END;
+}
+
+static void pool_push(pool_free_list* pool, long index)
+{
+  long head = AZ_ULIB_PORT_ATOMIC_LOAD_W(&pool->head);
+  do
+  {
+    AZ_ULIB_PORT_ATOMIC_STORE_W(&pool->next[index], head & POOL_INDEX_MASK);
+  } while (!AZ_ULIB_PORT_ATOMIC_COMPARE_EXCHANGE_W(
+      &pool->head, &head, ((head + POOL_TAG_INCREMENT) & POOL_TAG_MASK) | index));
+}
+
+/* Returns the index of the block, or -1 if the pointer is not a block of the pool. */
+static long get_block_index(
+    const void* release_pointer,
+    const void* blocks,
+    size_t block_size,
+    long size)
+{
+  uintptr_t address = (uintptr_t)release_pointer;
+  uintptr_t first = (uintptr_t)blocks;
+
+  if ((address < first) || (((address - first) % block_size) != 0)
+      || (((address - first) / block_size) >= (uintptr_t)size))
+  {
+    return -1;
+  }
+
+  return (long)((address - first) / block_size);
+}
+
+AZ_NODISCARD az_ulib_ustream_data_cb* az_ulib_ustream_pool_alloc_data_cb(void)
+{
+  long index = pool_pop(&data_cb_pool);
+  return (index == POOL_END) ? NULL : &data_cb_blocks[index];
+}
+
+void az_ulib_ustream_pool_release_data_cb(void* release_pointer)
+{
+  long index = get_block_index(
+      release_pointer,
+      data_cb_blocks,
+      sizeof(az_ulib_ustream_data_cb),
+      AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB);
+  _az_PRECONDITION(index >= 0);
+
+  pool_push(&data_cb_pool, index);
+}
+
+AZ_NODISCARD az_ulib_ustream_multi_data_cb* az_ulib_ustream_pool_alloc_multi_data_cb(void)
+{
+  long index = pool_pop(&multi_data_cb_pool);
+  return (index == POOL_END) ? NULL : &multi_data_cb_blocks[index];
+}
+
+void az_ulib_ustream_pool_release_multi_data_cb(void* release_pointer)
+{
+  long index = get_block_index(
+      release_pointer,
+      multi_data_cb_blocks,
+      sizeof(az_ulib_ustream_multi_data_cb),
+      AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB);
+  _az_PRECONDITION(index >= 0);
+
+  pool_push(&multi_data_cb_pool, index);
+}
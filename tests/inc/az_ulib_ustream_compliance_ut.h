@@ -2197,6 +2197,235 @@ static void az_ulib_ustream_reset_compliance_cloned_buffer_succeed(void** state)
   (void)az_ulib_ustream_dispose(&ustream_instance_clone);
 }
 
+/* The peek shall return the next data in the ustream, and do not change the current position. */
+static void az_ulib_ustream_peek_compliance_new_buffer_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+  az_span span;
+
+  /// act
+  az_result result = az_ulib_ustream_peek(
+      &ustream_instance, AZ_SPAN_FROM_BUFFER(buf_result), &span);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_size(span) > 0);
+  assert_true(az_span_size(span) <= USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, az_span_ptr(span), (size_t)az_span_size(span));
+  check_buffer(
+      &ustream_instance,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The peek and advance shall run over the full content of the ustream. */
+static void az_ulib_ustream_peek_compliance_peek_and_advance_full_buffer_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result[USTREAM_COMPLIANCE_LENGTH_1];
+  uint8_t content[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+  size_t content_length = 0;
+  az_span span;
+  az_result result;
+
+  /// act
+  while ((result = az_ulib_ustream_peek(&ustream_instance, AZ_SPAN_FROM_BUFFER(buf_result), &span))
+         == AZ_OK)
+  {
+    assert_true(content_length + (size_t)az_span_size(span) <= sizeof(content));
+    (void)memcpy(&content[content_length], az_span_ptr(span), (size_t)az_span_size(span));
+    content_length += (size_t)az_span_size(span);
+    assert_int_equal(
+        az_ulib_ustream_advance(&ustream_instance, (size_t)az_span_size(span)), AZ_OK);
+  }
+
+  /// assert
+  assert_int_equal(result, AZ_ULIB_EOF);
+  assert_int_equal(az_span_size(span), 0);
+  assert_int_equal(content_length, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, content, content_length);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the current position is at the end of the ustream, the peek shall return AZ_ULIB_EOF. */
+static void az_ulib_ustream_peek_compliance_end_of_buffer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+  az_span span;
+  assert_int_equal(
+      az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_peek(
+      &ustream_instance, AZ_SPAN_FROM_BUFFER(buf_result), &span);
+
+  /// assert
+  assert_int_equal(result, AZ_ULIB_EOF);
+  assert_int_equal(az_span_size(span), 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The advance shall move the current position forward. */
+static void az_ulib_ustream_advance_compliance_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+  /// act
+  az_result result = az_ulib_ustream_advance(&ustream_instance, USTREAM_COMPLIANCE_LENGTH_1);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  check_buffer(
+      &ustream_instance,
+      USTREAM_COMPLIANCE_LENGTH_1,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the provided size is bigger than the remaining size, the advance shall return
+ * AZ_ERROR_ITEM_NOT_FOUND, and do not change the current position. */
+static void az_ulib_ustream_advance_compliance_out_of_the_buffer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+
+  /// act
+  az_result result
+      = az_ulib_ustream_advance(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 1);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  check_buffer(
+      &ustream_instance,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall fill the buffers in order, with the full content of the ustream. */
+static void az_ulib_ustream_readv_compliance_full_buffer_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result_1[USTREAM_COMPLIANCE_LENGTH_1];
+  uint8_t buf_result_2[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+  az_span buffers[3] = { AZ_SPAN_FROM_BUFFER(buf_result_1),
+                         AZ_SPAN_EMPTY,
+                         AZ_SPAN_FROM_BUFFER(buf_result_2) };
+  size_t size_result;
+
+  /// act
+  az_result result = az_ulib_ustream_readv(&ustream_instance, buffers, 3, &size_result);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size_result, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result_1, USTREAM_COMPLIANCE_LENGTH_1);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + USTREAM_COMPLIANCE_LENGTH_1,
+      buf_result_2,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - USTREAM_COMPLIANCE_LENGTH_1);
+  assert_int_equal(
+      az_ulib_ustream_read(
+          &ustream_instance, buf_result_2, USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH, &size_result),
+      AZ_ULIB_EOF);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* The readv shall stop when the buffers are full, and the next read shall continue from there. */
+static void az_ulib_ustream_readv_compliance_buffers_smaller_than_buffer_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result[USTREAM_COMPLIANCE_LENGTH_2];
+  az_span buffers[2] = { az_span_create(buf_result, USTREAM_COMPLIANCE_LENGTH_1),
+                         az_span_create(
+                             buf_result + USTREAM_COMPLIANCE_LENGTH_1,
+                             USTREAM_COMPLIANCE_LENGTH_1) };
+  size_t size_result;
+
+  /// act
+  az_result result = az_ulib_ustream_readv(&ustream_instance, buffers, 2, &size_result);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size_result, USTREAM_COMPLIANCE_LENGTH_2);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, USTREAM_COMPLIANCE_LENGTH_2);
+  check_buffer(
+      &ustream_instance,
+      USTREAM_COMPLIANCE_LENGTH_2,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
+/* If the current position is at the end of the ustream, the readv shall return AZ_ULIB_EOF. */
+static void az_ulib_ustream_readv_compliance_end_of_buffer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  USTREAM_COMPLIANCE_TARGET_FACTORY(&ustream_instance);
+  uint8_t buf_result[USTREAM_COMPLIANCE_TEMP_BUFFER_LENGTH];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buf_result) };
+  size_t size_result;
+  assert_int_equal(
+      az_ulib_ustream_set_position(&ustream_instance, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_readv(&ustream_instance, buffers, 1, &size_result);
+
+  /// assert
+  assert_int_equal(result, AZ_ULIB_EOF);
+  assert_int_equal(size_result, 0);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
 #define AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST                                         \
   cmocka_unit_test(az_ulib_ustream_dispose_compliance_null_buffer_failed),                      \
       cmocka_unit_test(az_ulib_ustream_dispose_compliance_buffer_is_not_type_of_buffer_failed), \
@@ -2375,6 +2604,22 @@ static void az_ulib_ustream_reset_compliance_cloned_buffer_succeed(void** state)
       cmocka_unit_test_setup_teardown(                                                                                                  \
           az_ulib_ustream_reset_compliance_back_position_succeed, setup, teardown),                                                     \
       cmocka_unit_test_setup_teardown(                                                                                                  \
-          az_ulib_ustream_reset_compliance_cloned_buffer_succeed, setup, teardown),
+          az_ulib_ustream_reset_compliance_cloned_buffer_succeed, setup, teardown),                                                     \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_peek_compliance_new_buffer_succeed, setup, teardown),                                                         \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_peek_compliance_peek_and_advance_full_buffer_succeed, setup, teardown),                                       \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_peek_compliance_end_of_buffer_failed, setup, teardown),                                                       \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_advance_compliance_succeed, setup, teardown),                                                                 \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_advance_compliance_out_of_the_buffer_failed, setup, teardown),                                                \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_readv_compliance_full_buffer_succeed, setup, teardown),                                                       \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_readv_compliance_buffers_smaller_than_buffer_succeed, setup, teardown),                                       \
+      cmocka_unit_test_setup_teardown(                                                                                                  \
+          az_ulib_ustream_readv_compliance_end_of_buffer_failed, setup, teardown),
 
 #endif /* AZ_ULIB_USTREAM_COMPLIANCE_UT_H */
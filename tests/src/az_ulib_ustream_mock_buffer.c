@@ -160,7 +160,8 @@ static az_result concrete_dispose(az_ulib_ustream* ustream_instance)
 
 static const az_ulib_ustream_interface api
     = { concrete_set_position, concrete_reset,   concrete_read,  concrete_get_remaining_size,
-        concrete_get_position, concrete_release, concrete_clone, concrete_dispose };
+        concrete_get_position, concrete_release, concrete_clone, concrete_dispose,
+        NULL,                  NULL };
 
 static az_ulib_ustream_data_cb USTREAM_COMPLIANCE_MOCK_CONTROL_BLOCK
     = { .api = (const az_ulib_ustream_interface*)&api,
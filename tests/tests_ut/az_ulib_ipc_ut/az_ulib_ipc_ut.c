@@ -26,32 +26,52 @@
 
 #include "cmocka.h"
 
-az_ulib_pal_os_lock* g_lock;
+az_ulib_pal_os_rwlock* g_lock;
 int8_t g_lock_diff;
 int8_t g_count_acquire;
+int8_t g_count_acquire_shared;
+int8_t g_count_wait;
 int8_t g_count_sleep;
-void az_pal_os_lock_init(az_ulib_pal_os_lock* lock) { g_lock = lock; }
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock) { g_lock = rwlock; }
 
-void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
   {
     g_lock = NULL;
   }
 }
 
-void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
   {
     g_lock_diff++;
     g_count_acquire++;
+    g_count_acquire_shared++;
   }
 }
 
-void az_pal_os_lock_release(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
+  {
+    g_lock_diff--;
+  }
+}
+
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  if (rwlock == g_lock)
+  {
+    g_lock_diff++;
+    g_count_acquire++;
+  }
+}
+
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  if (rwlock == g_lock)
   {
     g_lock_diff--;
   }
@@ -63,6 +83,73 @@ void az_pal_os_sleep(uint32_t sleep_time_ms)
   g_count_sleep++;
 }
 
+az_ulib_pal_os_event* g_event;
+int8_t g_count_event_set;
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state)
+{
+  (void)manual_reset;
+  (void)initial_state;
+  g_event = event;
+  return AZ_OK;
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event)
+{
+  if (event == g_event)
+  {
+    g_event = NULL;
+  }
+}
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  if (event == g_event)
+  {
+    g_count_event_set++;
+  }
+}
+
+void az_pal_os_event_reset(az_ulib_pal_os_event* event) { (void)event; }
+
+/* The clock only moves when the unpublish waits. */
+uint64_t g_time_ns;
+uint64_t az_pal_os_get_time_ns(void) { return g_time_ns; }
+
+/* Unless the test provides a handle to release while the unpublish waits, nobody releases the
+ * interface, so the wait always times out. */
+az_ulib_ipc_interface_handle* g_release_on_wait;
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  (void)event;
+  g_count_wait++;
+  if (g_release_on_wait != NULL)
+  {
+    assert_int_equal(az_ulib_ipc_release_interface(*g_release_on_wait), AZ_OK);
+    g_release_on_wait = NULL;
+    return AZ_OK;
+  }
+  g_time_ns += (uint64_t)wait_option_ms * 1000000;
+  return AZ_ERROR_ULIB_TIMEOUT;
+}
+
+az_result az_pal_os_thread_create(
+    az_ulib_pal_start_function_ptr function_ptr,
+    az_ulib_pal_thread_args args,
+    az_ulib_pal_thread_handle* handle)
+{
+  (void)function_ptr;
+  (void)args;
+  (void)handle;
+  return AZ_ERROR_NOT_SUPPORTED;
+}
+
+az_result az_pal_os_thread_join(az_ulib_pal_thread_handle handle, int* res)
+{
+  (void)handle;
+  (void)res;
+  return AZ_OK;
+}
+
 static az_ulib_ipc_control_block g_ipc;
 
 #define assert_handle_equal(h1, h2)                                         \
@@ -131,7 +218,12 @@ static int setup(void** state)
   g_lock = NULL;
   g_lock_diff = 0;
   g_count_acquire = 0;
+  g_count_acquire_shared = 0;
   g_count_sleep = 0;
+  g_count_wait = 0;
+  g_time_ns = 0;
+  g_count_event_set = 0;
+  g_release_on_wait = NULL;
 
   return 0;
 }
@@ -1142,6 +1234,7 @@ static void az_ulib_ipc_publish_succeed(void** state)
   az_ulib_ipc_interface_handle default_interface_handle = { 0 };
   assert_int_equal(az_ulib_ipc_init(&g_ipc), AZ_OK);
   g_count_acquire = 0;
+  g_count_acquire_shared = 0;
 
   /// act
   assert_int_equal(az_ulib_test_my_interface_a_1_1_123_publish(), AZ_OK);
@@ -1153,6 +1246,7 @@ static void az_ulib_ipc_publish_succeed(void** state)
   /// assert
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 5);
+  assert_int_equal(g_count_acquire_shared, 0);
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
           AZ_SPAN_EMPTY,
@@ -1372,6 +1466,7 @@ static void az_ulib_ipc_set_default_succeed(void** state)
           &default_interface_handle),
       AZ_ERROR_ITEM_NOT_FOUND);
   g_count_acquire = 0;
+  g_count_acquire_shared = 0;
 
   /// act
   az_result result = az_ulib_ipc_set_default(
@@ -1383,6 +1478,7 @@ static void az_ulib_ipc_set_default_succeed(void** state)
   /// assert
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 0);
   assert_int_equal(result, AZ_OK);
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
@@ -1649,6 +1745,7 @@ static void az_ulib_ipc_unpublish_succeed(void** state)
   /// assert
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 7);
+  assert_int_equal(g_count_acquire_shared, 0);
   az_ulib_ipc_interface_handle interface_handle = { 0 };
   assert_int_equal(
       az_ulib_ipc_try_get_interface(
@@ -1882,7 +1979,8 @@ static void az_ulib_ipc_unpublish_with_capability_running_with_small_timeout_fai
   assert_int_equal(result, AZ_OK);
   assert_int_equal(out, AZ_ERROR_ULIB_BUSY);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, g_count_sleep + 1);
+  assert_int_equal(g_count_acquire, g_count_wait + 1);
+  assert_int_equal(g_time_ns, (uint64_t)in.wait_policy_ms * 1000000);
 
   /// cleanup
   assert_int_equal(az_ulib_ipc_release_interface(interface_handle), AZ_OK);
@@ -1922,6 +2020,41 @@ static void az_ulib_ipc_unpublish_with_valid_interface_instance_failed(void** st
   unpublish_interfaces_and_deinit_ipc();
 }
 
+/* If the last instance of an interface on hold is released while the az_ulib_ipc_unpublish
+ * waits, the az_ulib_ipc_release_interface shall set the released event once, and the
+ * az_ulib_ipc_unpublish shall return AZ_OK. */
+static void az_ulib_ipc_unpublish_with_instance_released_while_waiting_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_ipc_and_publish_interfaces();
+
+  az_ulib_ipc_interface_handle interface_handle = { 0 };
+  assert_int_equal(
+      az_ulib_ipc_try_get_interface(
+          AZ_SPAN_EMPTY,
+          AZ_SPAN_FROM_STR(MY_PACKAGE_A_NAME),
+          MY_PACKAGE_1_VERSION,
+          AZ_SPAN_FROM_STR(MY_INTERFACE_1_NAME),
+          MY_INTERFACE_123_VERSION,
+          &interface_handle),
+      AZ_ULIB_RENEW);
+  g_release_on_wait = &interface_handle;
+
+  /// act
+  az_result result = az_ulib_test_my_interface_a_1_1_123_unpublish(AZ_ULIB_WAIT_FOREVER);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_wait, 1);
+  assert_int_equal(g_count_event_set, 1);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  assert_int_equal(az_ulib_test_my_interface_a_1_1_123_publish(), AZ_OK);
+  unpublish_interfaces_and_deinit_ipc();
+}
+
 /* If one of the capability in the interface is running, the wait policy is different than
  * AZ_ULIB_NO_WAIT and the call ends before the timeout, the az_ulib_ipc_unpublish shall return
  * AZ_OK. */
@@ -1965,6 +2098,7 @@ static void az_ulib_ipc_try_get_interface_succeed(void** state)
   /// assert
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 2);
+  assert_int_equal(g_count_acquire_shared, 2);
   assert_handle_not_equal(lowest_version, highest_version);
 
   /// cleanup
@@ -2314,6 +2448,7 @@ static void az_ulib_ipc_release_interface_succeed(void** state)
           &interface_handle),
       AZ_ULIB_RENEW);
   g_count_acquire = 0;
+  g_count_acquire_shared = 0;
 
   /// act
   az_result result = az_ulib_ipc_release_interface(interface_handle);
@@ -2322,6 +2457,7 @@ static void az_ulib_ipc_release_interface_succeed(void** state)
   assert_int_equal(result, AZ_OK);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 1);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
@@ -2657,6 +2793,7 @@ static void az_ulib_ipc_query_succeed(void** state)
   assert_int_equal(token, 0x000a00FF);
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 1);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
@@ -2807,6 +2944,7 @@ static void az_ulib_ipc_query_next_succeed(void** state)
 
   assert_int_equal(g_lock_diff, 0);
   assert_int_equal(g_count_acquire, 5);
+  assert_int_equal(g_count_acquire_shared, 5);
 
   /// cleanup
   unpublish_interfaces_and_deinit_ipc();
@@ -2958,6 +3096,8 @@ int az_ulib_ipc_ut()
         az_ulib_ipc_unpublish_with_capability_running_with_small_timeout_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_ipc_unpublish_with_valid_interface_instance_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ipc_unpublish_with_instance_released_while_waiting_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_ipc_try_get_interface_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_ipc_try_get_interface_default_name_and_version_succeed, setup, teardown),
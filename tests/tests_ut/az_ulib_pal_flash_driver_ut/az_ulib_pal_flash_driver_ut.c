@@ -0,0 +1,224 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "_az_ulib_pal_flash_driver.h"
+#include "az_ulib_pal_flash_driver_ut.h"
+#include "az_ulib_result.h"
+
+#include "cmocka.h"
+
+#define TEST_FLASH_SIZE 64
+#define TEST_OPERATIONS 4
+
+static uint64_t flash_buffer[TEST_FLASH_SIZE / sizeof(uint64_t)];
+static uint8_t source_buffer[] = "0123456789ABCDEFGHIJ";
+
+typedef struct
+{
+  _az_ulib_pal_flash_driver_operation operation;
+  uint32_t index;
+  uint32_t resubmit_count;
+} test_operation;
+
+static uint32_t g_callback_count;
+static uint32_t g_callback_order[TEST_OPERATIONS * 2];
+static az_result g_callback_result;
+static az_result g_result_in_callback;
+
+static void record_callback(az_result result, void* context)
+{
+  test_operation* test = (test_operation*)context;
+
+  g_result_in_callback = _az_ulib_pal_flash_driver_poll(&test->operation);
+  g_callback_result = result;
+  g_callback_order[g_callback_count++] = test->index;
+
+  if (test->resubmit_count > 0)
+  {
+    test->resubmit_count--;
+    g_callback_result = _az_ulib_pal_flash_driver_erase_async(
+        &test->operation, flash_buffer, TEST_FLASH_SIZE, record_callback, test);
+  }
+}
+
+static int setup(void** state)
+{
+  (void)state;
+
+  (void)memset(flash_buffer, 0xFF, sizeof(flash_buffer));
+  (void)memset(g_callback_order, 0, sizeof(g_callback_order));
+  g_callback_count = 0;
+  g_callback_result = AZ_ULIB_PENDING;
+  g_result_in_callback = AZ_ULIB_PENDING;
+
+  return 0;
+}
+
+static int teardown(void** state)
+{
+  (void)state;
+
+  return 0;
+}
+
+/*
+ * Beginning of the UT for the asynchronous flash operations.
+ */
+
+/* The _az_ulib_pal_flash_driver_write_async shall write the data, padding the last doubleword, and
+ * call the callback before _az_ulib_pal_flash_driver_wait returns. */
+static void _az_ulib_pal_flash_driver_write_async_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_operation test = { .index = 1, .resubmit_count = 0 };
+  uint8_t expected[24];
+  (void)memcpy(expected, source_buffer, 20);
+  (void)memset(&expected[20], 0x00, 4);
+
+  /// act
+  az_result result = _az_ulib_pal_flash_driver_write_async(
+      &test.operation, flash_buffer, source_buffer, 20, 0x00, record_callback, &test);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&test.operation), AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_poll(&test.operation), AZ_OK);
+  assert_int_equal(g_callback_count, 1);
+  assert_int_equal(g_callback_result, AZ_OK);
+  assert_memory_equal(flash_buffer, expected, sizeof(expected));
+  assert_int_equal(((uint8_t*)flash_buffer)[24], 0xFF);
+
+  /// cleanup
+}
+
+/* The _az_ulib_pal_flash_driver_erase_async shall erase the flash, and accept a NULL callback. */
+static void _az_ulib_pal_flash_driver_erase_async_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  _az_ulib_pal_flash_driver_operation operation;
+  uint8_t expected[TEST_FLASH_SIZE];
+  (void)memset(flash_buffer, 0x00, sizeof(flash_buffer));
+  (void)memset(expected, 0xFF, sizeof(expected));
+
+  /// act
+  az_result result = _az_ulib_pal_flash_driver_erase_async(
+      &operation, flash_buffer, TEST_FLASH_SIZE, NULL, NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&operation), AZ_OK);
+  assert_memory_equal(flash_buffer, expected, sizeof(expected));
+
+  /// cleanup
+}
+
+/* The callback shall run before the result of the operation is published. */
+static void _az_ulib_pal_flash_driver_callback_before_result_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_operation test = { .index = 1, .resubmit_count = 0 };
+
+  /// act
+  az_result result = _az_ulib_pal_flash_driver_erase_async(
+      &test.operation, flash_buffer, TEST_FLASH_SIZE, record_callback, &test);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&test.operation), AZ_OK);
+  assert_int_equal(g_callback_count, 1);
+  assert_int_equal(g_result_in_callback, AZ_ULIB_PENDING);
+
+  /// cleanup
+}
+
+/* The asynchronous operations shall complete in the order that they were submitted. */
+static void _az_ulib_pal_flash_driver_operations_in_order_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_operation tests[TEST_OPERATIONS];
+
+  /// act
+  for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+  {
+    tests[i].index = i + 1;
+    tests[i].resubmit_count = 0;
+    assert_int_equal(
+        _az_ulib_pal_flash_driver_write_async(
+            &tests[i].operation,
+            &flash_buffer[i],
+            &source_buffer[i],
+            sizeof(uint64_t),
+            0xFF,
+            record_callback,
+            &tests[i]),
+        AZ_OK);
+  }
+
+  /// assert
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&tests[TEST_OPERATIONS - 1].operation), AZ_OK);
+  for (uint32_t i = 0; i < TEST_OPERATIONS; i++)
+  {
+    assert_int_equal(_az_ulib_pal_flash_driver_poll(&tests[i].operation), AZ_OK);
+    assert_int_equal(g_callback_order[i], i + 1);
+    assert_memory_equal(&flash_buffer[i], &source_buffer[i], sizeof(uint64_t));
+  }
+  assert_int_equal(g_callback_count, TEST_OPERATIONS);
+
+  /// cleanup
+}
+
+/* If the callback submits the same operation again, the operation shall stay pending until the new
+ * run completes, and the driver shall keep running the next operations. */
+static void _az_ulib_pal_flash_driver_resubmit_from_callback_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_operation test = { .index = 1, .resubmit_count = 2 };
+  test_operation next = { .index = 2, .resubmit_count = 0 };
+
+  /// act
+  az_result result = _az_ulib_pal_flash_driver_erase_async(
+      &test.operation, flash_buffer, TEST_FLASH_SIZE, record_callback, &test);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&test.operation), AZ_OK);
+  assert_int_equal(g_callback_count, 3);
+  assert_int_equal(test.resubmit_count, 0);
+  assert_int_equal(
+      _az_ulib_pal_flash_driver_erase_async(
+          &next.operation, flash_buffer, TEST_FLASH_SIZE, record_callback, &next),
+      AZ_OK);
+  assert_int_equal(_az_ulib_pal_flash_driver_wait(&next.operation), AZ_OK);
+  assert_int_equal(g_callback_count, 4);
+  assert_int_equal(g_callback_order[3], 2);
+
+  /// cleanup
+}
+
+int az_ulib_pal_flash_driver_ut()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(_az_ulib_pal_flash_driver_write_async_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(_az_ulib_pal_flash_driver_erase_async_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        _az_ulib_pal_flash_driver_callback_before_result_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        _az_ulib_pal_flash_driver_operations_in_order_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        _az_ulib_pal_flash_driver_resubmit_from_callback_succeed, setup, teardown),
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_pal_flash_driver_ut", tests, NULL, NULL);
+}
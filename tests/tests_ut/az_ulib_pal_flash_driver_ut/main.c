@@ -0,0 +1,16 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include <stdio.h>
+
+#include "az_ulib_pal_flash_driver_ut.h"
+
+int main(void)
+{
+  int result = 0;
+
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_pal_flash_driver_ut.\r\n");
+  result += az_ulib_pal_flash_driver_ut();
+
+  return result;
+}
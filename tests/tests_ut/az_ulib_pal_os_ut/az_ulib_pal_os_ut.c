@@ -0,0 +1,260 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_pal_api.h"
+#include "az_ulib_pal_os_ut.h"
+#include "az_ulib_result.h"
+
+#include "cmocka.h"
+
+#define TEST_WAIT_MS 2000
+#define TEST_DELAY_MS 50
+#define TEST_PERIOD_MS 10
+#define TEST_PERIODIC_RUNS 3
+
+typedef struct
+{
+  az_ulib_pal_os_work work;
+  volatile long count;
+  long signal_at;
+  bool cancel_self;
+  bool reschedule_and_wait;
+  az_result wait_result;
+  az_ulib_pal_os_event done;
+} test_work;
+
+static az_ulib_pal_os_event g_other_ran;
+
+static void test_work_function(void* context)
+{
+  test_work* test = (test_work*)context;
+  long count = AZ_ULIB_PORT_ATOMIC_INC_W(&test->count);
+
+  if (test->cancel_self)
+  {
+    az_pal_os_work_cancel(&test->work);
+  }
+
+  /* Schedule this work again while it runs, and wait for another work queued behind it. */
+  if (test->reschedule_and_wait && (count == 1))
+  {
+    (void)az_pal_os_work_schedule(&test->work, 0, 0);
+    az_pal_os_event_set(&test->done);
+    test->wait_result = az_pal_os_event_wait(&g_other_ran, TEST_WAIT_MS);
+  }
+  else if (count == test->signal_at)
+  {
+    az_pal_os_event_set(&test->done);
+  }
+}
+
+static void other_work_function(void* context)
+{
+  (void)context;
+  az_pal_os_event_set(&g_other_ran);
+}
+
+static void init_test_work(test_work* test)
+{
+  test->count = 0;
+  test->signal_at = 1;
+  test->cancel_self = false;
+  test->reschedule_and_wait = false;
+  test->wait_result = AZ_ULIB_PENDING;
+  assert_int_equal(az_pal_os_event_init(&test->done, true, false), AZ_OK);
+  assert_int_equal(az_pal_os_work_init(&test->work, test_work_function, test), AZ_OK);
+}
+
+static void deinit_test_work(test_work* test)
+{
+  az_pal_os_work_deinit(&test->work);
+  az_pal_os_event_deinit(&test->done);
+}
+
+static int setup(void** state)
+{
+  (void)state;
+
+  assert_int_equal(az_pal_os_work_queue_init(), AZ_OK);
+  assert_int_equal(az_pal_os_event_init(&g_other_ran, true, false), AZ_OK);
+
+  return 0;
+}
+
+static int teardown(void** state)
+{
+  (void)state;
+
+  az_pal_os_event_deinit(&g_other_ran);
+  az_pal_os_work_queue_deinit();
+
+  return 0;
+}
+
+/*
+ * Beginning of the UT for the work queue.
+ */
+
+/* The az_pal_os_work_schedule shall run the work once, after the delay. */
+static void az_pal_os_work_schedule_delayed_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_work test;
+  init_test_work(&test);
+  uint64_t start_ns = az_pal_os_get_time_ns();
+
+  /// act
+  az_result result = az_pal_os_work_schedule(&test.work, TEST_DELAY_MS, 0);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_pal_os_event_wait(&test.done, TEST_WAIT_MS), AZ_OK);
+  assert_true((az_pal_os_get_time_ns() - start_ns) >= ((uint64_t)TEST_DELAY_MS * 1000000ULL));
+  az_pal_os_sleep(TEST_DELAY_MS);
+  assert_int_equal(test.count, 1);
+
+  /// cleanup
+  deinit_test_work(&test);
+}
+
+/* The az_pal_os_work_schedule shall run a periodic work up to az_pal_os_work_cancel. */
+static void az_pal_os_work_schedule_periodic_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_work test;
+  init_test_work(&test);
+  test.signal_at = TEST_PERIODIC_RUNS;
+
+  /// act
+  az_result result = az_pal_os_work_schedule(&test.work, 0, TEST_PERIOD_MS);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_pal_os_event_wait(&test.done, TEST_WAIT_MS), AZ_OK);
+  az_pal_os_work_cancel(&test.work);
+  long count = test.count;
+  assert_true(count >= TEST_PERIODIC_RUNS);
+  az_pal_os_sleep(TEST_PERIOD_MS * 5);
+  assert_int_equal(test.count, count);
+
+  /// cleanup
+  deinit_test_work(&test);
+}
+
+/* The az_pal_os_work_cancel shall drop a work that did not run yet. */
+static void az_pal_os_work_cancel_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_work test;
+  init_test_work(&test);
+  assert_int_equal(az_pal_os_work_schedule(&test.work, TEST_DELAY_MS, 0), AZ_OK);
+
+  /// act
+  az_pal_os_work_cancel(&test.work);
+
+  /// assert
+  az_pal_os_sleep(TEST_DELAY_MS * 2);
+  assert_int_equal(test.count, 0);
+
+  /// cleanup
+  deinit_test_work(&test);
+}
+
+/* A periodic work shall be able to cancel itself from its own function. */
+static void az_pal_os_work_cancel_from_own_function_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_work test;
+  init_test_work(&test);
+  test.cancel_self = true;
+
+  /// act
+  az_result result = az_pal_os_work_schedule(&test.work, 0, TEST_PERIOD_MS);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_pal_os_event_wait(&test.done, TEST_WAIT_MS), AZ_OK);
+  az_pal_os_sleep(TEST_PERIOD_MS * 5);
+  assert_int_equal(test.count, 1);
+
+  /// cleanup
+  deinit_test_work(&test);
+}
+
+/* A work scheduled again while it runs shall not block the works queued behind it. */
+static void az_pal_os_work_schedule_while_running_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  test_work test;
+  az_ulib_pal_os_work other;
+  init_test_work(&test);
+  test.reschedule_and_wait = true;
+  assert_int_equal(az_pal_os_work_init(&other, other_work_function, NULL), AZ_OK);
+  assert_int_equal(az_pal_os_work_schedule(&test.work, 0, 0), AZ_OK);
+  assert_int_equal(az_pal_os_event_wait(&test.done, TEST_WAIT_MS), AZ_OK);
+
+  /// act
+  az_result result = az_pal_os_work_schedule(&other, 0, 0);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_pal_os_event_wait(&g_other_ran, TEST_WAIT_MS), AZ_OK);
+  az_pal_os_work_cancel(&test.work);
+  assert_int_equal(test.wait_result, AZ_OK);
+
+  /// cleanup
+  az_pal_os_work_deinit(&other);
+  deinit_test_work(&test);
+}
+
+/*
+ * Beginning of the UT for the clock.
+ */
+
+/* The az_pal_os_get_ticks shall count the elapsed time at the rate of
+ * az_pal_os_get_ticks_per_second. */
+static void az_pal_os_get_ticks_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t ticks_per_second = az_pal_os_get_ticks_per_second();
+  uint32_t start = az_pal_os_get_ticks();
+
+  /// act
+  az_pal_os_sleep(TEST_DELAY_MS * 2);
+
+  /// assert
+  uint32_t elapsed = az_pal_os_get_ticks() - start;
+  assert_true(elapsed >= ((TEST_DELAY_MS * ticks_per_second) / 1000));
+  assert_true(elapsed < ((TEST_WAIT_MS * ticks_per_second) / 1000));
+
+  /// cleanup
+}
+
+int az_ulib_pal_os_ut()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test_setup_teardown(az_pal_os_work_schedule_delayed_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_pal_os_work_schedule_periodic_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_pal_os_work_cancel_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_pal_os_work_cancel_from_own_function_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_pal_os_work_schedule_while_running_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_pal_os_get_ticks_succeed, setup, teardown),
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_pal_os_ut", tests, NULL, NULL);
+}
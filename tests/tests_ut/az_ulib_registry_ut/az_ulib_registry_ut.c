@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "az_ulib_config.h"
 #include "az_ulib_pal_api.h"
 #include "az_ulib_query_1_model.h"
 #include "az_ulib_registry_api.h"
@@ -20,32 +21,51 @@
 
 #include "cmocka.h"
 
-az_ulib_pal_os_lock* g_lock;
+az_ulib_pal_os_rwlock* g_lock;
 int8_t g_lock_diff;
 int8_t g_count_acquire;
+int8_t g_count_acquire_shared;
 int8_t g_count_sleep;
-void az_pal_os_lock_init(az_ulib_pal_os_lock* lock) { g_lock = lock; }
+void az_pal_os_rwlock_init(az_ulib_pal_os_rwlock* rwlock) { g_lock = rwlock; }
 
-void az_pal_os_lock_deinit(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_deinit(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
   {
     g_lock = NULL;
   }
 }
 
-void az_pal_os_lock_acquire(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_acquire_shared(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
   {
     g_lock_diff++;
     g_count_acquire++;
+    g_count_acquire_shared++;
   }
 }
 
-void az_pal_os_lock_release(az_ulib_pal_os_lock* lock)
+void az_pal_os_rwlock_release_shared(az_ulib_pal_os_rwlock* rwlock)
 {
-  if (lock == g_lock)
+  if (rwlock == g_lock)
+  {
+    g_lock_diff--;
+  }
+}
+
+void az_pal_os_rwlock_acquire_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  if (rwlock == g_lock)
+  {
+    g_lock_diff++;
+    g_count_acquire++;
+  }
+}
+
+void az_pal_os_rwlock_release_exclusive(az_ulib_pal_os_rwlock* rwlock)
+{
+  if (rwlock == g_lock)
   {
     g_lock_diff--;
   }
@@ -57,15 +77,83 @@ void az_pal_os_sleep(uint32_t sleep_time_ms)
   g_count_sleep++;
 }
 
+az_ulib_pal_os_event* g_event;
+int8_t g_count_event_set;
+az_result az_pal_os_event_init(az_ulib_pal_os_event* event, bool manual_reset, bool initial_state)
+{
+  (void)manual_reset;
+  (void)initial_state;
+  g_event = event;
+  return AZ_OK;
+}
+
+void az_pal_os_event_deinit(az_ulib_pal_os_event* event)
+{
+  if (event == g_event)
+  {
+    g_count_sleep = 0;
+  g_event = NULL;
+  }
+}
+
+void az_pal_os_event_set(az_ulib_pal_os_event* event)
+{
+  if (event == g_event)
+  {
+    g_count_event_set++;
+  }
+}
+
+void az_pal_os_event_reset(az_ulib_pal_os_event* event) { (void)event; }
+
+uint64_t az_pal_os_get_time_ns(void) { return 0; }
+
+az_result az_pal_os_event_wait(az_ulib_pal_os_event* event, uint32_t wait_option_ms)
+{
+  (void)event;
+  (void)wait_option_ms;
+  return AZ_ERROR_ULIB_TIMEOUT;
+}
+
+/* The worker thread is never started, so the tests control when the queue is stored. */
+int8_t g_count_thread_create;
+int8_t g_count_thread_join;
+az_result az_pal_os_thread_create(
+    az_ulib_pal_start_function_ptr function_ptr,
+    az_ulib_pal_thread_args args,
+    az_ulib_pal_thread_handle* handle)
+{
+  (void)function_ptr;
+  (void)args;
+  (void)handle;
+  g_count_thread_create++;
+  return AZ_OK;
+}
+
+az_result az_pal_os_thread_join(az_ulib_pal_thread_handle handle, int* res)
+{
+  (void)handle;
+  (void)res;
+  g_count_thread_join++;
+  return AZ_OK;
+}
+
 #ifndef AZ_NO_PRECONDITION_CHECKING
 AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 #define REGISTRY_PAGE_SIZE 0x800
 
+/* The registry memory starts at a page boundary, as it does in a flash. */
+#ifdef _MSC_VER
+#define REGISTRY_PAGE_ALIGNED __declspec(align(REGISTRY_PAGE_SIZE))
+#else
+#define REGISTRY_PAGE_ALIGNED __attribute__((aligned(REGISTRY_PAGE_SIZE)))
+#endif
+
 /* Static memory to store registry information. */
-static uint8_t registry_buffer[REGISTRY_PAGE_SIZE * 2];
-static uint8_t registry_informarmation_buffer[REGISTRY_PAGE_SIZE];
+static REGISTRY_PAGE_ALIGNED uint8_t registry_buffer[REGISTRY_PAGE_SIZE * 2];
+static REGISTRY_PAGE_ALIGNED uint8_t registry_informarmation_buffer[REGISTRY_PAGE_SIZE];
 
 #define __REGISTRY_START (registry_buffer[0])
 #define __REGISTRY_END (registry_buffer[(REGISTRY_PAGE_SIZE * 2)])
@@ -79,6 +167,15 @@ static const az_ulib_registry_control_block registry_cb
         .registry_info_end = (void*)(&__REGISTRYINFO_END),
         .page_size = REGISTRY_PAGE_SIZE };
 
+/* The same registry memory in a flash that accepts a second program of a doubleword. */
+static const az_ulib_registry_control_block registry_cb_reprogrammable
+    = { .registry_start = (void*)(&__REGISTRY_START),
+        .registry_end = (void*)(&__REGISTRY_END),
+        .registry_info_start = (void*)(&__REGISTRYINFO_START),
+        .registry_info_end = (void*)(&__REGISTRYINFO_END),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .reprogrammable = true };
+
 static const az_ulib_registry_control_block registry_cb_2
     = { .registry_start = (void*)(&__REGISTRY_START),
         .registry_end = (void*)(&__REGISTRY_END),
@@ -86,6 +183,99 @@ static const az_ulib_registry_control_block registry_cb_2
         .registry_info_end = (void*)(&__REGISTRYINFO_END),
         .page_size = REGISTRY_PAGE_SIZE };
 
+/* Static memory to store registry checkpoints. */
+static REGISTRY_PAGE_ALIGNED uint8_t registry_checkpoint_buffer[REGISTRY_PAGE_SIZE];
+
+#define __REGISTRYCHECKPOINT_START (registry_checkpoint_buffer[0])
+#define __REGISTRYCHECKPOINT_END (registry_checkpoint_buffer[REGISTRY_PAGE_SIZE])
+
+static const az_ulib_registry_control_block registry_cb_with_checkpoint
+    = { .registry_start = (void*)(&__REGISTRY_START),
+        .registry_end = (void*)(&__REGISTRY_END),
+        .registry_info_start = (void*)(&__REGISTRYINFO_START),
+        .registry_info_end = (void*)(&__REGISTRYINFO_END),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .registry_checkpoint_start = (void*)(&__REGISTRYCHECKPOINT_START),
+        .registry_checkpoint_end = (void*)(&__REGISTRYCHECKPOINT_END) };
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+static const az_ulib_registry_control_block registry_cb_write_behind
+    = { .registry_start = (void*)(&__REGISTRY_START),
+        .registry_end = (void*)(&__REGISTRY_END),
+        .registry_info_start = (void*)(&__REGISTRYINFO_START),
+        .registry_info_end = (void*)(&__REGISTRYINFO_END),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .write_behind = true };
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+
+/* Count the pages erased by the registry, and the erases that cross a page boundary. */
+static uint32_t g_count_erase_callback;
+static uint32_t g_count_erase_across_pages;
+static size_t g_erased_size;
+static void erase_callback(const void* page, size_t page_size)
+{
+  g_count_erase_callback++;
+  g_erased_size += page_size;
+  if ((((uintptr_t)page % REGISTRY_PAGE_SIZE) + page_size) > REGISTRY_PAGE_SIZE)
+  {
+    g_count_erase_across_pages++;
+  }
+}
+
+static const az_ulib_registry_control_block registry_cb_with_erase_callback
+    = { .registry_start = (void*)(&__REGISTRY_START),
+        .registry_end = (void*)(&__REGISTRY_END),
+        .registry_info_start = (void*)(&__REGISTRYINFO_START),
+        .registry_info_end = (void*)(&__REGISTRYINFO_END),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .erase_callback = erase_callback };
+
+/* Registry memory that starts in the middle of a page. */
+static const az_ulib_registry_control_block registry_cb_unaligned_with_erase_callback
+    = { .registry_start = (void*)(&registry_buffer[REGISTRY_PAGE_SIZE / 2]),
+        .registry_end = (void*)(&__REGISTRY_END),
+        .registry_info_start = (void*)(&__REGISTRYINFO_START),
+        .registry_info_end = (void*)(&__REGISTRYINFO_END),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .erase_callback = erase_callback };
+
+/* Static memory to store a second registry instance. */
+static REGISTRY_PAGE_ALIGNED uint8_t registry_buffer_fast[REGISTRY_PAGE_SIZE];
+static REGISTRY_PAGE_ALIGNED uint8_t registry_informarmation_buffer_fast[REGISTRY_PAGE_SIZE];
+
+static const az_ulib_registry_control_block registry_cb_fast
+    = { .registry_start = (void*)(&registry_buffer_fast[0]),
+        .registry_end = (void*)(&registry_buffer_fast[REGISTRY_PAGE_SIZE]),
+        .registry_info_start = (void*)(&registry_informarmation_buffer_fast[0]),
+        .registry_info_end = (void*)(&registry_informarmation_buffer_fast[REGISTRY_PAGE_SIZE]),
+        .page_size = REGISTRY_PAGE_SIZE };
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+/* The second registry memory accessed as an external flash, only through the flash driver. */
+static const az_ulib_registry_control_block registry_cb_external
+    = { .registry_start = (void*)(&registry_buffer_fast[0]),
+        .registry_end = (void*)(&registry_buffer_fast[REGISTRY_PAGE_SIZE]),
+        .registry_info_start = (void*)(&registry_informarmation_buffer_fast[0]),
+        .registry_info_end = (void*)(&registry_informarmation_buffer_fast[REGISTRY_PAGE_SIZE]),
+        .page_size = REGISTRY_PAGE_SIZE,
+        .external_flash = true,
+        .reprogrammable = true };
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
+
+#define IS_IN_REGISTRY_BUFFER(span)                 \
+  ((az_span_ptr(span) >= &registry_buffer[0])       \
+   && (az_span_ptr(span) < &registry_buffer[sizeof(registry_buffer)]))
+
+/* The registry information starts with a 64 bits header. */
+#define REGISTRY_HEADER_SIZE (sizeof(uint64_t))
+
+/* Each registry node contains a ready flag, a delete flag, the data offset, and the key and value
+ * sizes. */
+#define REGISTRY_NODE_SIZE ((sizeof(uint64_t) * 2) + sizeof(uint32_t) + (sizeof(uint16_t) * 2))
+
+/* The legacy registry node contains a ready flag, a delete flag, and the key and value spans. */
+#define REGISTRY_LEGACY_NODE_SIZE ((sizeof(uint64_t) * 2) + (sizeof(az_span) * 2))
+
 const az_span TEST_KEY_1 = AZ_SPAN_LITERAL_FROM_STR("TEST_KEY_1");
 const az_span TEST_VALUE_1 = AZ_SPAN_LITERAL_FROM_STR("TEST_VALUE_1");
 const az_span TEST_KEY_2 = AZ_SPAN_LITERAL_FROM_STR("TEST_KEY_2");
@@ -115,7 +305,11 @@ static int setup(void** state)
   g_lock = NULL;
   g_lock_diff = 0;
   g_count_acquire = 0;
-  g_count_sleep = 0;
+  g_count_acquire_shared = 0;
+  g_event = NULL;
+  g_count_event_set = 0;
+  g_count_thread_create = 0;
+  g_count_thread_join = 0;
 
   return 0;
 }
@@ -299,543 +493,2077 @@ static void az_ulib_registry_add_with_empty_value_failed(void** state)
   az_ulib_registry_deinit();
 }
 
-/* If the registry was not initialized, the az_ulib_registry_clean_all shall fail with
+/* If the registry was not initialized, the az_ulib_registry_update shall fail with
  * precondition. */
-static void az_ulib_registry_clean_all_not_initialized_failed(void** state)
+static void az_ulib_registry_update_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_clean_all());
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_registry_update(TEST_KEY_1, TEST_VALUE_1, NULL));
 
   /// cleanup
 }
 
-/* If the registry was not initialized, the az_ulib_registry_get_info shall fail with
+/* If the provided key is AZ_SPAN_EMPTY, the az_ulib_registry_update shall fail with
  * precondition. */
-static void az_ulib_registry_get_info_not_initialized_failed(void** state)
+static void az_ulib_registry_update_with_empty_key_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb);
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_get_info(&info));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_registry_update(AZ_SPAN_EMPTY, TEST_VALUE_1, NULL));
 
   /// cleanup
+  az_ulib_registry_deinit();
 }
 
-/* If the provided pointer to info is NULL, the az_ulib_registry_get_info shall fail with
+/* If the provided value is AZ_SPAN_EMPTY, the az_ulib_registry_update shall fail with
  * precondition. */
-static void az_ulib_registry_get_info_with_NULL_info_pointer_failed(void** state)
+static void az_ulib_registry_update_with_empty_value_failed(void** state)
 {
   /// arrange
   (void)state;
+  az_ulib_registry_init(&registry_cb);
 
   /// act
   /// assert
-  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_get_info(NULL));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_registry_update(TEST_KEY_1, AZ_SPAN_EMPTY, NULL));
 
   /// cleanup
+  az_ulib_registry_deinit();
 }
 
-#endif // AZ_NO_PRECONDITION_CHECKING
-
-/* The az_ulib_registry_init shall initialize the ipc control block. */
-/* The az_ulib_registry_init shall initialize the lock mechanism. */
-static void az_ulib_registry_init_succeed(void** state)
+/* If the registry was not initialized, the az_ulib_registry_iterate shall fail with
+ * precondition. */
+static void az_ulib_registry_iterate_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
 
   /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value));
+
+  /// cleanup
+}
+
+/* If the provided cursor is NULL, the az_ulib_registry_iterate shall fail with precondition. */
+static void az_ulib_registry_iterate_with_null_cursor_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span key;
+  az_span value;
   az_ulib_registry_init(&registry_cb);
 
+  /// act
   /// assert
-  assert_non_null(g_lock);
-  assert_int_equal(g_lock_diff, 0);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, NULL, &key, &value));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_deinit shall release all resources. */
-static void az_ulib_registry_deinit_succeed(void** state)
+/* If the provided key is NULL, the az_ulib_registry_iterate shall fail with precondition. */
+static void az_ulib_registry_iterate_with_null_key_failed(void** state)
 {
   /// arrange
   (void)state;
+  uint32_t cursor = 0;
+  az_span value;
   az_ulib_registry_init(&registry_cb);
 
   /// act
-  az_ulib_registry_deinit();
-
   /// assert
-  az_ulib_registry_init(&registry_cb);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, NULL, &value));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_delete shall delete the provided key from registry. */
-static void az_ulib_registry_delete_single_key_succeed(void** state)
+/* If the provided value is NULL, the az_ulib_registry_iterate shall fail with precondition. */
+static void az_ulib_registry_iterate_with_null_value_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
+  uint32_t cursor = 0;
+  az_span key;
   az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
-  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
-  g_count_acquire = 0;
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_1);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, NULL));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_delete_first_key_succeed(void** state)
+/* If the registry was not initialized, the az_ulib_registry_clean_all shall fail with
+ * precondition. */
+static void az_ulib_registry_clean_all_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  init_and_add_4_keys();
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_1);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_clean_all());
 
   /// cleanup
-  az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_delete_last_key_succeed(void** state)
+/* If the registry was not initialized, the az_ulib_registry_get_info shall fail with
+ * precondition. */
+static void az_ulib_registry_get_info_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  init_and_add_4_keys();
+  az_ulib_registry_info info;
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_4);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_get_info(&info));
 
   /// cleanup
-  az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_delete_second_key_succeed(void** state)
+/* If the registry was not initialized, the az_ulib_registry_flush shall fail with precondition. */
+static void az_ulib_registry_flush_not_initialized_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  init_and_add_4_keys();
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_2);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_registry_flush());
 
   /// cleanup
-  az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_delete_third_key_succeed(void** state)
+/* If the provided pointer to info is NULL, the az_ulib_registry_get_info shall fail with
+ * precondition. */
+static void az_ulib_registry_get_info_with_NULL_info_pointer_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  init_and_add_4_keys();
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_3);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_registry_get_info(NULL));
 
   /// cleanup
-  az_ulib_registry_deinit();
 }
 
-/* If the provided key does not exist, the az_ulib_registry_delete shall return
- * AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_registry_delete_unknow_key_failed(void** state)
+/* If the provided instance is NULL, the az_ulib_registry_instance_init shall fail with
+ * precondition. */
+static void az_ulib_registry_instance_init_with_null_instance_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  init_and_add_4_keys();
 
   /// act
-  az_result result = az_ulib_registry_delete(TEST_KEY_A);
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(
+      az_ulib_registry_instance_init(NULL, &registry_cb_fast));
+
+  /// cleanup
+}
+
+/* If the instance was not initialized, the az_ulib_registry_instance_add shall fail with
+ * precondition. */
+static void az_ulib_registry_instance_add_not_initialized_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_instance registry = { 0 };
 
+  /// act
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_instance_add(&registry, TEST_KEY_1, TEST_VALUE_1));
 
   /// cleanup
-  az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_try_get_value shall return the stored value for the provided key. */
-static void az_ulib_registry_try_get_value_succeed(void** state)
+/* If the provided value is NULL, the az_ulib_registry_try_get_value_copy shall fail with
+ * precondition. */
+static void az_ulib_registry_try_get_value_copy_with_null_value_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
+  uint8_t buffer[20];
   init_and_add_4_keys();
 
   /// act
-  az_result result = az_ulib_registry_try_get_value(TEST_KEY_1, &value);
-
   /// assert
-  assert_int_equal(result, AZ_OK);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_1, AZ_SPAN_FROM_BUFFER(buffer), NULL));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* If the provided key does not exist, the az_ulib_registry_try_get_value shall return
- * AZ_ERROR_ITEM_NOT_FOUND. */
-static void az_ulib_registry_try_get_value_unknow_key_failed(void** state)
+/* If the writer is not open, the az_ulib_registry_writer_write shall fail with precondition. */
+static void az_ulib_registry_writer_write_closed_writer_failed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_writer writer;
   init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  az_ulib_registry_writer_abort(&writer);
 
   /// act
-  az_result result = az_ulib_registry_try_get_value(TEST_KEY_A, &value);
-
   /// assert
-  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_true(az_span_is_content_equal(value, AZ_SPAN_EMPTY));
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_registry_writer_write(&writer, TEST_VALUE_A));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_add shall store value for the provided key. */
-static void az_ulib_registry_add_succeed(void** state)
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* The az_ulib_registry_init shall initialize the ipc control block. */
+/* The az_ulib_registry_init shall initialize the lock mechanism. */
+static void az_ulib_registry_init_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
-  g_count_acquire = 0;
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1);
+  az_ulib_registry_init(&registry_cb);
 
   /// assert
-  assert_int_equal(result, AZ_OK);
+  assert_non_null(g_lock);
   assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* If the provided key already exist, the az_ulib_registry_add shall return
- * AZ_ERROR_ULIB_ELEMENT_DUPLICATE. */
-static void az_ulib_registry_add_duplicated_key_failed(void** state)
+/* The az_ulib_registry_init shall mark as deleted the entries that were not completely written. */
+static void az_ulib_registry_init_recover_torn_entry_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_span value = AZ_SPAN_EMPTY;
-  az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
+  az_span value;
+  az_ulib_registry_info info;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_A, TEST_VALUE_A), AZ_OK);
+  az_ulib_registry_deinit();
+  /* Simulate a power failure before the ready flag of the last entry was set. */
+  (void)memset(
+      &registry_informarmation_buffer[REGISTRY_HEADER_SIZE + (REGISTRY_NODE_SIZE * 4)],
+      0xFF,
+      sizeof(uint64_t));
+
+  /// act
+  az_ulib_registry_init(&registry_cb);
+
+  /// assert
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_A, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 5);
+  assert_int_equal(info.free_registry_info, info.total_registry_info - 6);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If an update was interrupted before the old entry was deleted, the az_ulib_registry_init shall
+ * delete the old entry and keep the new value. */
+static void az_ulib_registry_init_recover_torn_update_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  az_ulib_registry_update_mode mode;
+  init_and_add_4_keys();
+  az_ulib_registry_get_info(&old_info);
+  assert_int_equal(az_ulib_registry_update(TEST_KEY_2, TEST_VALUE_A, &mode), AZ_OK);
+  assert_int_equal(mode, AZ_ULIB_REGISTRY_UPDATE_APPEND);
+  az_ulib_registry_deinit();
+  /* Simulate a power failure before the delete flag of the old entry was set. */
+  (void)memset(
+      &registry_informarmation_buffer
+          [REGISTRY_HEADER_SIZE + REGISTRY_NODE_SIZE + sizeof(uint64_t)],
+      0xFF,
+      sizeof(uint64_t));
+
+  /// act
+  az_ulib_registry_init(&registry_cb);
+
+  /// assert
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_A));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_2), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_init shall resume from the last checkpoint. */
+static void az_ulib_registry_init_from_checkpoint_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+  az_ulib_registry_get_info(&old_info);
+  az_ulib_registry_deinit();
+
+  /// act
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.in_use_registry_data, old_info.in_use_registry_data);
+  assert_int_equal(info.free_registry_data, old_info.free_registry_data);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_3, TEST_VALUE_3), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_3));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If no entry was added after the last checkpoint, the az_ulib_registry_init shall not read the
+ * nodes before it. */
+static void az_ulib_registry_init_from_checkpoint_skip_old_nodes_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+  az_ulib_registry_deinit();
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+  az_ulib_registry_deinit();
+
+  /* Make the first key equal to the last one. Reading it would look like a torn update. */
+  (void)memcpy(&registry_buffer[0], az_span_ptr(TEST_KEY_2), (size_t)az_span_size(TEST_KEY_2));
+
+  /// act
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+
+  /// assert
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 2);
+  assert_int_equal(info.dead_registry_data, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If an entry was deleted after the last checkpoint, the az_ulib_registry_init shall not use the
+ * checkpoint counters. */
+static void az_ulib_registry_init_with_stale_checkpoint_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+  az_ulib_registry_deinit();
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_1), AZ_OK);
+  az_ulib_registry_deinit();
+
+  /// act
+  az_ulib_registry_init(&registry_cb_with_checkpoint);
+
+  /// assert
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_init shall read the entries stored in the legacy format, and the
+ * az_ulib_registry_add shall only accept new entries after the registry is cleaned. */
+static void az_ulib_registry_init_with_legacy_format_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_span legacy_key = az_span_create(&registry_buffer[0], az_span_size(TEST_KEY_1));
+  az_span legacy_value = az_span_create(&registry_buffer[16], az_span_size(TEST_VALUE_1));
+  (void)memset(registry_buffer, 0xFF, sizeof(registry_buffer));
+  (void)memset(registry_informarmation_buffer, 0xFF, sizeof(registry_informarmation_buffer));
+  az_span_copy(legacy_key, TEST_KEY_1);
+  az_span_copy(legacy_value, TEST_VALUE_1);
+  (void)memset(&registry_informarmation_buffer[0], 0x00, sizeof(uint64_t));
+  (void)memcpy(
+      &registry_informarmation_buffer[sizeof(uint64_t) * 2], &legacy_key, sizeof(az_span));
+  (void)memcpy(
+      &registry_informarmation_buffer[(sizeof(uint64_t) * 2) + sizeof(az_span)],
+      &legacy_value,
+      sizeof(az_span));
+
+  /// act
+  az_ulib_registry_init(&registry_cb);
+
+  /// assert
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(
+      az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the registry header has an unknown version, the az_ulib_registry_init shall not use any
+ * entry. */
+static void az_ulib_registry_init_with_unknown_version_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  init_and_add_4_keys();
+  az_ulib_registry_deinit();
+  (void)memset(&registry_informarmation_buffer[sizeof(uint32_t)], 0x00, sizeof(uint16_t));
+
+  /// act
+  az_ulib_registry_init(&registry_cb);
+
+  /// assert
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_registry_add(TEST_KEY_A, TEST_VALUE_A), AZ_ERROR_ULIB_INCOMPATIBLE_VERSION);
+
+  /// cleanup
+  az_ulib_registry_clean_all();
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_deinit shall release all resources. */
+static void az_ulib_registry_deinit_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb);
+
+  /// act
+  az_ulib_registry_deinit();
+
+  /// assert
+  az_ulib_registry_init(&registry_cb);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_delete shall delete the provided key from registry. */
+static void az_ulib_registry_delete_single_key_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_1);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 0);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_delete_first_key_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_1);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_delete_last_key_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_4);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_delete_second_key_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_2);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_delete_third_key_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_3);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the provided key does not exist, the az_ulib_registry_delete shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_registry_delete_unknow_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_delete(TEST_KEY_A);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_3, &value), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_try_get_value shall return the stored value for the provided key. */
+/* The az_ulib_registry_try_get_value shall not take the registry lock if there is no concurrent
+ * writer. */
+static void az_ulib_registry_try_get_value_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_try_get_value(TEST_KEY_1, &value);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the provided key does not exist, the az_ulib_registry_try_get_value shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_registry_try_get_value_unknow_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_try_get_value(TEST_KEY_A, &value);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 0);
+  assert_true(az_span_is_content_equal(value, AZ_SPAN_EMPTY));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_add shall store value for the provided key. */
+static void az_ulib_registry_add_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+  g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 0);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the provided key already exist, the az_ulib_registry_add shall return
+ * AZ_ERROR_ULIB_ELEMENT_DUPLICATE. */
+static void az_ulib_registry_add_duplicated_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_A);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If there is no more space in the registry info, the az_ulib_registry_add shall return
+ * AZ_ERROR_NOT_ENOUGH_SPACE. */
+static void az_ulib_registry_add_out_of_registry_info_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&info);
+  /* Fill all available registry info. */
+  for (size_t i = 0; i < info.free_registry_info; i++)
+  {
+    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
+    assert_int_equal(az_ulib_registry_add(key, key), AZ_OK);
+  }
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.free_registry_info, 0);
+  assert_int_not_equal(info.free_registry_data, 0);
+
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If there is no more space in the registry data, the az_ulib_registry_add shall return
+ * AZ_ERROR_OUT_OF_MEMORY. */
+static void az_ulib_registry_add_out_of_registry_data_space_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&info);
+  /* Fill all available registry. */
+  uint8_t val[0xff];
+  for (size_t i = 0; i < sizeof(val); i++)
+  {
+    val[i] = 'a';
+  }
+  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
+  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
+  for (size_t i = 0; i < max; i++)
+  {
+    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
+    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
+  }
+  az_ulib_registry_get_info(&info);
+  val_span = az_span_create(
+      val,
+      (int32_t)(info.free_registry_data - (2 * sizeof(uint64_t)))); // TEST_KEY_1 needs 2 x 64bits.
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
+  az_ulib_registry_get_info(&info);
+  assert_int_not_equal(info.free_registry_info, 0);
+  assert_int_equal(info.free_registry_data, 0);
+
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_add_no_space_for_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&info);
+  /* Fill all available registry. */
+  uint8_t val[0xff];
+  for (size_t i = 0; i < sizeof(val); i++)
+  {
+    val[i] = 'a';
+  }
+  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
+  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
+  for (size_t i = 0; i < max; i++)
+  {
+    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
+    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
+  }
+  az_ulib_registry_get_info(&info);
+
+  // TEST_KEY_1 needs 2 x 64bits. Only 1 x 64bits left, and Key needs 2 x 64bits.
+  val_span = az_span_create(val, (int32_t)(info.free_registry_data - (3 * sizeof(uint64_t))));
+
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
+  az_ulib_registry_get_info(&info);
+  assert_int_not_equal(info.free_registry_info, 0);
+  assert_int_equal(info.free_registry_data, 8);
+
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+static void az_ulib_registry_add_space_only_for_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&info);
+  /* Fill all available registry. */
+  uint8_t val[0xff];
+  for (size_t i = 0; i < sizeof(val); i++)
+  {
+    val[i] = 'a';
+  }
+  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
+  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
+  for (size_t i = 0; i < max; i++)
+  {
+    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
+    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
+  }
+  az_ulib_registry_get_info(&info);
+
+  // TEST_KEY_1 needs 2 x 64bits. Only 3 x 64bits left that only fits the Key, but not the value.
+  val_span = az_span_create(val, (int32_t)(info.free_registry_data - (5 * sizeof(uint64_t))));
+
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
+  az_ulib_registry_get_info(&info);
+  assert_int_not_equal(info.free_registry_info, 0);
+  assert_int_equal(info.free_registry_data, 24);
+
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the flash is reprogrammable, and the new value only clears bits of the stored value, the
+ * az_ulib_registry_update shall program the new value in place. */
+static void az_ulib_registry_update_in_place_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t reserved_value[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+  uint8_t new_value[4] = { 0x0F, 0xFF, 0x00, 0xF0 };
+  az_span old_value_span = AZ_SPAN_EMPTY;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_update_mode mode = AZ_ULIB_REGISTRY_UPDATE_APPEND;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  init_and_add_4_keys();
+  az_ulib_registry_deinit();
+  az_ulib_registry_init(&registry_cb_reprogrammable);
+  assert_int_equal(
+      az_ulib_registry_add(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(reserved_value)), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &old_value_span), AZ_OK);
+  az_ulib_registry_get_info(&old_info);
+  g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  az_result result = az_ulib_registry_update(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(new_value), &mode);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(mode, AZ_ULIB_REGISTRY_UPDATE_IN_PLACE);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 0);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_OK);
+  assert_ptr_equal(az_span_ptr(value), az_span_ptr(old_value_span));
+  assert_true(az_span_is_content_equal(value, AZ_SPAN_FROM_BUFFER(new_value)));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.free_registry_data, old_info.free_registry_data);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the flash is not reprogrammable, the az_ulib_registry_update shall append a new entry even if
+ * the new value only clears bits of the stored value. */
+static void az_ulib_registry_update_not_reprogrammable_append_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t reserved_value[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+  uint8_t new_value[4] = { 0x0F, 0xFF, 0x00, 0xF0 };
+  az_span old_value_span = AZ_SPAN_EMPTY;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_update_mode mode = AZ_ULIB_REGISTRY_UPDATE_IN_PLACE;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  init_and_add_4_keys();
+  assert_int_equal(
+      az_ulib_registry_add(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(reserved_value)), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &old_value_span), AZ_OK);
+  az_ulib_registry_get_info(&old_info);
+
+  /// act
+  az_result result = az_ulib_registry_update(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(new_value), &mode);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(mode, AZ_ULIB_REGISTRY_UPDATE_APPEND);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_OK);
+  assert_ptr_not_equal(az_span_ptr(value), az_span_ptr(old_value_span));
+  assert_true(az_span_is_content_equal(value, AZ_SPAN_FROM_BUFFER(new_value)));
+  assert_memory_equal(az_span_ptr(old_value_span), reserved_value, sizeof(reserved_value));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.free_registry_info, old_info.free_registry_info - 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the new value needs to set bits of the stored value, the az_ulib_registry_update shall append
+ * a new entry and delete the old one. */
+static void az_ulib_registry_update_append_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span old_value_span = AZ_SPAN_EMPTY;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_update_mode mode = AZ_ULIB_REGISTRY_UPDATE_IN_PLACE;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &old_value_span), AZ_OK);
+  az_ulib_registry_get_info(&old_info);
+  g_count_acquire = 0;
+
+  /// act
+  az_result result = az_ulib_registry_update(TEST_KEY_2, TEST_VALUE_A, &mode);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(mode, AZ_ULIB_REGISTRY_UPDATE_APPEND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_ptr_not_equal(az_span_ptr(value), az_span_ptr(old_value_span));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_A));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.free_registry_info, old_info.free_registry_info - 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the provided key does not exist, the az_ulib_registry_update shall return
+ * AZ_ERROR_ITEM_NOT_FOUND. */
+static void az_ulib_registry_update_unknow_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result = az_ulib_registry_update(TEST_KEY_A, TEST_VALUE_A, NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the prefix is AZ_SPAN_EMPTY, the az_ulib_registry_iterate shall return all live keys, one per
+ * call, skipping the deleted ones. */
+static void az_ulib_registry_iterate_all_keys_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_2), AZ_OK);
+  g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  /// assert
+  assert_int_equal(az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_1));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_3));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_3));
+  assert_int_equal(az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_4));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_4));
+  assert_int_equal(az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_ULIB_EOF);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 4);
+  assert_int_equal(g_count_acquire_shared, 4);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_iterate shall only return the keys that start with the provided prefix. */
+static void az_ulib_registry_iterate_with_prefix_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_add(AZ_SPAN_FROM_STR("ipc.a"), TEST_VALUE_A), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(AZ_SPAN_FROM_STR("ipc"), TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(AZ_SPAN_FROM_STR("ipc.b"), TEST_VALUE_2), AZ_OK);
+
+  /// act
+  /// assert
+  assert_int_equal(
+      az_ulib_registry_iterate(AZ_SPAN_FROM_STR("ipc."), &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, AZ_SPAN_FROM_STR("ipc.a")));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_A));
+  assert_int_equal(
+      az_ulib_registry_iterate(AZ_SPAN_FROM_STR("ipc."), &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, AZ_SPAN_FROM_STR("ipc.b")));
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+  assert_int_equal(
+      az_ulib_registry_iterate(AZ_SPAN_FROM_STR("ipc."), &cursor, &key, &value), AZ_ULIB_EOF);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the registry is empty, the az_ulib_registry_iterate shall return AZ_ULIB_EOF. */
+static void az_ulib_registry_iterate_empty_registry_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+
+  /// act
+  az_result result = az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value);
+
+  /// assert
+  assert_int_equal(result, AZ_ULIB_EOF);
+  assert_int_equal(cursor, 0);
+  assert_int_equal(g_lock_diff, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_clean_all shall Delete all stored registries. */
+static void az_ulib_registry_clean_all_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_and_add_4_keys();
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&info);
+  assert_int_not_equal(info.in_use_registry_info, 0);
+  g_count_acquire = 0;
+
+  /// act
+  az_ulib_registry_clean_all();
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 0);
+  assert_int_equal(info.in_use_registry_data, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_clean_all shall erase only the pages that are not erased yet, and report
+ * each erased page. */
+static void az_ulib_registry_clean_all_skip_erased_pages_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb_with_erase_callback);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  az_ulib_registry_get_info(&info);
+  uint32_t old_erase_count = info.erase_count;
+  g_count_erase_callback = 0;
+  g_count_erase_across_pages = 0;
+  g_erased_size = 0;
+
+  /// act
+  az_ulib_registry_clean_all();
+
+  /// assert
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.erase_count, old_erase_count + 2);
+  assert_int_equal(g_count_erase_callback, 2);
+  assert_int_equal(g_erased_size, REGISTRY_PAGE_SIZE * 2);
+  assert_int_equal(info.in_use_registry_info, 0);
+
+  /* Only the registry information page with the header is not erased now. */
+  az_ulib_registry_clean_all();
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.erase_count, old_erase_count + 3);
+  assert_int_equal(g_count_erase_callback, 3);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the registry memory does not start at a page boundary, the az_ulib_registry_clean_all shall
+ * erase each page only once, with no erase across a page boundary. */
+static void az_ulib_registry_clean_all_unaligned_memory_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb_unaligned_with_erase_callback);
+  (void)memset(registry_buffer, 0x00, sizeof(registry_buffer));
+  g_count_erase_callback = 0;
+  g_count_erase_across_pages = 0;
+  g_erased_size = 0;
+
+  /// act
+  az_ulib_registry_clean_all();
+
+  /// assert
+  assert_int_equal(g_count_erase_across_pages, 0);
+  assert_int_equal(g_count_erase_callback, 3);
+  assert_int_equal(g_erased_size, (REGISTRY_PAGE_SIZE * 2) + (REGISTRY_PAGE_SIZE / 2));
+  assert_int_equal(registry_buffer[REGISTRY_PAGE_SIZE / 2], 0xFF);
+  assert_int_equal(registry_buffer[(REGISTRY_PAGE_SIZE * 2) - 1], 0xFF);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+  (void)memset(registry_buffer, 0xFF, sizeof(registry_buffer));
+}
+
+/* The az_ulib_registry_get_info shall return the registry information in the #az_ulib_registry_info
+ * structure. */
+static void az_ulib_registry_get_info_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_and_add_4_keys();
+  az_ulib_registry_info info;
+  g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  az_ulib_registry_get_info(&info);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(g_count_acquire_shared, 1);
+  assert_int_not_equal(info.total_registry_info, 0);
+  assert_int_equal(info.in_use_registry_info, 4);
+  assert_int_equal(info.free_registry_info, info.total_registry_info - info.in_use_registry_info);
+  assert_int_equal(info.total_registry_data, sizeof(registry_buffer));
+  assert_int_not_equal(info.in_use_registry_data, 0);
+  assert_int_equal(info.free_registry_data, info.total_registry_data - info.in_use_registry_data);
+  assert_int_equal(info.dead_registry_data, 0);
+  assert_int_not_equal(info.write_count, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_get_info shall report the memory of deleted entries as dead data, and count
+ * the flash writes. */
+static void az_ulib_registry_get_info_after_delete_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  init_and_add_4_keys();
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  az_ulib_registry_get_info(&old_info);
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_2), AZ_OK);
+  g_count_acquire = 0;
+
+  /// act
+  az_ulib_registry_get_info(&info);
+
+  /// assert
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(info.in_use_registry_info, 3);
+  assert_int_equal(info.free_registry_info, old_info.free_registry_info);
+  assert_int_equal(info.free_registry_data, old_info.free_registry_data);
+  assert_int_equal(
+      info.dead_registry_data, old_info.in_use_registry_data - info.in_use_registry_data);
+  assert_int_equal(info.dead_registry_data, 4 * sizeof(uint64_t)); // TEST_KEY_2 + TEST_VALUE_2.
+  assert_int_equal(info.write_count, old_info.write_count + 1);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+/* If the write-behind is enabled, the az_ulib_registry_init shall start the worker thread, and the
+ * az_ulib_registry_deinit shall wake it up to stop. */
+static void az_ulib_registry_init_with_write_behind_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_deinit();
+
+  /// assert
+  assert_int_equal(g_count_thread_create, 1);
+  assert_int_equal(g_count_thread_join, 1);
+  assert_int_equal(g_count_event_set, 1);
+  assert_null(g_event);
+
+  /// cleanup
+}
+
+/* If the write-behind is enabled, the az_ulib_registry_add shall make the new entry visible before
+ * it is in the flash and wake up the worker thread, and the az_ulib_registry_try_get_value shall
+ * store it in the flash before returning its value. */
+static void az_ulib_registry_add_with_write_behind_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_info info;
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(g_count_event_set, 1);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 1);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_true(IS_IN_REGISTRY_BUFFER(value));
+  assert_int_equal(az_ulib_registry_flush(), AZ_OK);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The az_ulib_registry_iterate shall share the lock, unless it needs to store the entries in the
+ * write-behind queue first. */
+static void az_ulib_registry_iterate_with_write_behind_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
   assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
   g_count_acquire = 0;
+  g_count_acquire_shared = 0;
+
+  /// act
+  az_result result = az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_1));
+  assert_true(IS_IN_REGISTRY_BUFFER(value));
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(g_count_acquire_shared, 1);
+  assert_int_equal(g_count_acquire, 2);
+  assert_int_equal(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_ULIB_EOF);
+  assert_int_equal(g_count_acquire_shared, 2);
+  assert_int_equal(g_count_acquire, 3);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the write-behind is enabled, the az_ulib_registry_add shall look for duplicates in the
+ * queue. */
+static void az_ulib_registry_add_with_write_behind_duplicated_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_2);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the write-behind queue is full, the az_ulib_registry_add shall store the queued entries in the
+ * flash before queueing the new one. */
+static void az_ulib_registry_add_with_write_behind_full_queue_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  uint8_t keys[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE + 1][8];
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
+  for (uint8_t i = 0; i < AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE; i++)
+  {
+    (void)memcpy(keys[i], "QUEUE_", 6);
+    keys[i][6] = (uint8_t)('A' + i);
+    assert_int_equal(az_ulib_registry_add(az_span_create(keys[i], 7), TEST_VALUE_1), AZ_OK);
+  }
+  (void)memcpy(keys[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE], "QUEUE_Z", 7);
+
+  /// act
+  az_result result = az_ulib_registry_add(
+      az_span_create(keys[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE], 7), TEST_VALUE_2);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(az_span_create(keys[0], 7), &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_true(IS_IN_REGISTRY_BUFFER(value));
+  assert_int_equal(
+      az_ulib_registry_try_get_value(
+          az_span_create(keys[AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE], 7), &value),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+  assert_true(IS_IN_REGISTRY_BUFFER(value));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* The value returned by az_ulib_registry_try_get_value for a queued entry shall stay valid after
+ * the write-behind queue is reused by new entries. */
+static void az_ulib_registry_try_get_value_with_write_behind_after_queue_reuse_succeed(
+    void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  uint8_t keys[(AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE * 2) + 1][8];
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_registry_try_get_value(TEST_KEY_1, &value);
+  for (uint8_t i = 0; i <= (AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND_QUEUE_SIZE * 2); i++)
+  {
+    (void)memcpy(keys[i], "QUEUE_", 6);
+    keys[i][6] = (uint8_t)('A' + i);
+    assert_int_equal(az_ulib_registry_add(az_span_create(keys[i], 7), TEST_VALUE_2), AZ_OK);
+  }
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_true(IS_IN_REGISTRY_BUFFER(value));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the write-behind is enabled, the az_ulib_registry_deinit shall store the queued entries in the
+ * flash. */
+static void az_ulib_registry_deinit_with_write_behind_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_init(&registry_cb_write_behind);
+  az_ulib_registry_clean_all();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+
+  /// act
+  az_ulib_registry_deinit();
+
+  /// assert
+  az_ulib_registry_init(&registry_cb);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+
+/* The az_ulib_registry_try_get_value_copy shall copy the value to the provided buffer. */
+static void az_ulib_registry_try_get_value_copy_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[20];
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result
+      = az_ulib_registry_try_get_value_copy(TEST_KEY_3, AZ_SPAN_FROM_BUFFER(buffer), &value);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(az_span_ptr(value), buffer);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_3));
+  assert_int_equal(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the value does not fit in the buffer, the az_ulib_registry_try_get_value_copy shall fail. */
+static void az_ulib_registry_try_get_value_copy_small_buffer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[4];
+  az_span value = AZ_SPAN_EMPTY;
+  init_and_add_4_keys();
+
+  /// act
+  az_result result
+      = az_ulib_registry_try_get_value_copy(TEST_KEY_1, AZ_SPAN_FROM_BUFFER(buffer), &value);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_span_size(value), 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+/* A registry in an external flash shall return copies of the values read through the cache. */
+static void az_ulib_registry_external_flash_try_get_value_copy_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[20];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info info;
+  az_ulib_registry_instance external_registry;
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+  az_ulib_registry_instance_clean_all(&external_registry);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+
+  /// act
+  az_result result = az_ulib_registry_instance_try_get_value_copy(
+      &external_registry, TEST_KEY_2, AZ_SPAN_FROM_BUFFER(buffer), &value);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(az_span_ptr(value), buffer);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value(&external_registry, TEST_KEY_2, &value),
+      AZ_ERROR_NOT_SUPPORTED);
+  az_ulib_registry_instance_get_info(&external_registry, &info);
+  assert_int_equal(info.in_use_registry_info, 2);
+  assert_true(info.read_count > 0);
+
+  /// cleanup
+  az_ulib_registry_instance_deinit(&external_registry);
+}
+
+/* A repeated lookup in an external flash shall be served by the cache. */
+static void az_ulib_registry_external_flash_cache_hit_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[20];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  az_ulib_registry_instance external_registry;
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+  az_ulib_registry_instance_clean_all(&external_registry);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value_copy(
+          &external_registry, TEST_KEY_1, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_OK);
+  az_ulib_registry_instance_get_info(&external_registry, &old_info);
+
+  /// act
+  az_result result = az_ulib_registry_instance_try_get_value_copy(
+      &external_registry, TEST_KEY_1, AZ_SPAN_FROM_BUFFER(buffer), &value);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  az_ulib_registry_instance_get_info(&external_registry, &info);
+  assert_int_equal(info.read_count, old_info.read_count);
+  assert_true(info.cache_hit_count > old_info.cache_hit_count);
+
+  /// cleanup
+  az_ulib_registry_instance_deinit(&external_registry);
+}
+
+/* An update in place in an external flash shall invalidate the cached copy of the value. */
+static void az_ulib_registry_external_flash_update_in_place_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t reserved_value[4] = { 0xFF, 0xFF, 0xFF, 0xFF };
+  uint8_t new_value[4] = { 0x0F, 0xFF, 0x00, 0xF0 };
+  uint8_t buffer[4];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_update_mode mode = AZ_ULIB_REGISTRY_UPDATE_APPEND;
+  az_ulib_registry_instance external_registry;
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+  az_ulib_registry_instance_clean_all(&external_registry);
+  assert_int_equal(
+      az_ulib_registry_instance_add(
+          &external_registry, TEST_KEY_A, AZ_SPAN_FROM_BUFFER(reserved_value)),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value_copy(
+          &external_registry, TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_registry_instance_update(
+      &external_registry, TEST_KEY_A, AZ_SPAN_FROM_BUFFER(new_value), &mode);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(mode, AZ_ULIB_REGISTRY_UPDATE_IN_PLACE);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value_copy(
+          &external_registry, TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(value, AZ_SPAN_FROM_BUFFER(new_value)));
+
+  /// cleanup
+  az_ulib_registry_instance_deinit(&external_registry);
+}
+
+/* The az_ulib_registry_instance_init shall recover a registry in an external flash. */
+static void az_ulib_registry_external_flash_init_recover_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[20];
+  az_span value = AZ_SPAN_EMPTY;
+  uint32_t cursor = 0;
+  az_span key;
+  az_ulib_registry_info info;
+  az_ulib_registry_instance external_registry;
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+  az_ulib_registry_instance_clean_all(&external_registry);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_1, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_2, TEST_VALUE_2), AZ_OK);
+  assert_int_equal(az_ulib_registry_instance_delete(&external_registry, TEST_KEY_1), AZ_OK);
+  az_ulib_registry_instance_deinit(&external_registry);
+
+  /// act
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+
+  /// assert
+  az_ulib_registry_instance_get_info(&external_registry, &info);
+  assert_int_equal(info.in_use_registry_info, 1);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value_copy(
+          &external_registry, TEST_KEY_1, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value_copy(
+          &external_registry, TEST_KEY_2, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
+  assert_int_equal(
+      az_ulib_registry_instance_iterate(&external_registry, AZ_SPAN_EMPTY, &cursor, &key, &value),
+      AZ_ERROR_NOT_SUPPORTED);
+
+  /// cleanup
+  az_ulib_registry_instance_deinit(&external_registry);
+}
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
+
+static void add_chunked_test_value(void)
+{
+  az_ulib_registry_writer writer;
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_2), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_3), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_commit(&writer), AZ_OK);
+}
+
+static const az_span TEST_CHUNKED_VALUE
+    = AZ_SPAN_LITERAL_FROM_STR("TEST_VALUE_1TEST_VALUE_2TEST_VALUE_3");
+
+/* The az_ulib_registry_writer_commit shall add the key with all pieces of the value. */
+static void az_ulib_registry_writer_commit_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[64];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info old_info;
+  az_ulib_registry_info info;
+  az_ulib_registry_writer writer;
+  init_and_add_4_keys();
+  az_ulib_registry_get_info(&old_info);
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_2), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_3), AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  /// act
+  az_result result = az_ulib_registry_writer_commit(&writer);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_CHUNKED_VALUE));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_ERROR_NOT_SUPPORTED);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info + 1);
+  assert_int_equal(info.dead_registry_data, 0);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the key was added after the az_ulib_registry_add_begin, the az_ulib_registry_writer_commit
+ * shall fail and discard the chunks. */
+static void az_ulib_registry_writer_commit_duplicated_key_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info info;
+  az_ulib_registry_writer writer;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_1), AZ_OK);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_A, TEST_VALUE_A), AZ_OK);
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_A);
+  az_result result = az_ulib_registry_writer_commit(&writer);
 
   /// assert
   assert_int_equal(result, AZ_ERROR_ULIB_ELEMENT_DUPLICATE);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
-  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_A, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_A));
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 5);
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-/* If there is no more space in the registry info, the az_ulib_registry_add shall return
- * AZ_ERROR_NOT_ENOUGH_SPACE. */
-static void az_ulib_registry_add_out_of_registry_info_space_failed(void** state)
+/* The az_ulib_registry_writer_abort shall discard the value, and the key shall not exist. */
+static void az_ulib_registry_writer_abort_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
-
+  uint8_t buffer[64];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info old_info;
   az_ulib_registry_info info;
+  az_ulib_registry_writer writer;
+  init_and_add_4_keys();
+  az_ulib_registry_get_info(&old_info);
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_1), AZ_OK);
+
+  /// act
+  az_ulib_registry_writer_abort(&writer);
+
+  /// assert
+  assert_int_equal(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  az_ulib_registry_deinit();
+  az_ulib_registry_init(&registry_cb);
   az_ulib_registry_get_info(&info);
-  /* Fill all available registry info. */
-  for (size_t i = 0; i < info.free_registry_info; i++)
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.in_use_registry_data, old_info.in_use_registry_data);
+
+  /// cleanup
+  az_ulib_registry_deinit();
+}
+
+/* If the value needs more than AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS chunks, the
+ * az_ulib_registry_writer_write shall fail. */
+static void az_ulib_registry_writer_write_too_many_chunks_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_registry_writer writer;
+  init_and_add_4_keys();
+  assert_int_equal(az_ulib_registry_add_begin(TEST_KEY_A, &writer), AZ_OK);
+  for (int i = 0; i < AZ_ULIB_CONFIG_REGISTRY_MAX_CHUNKS; i++)
   {
-    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
-    assert_int_equal(az_ulib_registry_add(key, key), AZ_OK);
+    assert_int_equal(az_ulib_registry_writer_write(&writer, TEST_VALUE_A), AZ_OK);
   }
-  az_ulib_registry_get_info(&info);
-  assert_int_equal(info.free_registry_info, 0);
-  assert_int_not_equal(info.free_registry_data, 0);
-
-  g_count_acquire = 0;
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1);
+  az_result result = az_ulib_registry_writer_write(&writer, TEST_VALUE_A);
 
   /// assert
   assert_int_equal(result, AZ_ERROR_NOT_ENOUGH_SPACE);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
 
   /// cleanup
+  az_ulib_registry_writer_abort(&writer);
   az_ulib_registry_deinit();
 }
 
-/* If there is no more space in the registry data, the az_ulib_registry_add shall return
- * AZ_ERROR_OUT_OF_MEMORY. */
-static void az_ulib_registry_add_out_of_registry_data_space_failed(void** state)
+/* The az_ulib_registry_init shall recover the entries with values stored in chunks, and the
+ * az_ulib_registry_delete shall release all of their data. */
+static void az_ulib_registry_init_with_chunked_value_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
-
+  uint8_t buffer[64];
+  az_span value = AZ_SPAN_EMPTY;
+  az_ulib_registry_info old_info;
   az_ulib_registry_info info;
-  az_ulib_registry_get_info(&info);
-  /* Fill all available registry. */
-  uint8_t val[0xff];
-  for (size_t i = 0; i < sizeof(val); i++)
-  {
-    val[i] = 'a';
-  }
-  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
-  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
-  for (size_t i = 0; i < max; i++)
-  {
-    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
-    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
-  }
-  az_ulib_registry_get_info(&info);
-  val_span = az_span_create(
-      val,
-      (int32_t)(info.free_registry_data - (2 * sizeof(uint64_t)))); // TEST_KEY_1 needs 2 x 64bits.
-  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
-  az_ulib_registry_get_info(&info);
-  assert_int_not_equal(info.free_registry_info, 0);
-  assert_int_equal(info.free_registry_data, 0);
-
-  g_count_acquire = 0;
+  init_and_add_4_keys();
+  add_chunked_test_value();
+  az_ulib_registry_get_info(&old_info);
+  az_ulib_registry_deinit();
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+  az_ulib_registry_init(&registry_cb);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, old_info.in_use_registry_info);
+  assert_int_equal(info.in_use_registry_data, old_info.in_use_registry_data);
+  assert_int_equal(
+      az_ulib_registry_try_get_value_copy(TEST_KEY_A, AZ_SPAN_FROM_BUFFER(buffer), &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_CHUNKED_VALUE));
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_A), AZ_OK);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 4);
+  assert_int_equal(
+      info.dead_registry_data,
+      old_info.in_use_registry_data - info.in_use_registry_data);
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_add_no_space_for_key_failed(void** state)
+/* The az_ulib_registry_iterate shall return entries with values stored in chunks with an empty
+ * value, and never return the chunks. */
+static void az_ulib_registry_iterate_with_chunked_value_succeed(void** state)
 {
   /// arrange
   (void)state;
+  uint32_t cursor = 0;
+  az_span key;
+  az_span value;
   az_ulib_registry_init(&registry_cb);
   az_ulib_registry_clean_all();
+  add_chunked_test_value();
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
 
-  az_ulib_registry_info info;
-  az_ulib_registry_get_info(&info);
-  /* Fill all available registry. */
-  uint8_t val[0xff];
-  for (size_t i = 0; i < sizeof(val); i++)
-  {
-    val[i] = 'a';
-  }
-  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
-  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
-  for (size_t i = 0; i < max; i++)
-  {
-    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
-    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
-  }
-  az_ulib_registry_get_info(&info);
+  /// act
+  az_result result = az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value);
 
-  // TEST_KEY_1 needs 2 x 64bits. Only 1 x 64bits left, and Key needs 2 x 64bits.
-  val_span = az_span_create(val, (int32_t)(info.free_registry_data - (3 * sizeof(uint64_t))));
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_A));
+  assert_int_equal(az_span_size(value), 0);
+  assert_int_equal(az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(key, TEST_KEY_1));
+  assert_int_equal(
+      az_ulib_registry_iterate(AZ_SPAN_EMPTY, &cursor, &key, &value), AZ_ULIB_EOF);
 
-  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
-  az_ulib_registry_get_info(&info);
-  assert_int_not_equal(info.free_registry_info, 0);
-  assert_int_equal(info.free_registry_data, 8);
+  /// cleanup
+  az_ulib_registry_deinit();
+}
 
-  g_count_acquire = 0;
+/* The az_ulib_registry_try_get_value_ustream shall expose a value stored in chunks as a ustream. */
+static void az_ulib_registry_try_get_value_ustream_chunked_value_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[64];
+  uint8_t piece[5];
+  size_t size;
+  size_t total = 0;
+  az_ulib_registry_ustream_data_cb ustream_control_block;
+  az_ulib_ustream ustream_instance;
+  init_and_add_4_keys();
+  add_chunked_test_value();
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+  az_result result = az_ulib_registry_try_get_value_ustream(
+      TEST_KEY_A, &ustream_control_block, NULL, &ustream_instance);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_ustream_get_remaining_size(&ustream_instance, &size), AZ_OK);
+  assert_int_equal(size, az_span_size(TEST_CHUNKED_VALUE));
+  while (az_ulib_ustream_read(&ustream_instance, piece, sizeof(piece), &size) == AZ_OK)
+  {
+    memcpy(&buffer[total], piece, size);
+    total += size;
+  }
+  assert_true(az_span_is_content_equal(
+      az_span_create(buffer, (int32_t)total), TEST_CHUNKED_VALUE));
+  assert_int_equal(az_ulib_ustream_set_position(&ustream_instance, 10), AZ_OK);
+  assert_int_equal(az_ulib_ustream_read(&ustream_instance, buffer, 4, &size), AZ_OK);
+  assert_int_equal(size, 4);
+  assert_memory_equal(buffer, "_1TE", 4);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
 
   /// cleanup
   az_ulib_registry_deinit();
 }
 
-static void az_ulib_registry_add_space_only_for_key_failed(void** state)
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+/* The az_ulib_registry_try_get_value_ustream shall expose a value of a registry in an external
+ * flash as a ustream. */
+static void az_ulib_registry_external_flash_try_get_value_ustream_succeed(void** state)
 {
   /// arrange
   (void)state;
-  az_ulib_registry_init(&registry_cb);
-  az_ulib_registry_clean_all();
+  uint8_t buffer[20];
+  size_t size;
+  az_ulib_registry_ustream_data_cb ustream_control_block;
+  az_ulib_ustream ustream_instance;
+  az_ulib_ustream ustream_clone;
+  az_ulib_registry_instance external_registry;
+  az_ulib_registry_instance_init(&external_registry, &registry_cb_external);
+  az_ulib_registry_instance_clean_all(&external_registry);
+  assert_int_equal(
+      az_ulib_registry_instance_add(&external_registry, TEST_KEY_1, TEST_VALUE_1), AZ_OK);
 
-  az_ulib_registry_info info;
-  az_ulib_registry_get_info(&info);
-  /* Fill all available registry. */
-  uint8_t val[0xff];
-  for (size_t i = 0; i < sizeof(val); i++)
-  {
-    val[i] = 'a';
-  }
-  az_span val_span = az_span_create(val, (int32_t)sizeof(val));
-  size_t max = (info.total_registry_data / (sizeof(val) + sizeof(uint64_t))); // key needs 64bits.
-  for (size_t i = 0; i < max; i++)
-  {
-    az_span key = az_span_create((uint8_t*)&i, (int32_t)sizeof(i));
-    assert_int_equal(az_ulib_registry_add(key, val_span), AZ_OK);
-  }
-  az_ulib_registry_get_info(&info);
+  /// act
+  az_result result = az_ulib_registry_instance_try_get_value_ustream(
+      &external_registry, TEST_KEY_1, &ustream_control_block, NULL, &ustream_instance);
 
-  // TEST_KEY_1 needs 2 x 64bits. Only 3 x 64bits left that only fits the Key, but not the value.
-  val_span = az_span_create(val, (int32_t)(info.free_registry_data - (5 * sizeof(uint64_t))));
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_ustream_clone(&ustream_clone, &ustream_instance, 100), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(az_ulib_ustream_read(&ustream_clone, buffer, sizeof(buffer), &size), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      az_span_create(buffer, (int32_t)size), TEST_VALUE_1));
+  assert_int_equal(
+      az_ulib_ustream_read(&ustream_clone, buffer, sizeof(buffer), &size), AZ_ULIB_EOF);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_clone), AZ_OK);
 
-  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, val_span), AZ_OK);
-  az_ulib_registry_get_info(&info);
-  assert_int_not_equal(info.free_registry_info, 0);
-  assert_int_equal(info.free_registry_data, 24);
+  /// cleanup
+  az_ulib_registry_instance_deinit(&external_registry);
+}
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
 
-  g_count_acquire = 0;
+/* The az_ulib_registry_instance_add shall store the key only in the given instance. */
+static void az_ulib_registry_instance_add_keeps_instances_independent_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span value;
+  az_ulib_registry_instance fast_registry;
+  az_ulib_registry_init(&registry_cb);
+  az_ulib_registry_clean_all();
+  az_ulib_registry_instance_init(&fast_registry, &registry_cb_fast);
+  az_ulib_registry_instance_clean_all(&fast_registry);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_1, TEST_VALUE_1), AZ_OK);
 
   /// act
-  az_result result = az_ulib_registry_add(TEST_KEY_2, TEST_VALUE_2);
+  az_result result = az_ulib_registry_instance_add(&fast_registry, TEST_KEY_2, TEST_VALUE_2);
 
   /// assert
-  assert_int_equal(result, AZ_ERROR_OUT_OF_MEMORY);
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(az_ulib_registry_instance_add(&fast_registry, TEST_KEY_1, TEST_VALUE_A), AZ_OK);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_1));
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_2, &value), AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value(&fast_registry, TEST_KEY_1, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_A));
+  assert_true(
+      (az_span_ptr(value) >= &registry_buffer_fast[0])
+      && (az_span_ptr(value) < &registry_buffer_fast[REGISTRY_PAGE_SIZE]));
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value(&fast_registry, TEST_KEY_2, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_2));
 
   /// cleanup
+  az_ulib_registry_instance_deinit(&fast_registry);
   az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_clean_all shall Delete all stored registries. */
-static void az_ulib_registry_clean_all_succeed(void** state)
+/* The az_ulib_registry_instance_clean_all shall only erase the memory of the given instance. */
+static void az_ulib_registry_instance_clean_all_keeps_other_instances_succeed(void** state)
 {
   /// arrange
   (void)state;
-  init_and_add_4_keys();
+  az_span value;
   az_ulib_registry_info info;
-  az_ulib_registry_get_info(&info);
-  assert_int_not_equal(info.in_use_registry_info, 0);
-  g_count_acquire = 0;
+  az_ulib_registry_instance fast_registry;
+  init_and_add_4_keys();
+  az_ulib_registry_instance_init(&fast_registry, &registry_cb_fast);
+  assert_int_equal(az_ulib_registry_instance_add(&fast_registry, TEST_KEY_A, TEST_VALUE_A), AZ_OK);
 
   /// act
-  az_ulib_registry_clean_all();
+  az_ulib_registry_instance_clean_all(&fast_registry);
 
   /// assert
-  assert_int_equal(g_lock_diff, 0);
-  assert_int_equal(g_count_acquire, 1);
-  az_ulib_registry_get_info(&info);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value(&fast_registry, TEST_KEY_A, &value),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  az_ulib_registry_instance_get_info(&fast_registry, &info);
   assert_int_equal(info.in_use_registry_info, 0);
-  assert_int_equal(info.in_use_registry_data, 0);
+  az_ulib_registry_get_info(&info);
+  assert_int_equal(info.in_use_registry_info, 4);
+  assert_int_equal(az_ulib_registry_try_get_value(TEST_KEY_4, &value), AZ_OK);
+  assert_true(az_span_is_content_equal(value, TEST_VALUE_4));
 
   /// cleanup
+  az_ulib_registry_instance_deinit(&fast_registry);
   az_ulib_registry_deinit();
 }
 
-/* The az_ulib_registry_get_info shall return the registry information in the #az_ulib_registry_info
- * structure. */
-static void az_ulib_registry_get_info_succeed(void** state)
+/* Each registry instance shall use its own lock. */
+static void az_ulib_registry_instance_uses_own_lock_succeed(void** state)
 {
   /// arrange
   (void)state;
+  az_span value;
+  az_ulib_registry_instance fast_registry;
   init_and_add_4_keys();
-  az_ulib_registry_info info;
+  az_ulib_registry_instance_init(&fast_registry, &registry_cb_fast);
+  az_ulib_registry_instance_clean_all(&fast_registry);
+  assert_ptr_equal(g_lock, &fast_registry._internal.lock);
   g_count_acquire = 0;
 
   /// act
-  az_ulib_registry_get_info(&info);
+  assert_int_equal(az_ulib_registry_add(TEST_KEY_A, TEST_VALUE_A), AZ_OK);
+  assert_int_equal(az_ulib_registry_delete(TEST_KEY_1), AZ_OK);
+  int8_t count_default = g_count_acquire;
+  assert_int_equal(az_ulib_registry_instance_add(&fast_registry, TEST_KEY_A, TEST_VALUE_A), AZ_OK);
 
   /// assert
-  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(count_default, 0);
   assert_int_equal(g_count_acquire, 1);
-  assert_int_not_equal(info.total_registry_info, 0);
-  assert_int_equal(info.in_use_registry_info, 4);
-  assert_int_equal(info.free_registry_info, info.total_registry_info - info.in_use_registry_info);
-  assert_int_equal(info.total_registry_data, sizeof(registry_buffer));
-  assert_int_not_equal(info.in_use_registry_data, 0);
-  assert_int_equal(info.free_registry_data, info.total_registry_data - info.in_use_registry_data);
+  assert_int_equal(g_lock_diff, 0);
+  assert_int_equal(
+      az_ulib_registry_instance_try_get_value(&fast_registry, TEST_KEY_A, &value), AZ_OK);
 
   /// cleanup
+  az_ulib_registry_instance_deinit(&fast_registry);
   az_ulib_registry_deinit();
 }
 
@@ -864,14 +2592,51 @@ int az_ulib_registry_ut()
     cmocka_unit_test_setup_teardown(az_ulib_registry_add_not_initialized_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_add_with_empty_key_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_add_with_empty_value_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_update_not_initialized_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_update_with_empty_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_update_with_empty_value_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_not_initialized_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_with_null_cursor_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_with_null_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_with_null_value_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_registry_clean_all_not_initialized_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_registry_get_info_not_initialized_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_registry_get_info_with_NULL_info_pointer_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_flush_not_initialized_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_instance_init_with_null_instance_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_instance_add_not_initialized_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_try_get_value_copy_with_null_value_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_writer_write_closed_writer_failed, setup, teardown),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup_teardown(az_ulib_registry_init_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_recover_torn_entry_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_recover_torn_update_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_from_checkpoint_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_from_checkpoint_skip_old_nodes_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_with_stale_checkpoint_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_with_legacy_format_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_with_unknown_version_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_deinit_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_delete_single_key_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_delete_first_key_succeed, setup, teardown),
@@ -891,8 +2656,76 @@ int az_ulib_registry_ut()
     cmocka_unit_test_setup_teardown(az_ulib_registry_add_no_space_for_key_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_registry_add_space_only_for_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_update_in_place_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_update_not_reprogrammable_append_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_update_append_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_update_unknow_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_iterate_all_keys_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_iterate_with_prefix_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_empty_registry_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_clean_all_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_clean_all_skip_erased_pages_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_clean_all_unaligned_memory_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_registry_get_info_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_get_info_after_delete_succeed, setup, teardown),
+#ifdef AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_with_write_behind_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_add_with_write_behind_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_with_write_behind_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_add_with_write_behind_duplicated_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_add_with_write_behind_full_queue_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_try_get_value_with_write_behind_after_queue_reuse_succeed,
+        setup,
+        teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_deinit_with_write_behind_succeed, setup, teardown),
+#endif /* AZ_ULIB_CONFIG_REGISTRY_WRITE_BEHIND */
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_instance_add_keeps_instances_independent_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_instance_clean_all_keeps_other_instances_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_instance_uses_own_lock_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_try_get_value_copy_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_try_get_value_copy_small_buffer_failed, setup, teardown),
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_external_flash_try_get_value_copy_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_external_flash_cache_hit_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_external_flash_update_in_place_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_external_flash_init_recover_succeed, setup, teardown),
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
+    cmocka_unit_test_setup_teardown(az_ulib_registry_writer_commit_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_writer_commit_duplicated_key_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_registry_writer_abort_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_writer_write_too_many_chunks_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_init_with_chunked_value_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_iterate_with_chunked_value_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_try_get_value_ustream_chunked_value_succeed, setup, teardown),
+#ifdef AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH
+    cmocka_unit_test_setup_teardown(
+        az_ulib_registry_external_flash_try_get_value_ustream_succeed, setup, teardown),
+#endif /* AZ_ULIB_CONFIG_REGISTRY_EXTERNAL_FLASH */
   };
 
   return cmocka_run_group_tests_name("az_ulib_registry_ut", tests, NULL, NULL);
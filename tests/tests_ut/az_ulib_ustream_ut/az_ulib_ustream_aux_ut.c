@@ -103,6 +103,51 @@ static const uint8_t* const USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT
     = (const uint8_t* const)USTREAM_COMPLIANCE_EXPECTED_CONTENT;
 #define USTREAM_COMPLIANCE_TARGET_FACTORY(ustream) create_test_default_multibuffer(ustream)
 
+#define USTREAM_FRAGMENT_LENGTH 2
+#define USTREAM_FRAGMENTS (USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH / USTREAM_FRAGMENT_LENGTH)
+
+static int multi_data_release_count;
+
+static void multi_data_release_counter(void* release_pointer)
+{
+  (void)release_pointer;
+  multi_data_release_count++;
+}
+
+/* Concatenate the expected content in fragments of USTREAM_FRAGMENT_LENGTH bytes. */
+static void create_test_fragmented_multibuffer(
+    az_ulib_ustream* ustream,
+    az_ulib_ustream_data_cb* control_blocks,
+    az_ulib_ustream_multi_data_cb* multi_data)
+{
+  assert_int_equal(
+      az_ulib_ustream_init(
+          ustream,
+          &control_blocks[0],
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_FRAGMENT_LENGTH,
+          NULL),
+      AZ_OK);
+  for (int i = 1; i < USTREAM_FRAGMENTS; i++)
+  {
+    az_ulib_ustream fragment;
+    assert_int_equal(
+        az_ulib_ustream_init(
+            &fragment,
+            &control_blocks[i],
+            NULL,
+            USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + (i * USTREAM_FRAGMENT_LENGTH),
+            USTREAM_FRAGMENT_LENGTH,
+            NULL),
+        AZ_OK);
+    assert_int_equal(
+        az_ulib_ustream_concat(ustream, &fragment, &multi_data[i], multi_data_release_counter),
+        AZ_OK);
+    assert_int_equal(az_ulib_ustream_dispose(&fragment), AZ_OK);
+  }
+}
+
 #ifndef AZ_NO_PRECONDITION_CHECKING
 AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
 #endif // AZ_NO_PRECONDITION_CHECKING
@@ -253,6 +298,111 @@ static void az_ulib_ustream_split_null_split_instance_failed(void** state)
   /// cleanup
 }
 
+/* az_ulib_ustream_peek shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_peek_null_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_span span;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_peek(NULL, AZ_SPAN_EMPTY, &span));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_peek shall fail with precondition if the provided span is NULL. */
+static void az_ulib_ustream_peek_null_span_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_peek(test_ustream, AZ_SPAN_EMPTY, NULL));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_advance shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_advance_null_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_advance(NULL, 1));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_readv shall fail with precondition if the provided ustream is NULL. */
+static void az_ulib_ustream_readv_null_instance_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  uint8_t buffer[10];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buffer) };
+  size_t size;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_readv(NULL, buffers, 1, &size));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_readv shall fail with precondition if the provided buffers is NULL. */
+static void az_ulib_ustream_readv_null_buffers_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  size_t size;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_readv(test_ustream, NULL, 1, &size));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_readv shall fail with precondition if the provided buffers_count is zero. */
+static void az_ulib_ustream_readv_zero_buffers_count_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  uint8_t buffer[10];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buffer) };
+  size_t size;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_readv(test_ustream, buffers, 0, &size));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_readv shall fail with precondition if the provided size is NULL. */
+static void az_ulib_ustream_readv_null_size_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  uint8_t buffer[10];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buffer) };
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED(az_ulib_ustream_readv(test_ustream, buffers, 1, NULL));
+
+  /// cleanup
+}
+
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 /* az_ulib_ustream_concat shall return AZ_OK if the ustreams were concatenated successfully
@@ -875,6 +1025,466 @@ static void az_ulib_ustream_split_set_position_second_failed(void** state)
   az_ulib_ustream_dispose(test_ustream);
 }
 
+/* az_ulib_ustream_peek shall return spans that point to the data in the buffers of the
+ * concatenated ustreams. */
+static void az_ulib_ustream_peek_multi_without_copy_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block1;
+  az_ulib_ustream_data_cb control_block2;
+  az_ulib_ustream_multi_data_cb multi_data;
+  az_ulib_ustream test_buffer1;
+  az_ulib_ustream test_buffer2;
+  size_t length1 = strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  size_t length2 = strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer1,
+          &control_block1,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          length1,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer2,
+          &control_block2,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+          length2,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_concat(&test_buffer1, &test_buffer2, &multi_data, NULL), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&test_buffer2), AZ_OK);
+  az_span span1;
+  az_span span2;
+
+  /// act
+  az_result result1 = az_ulib_ustream_peek(&test_buffer1, AZ_SPAN_EMPTY, &span1);
+  assert_int_equal(az_ulib_ustream_advance(&test_buffer1, length1 - 1), AZ_OK);
+  az_result result2 = az_ulib_ustream_peek(&test_buffer1, AZ_SPAN_EMPTY, &span2);
+  assert_int_equal(az_ulib_ustream_advance(&test_buffer1, 1), AZ_OK);
+  az_span span3;
+  az_result result3 = az_ulib_ustream_peek(&test_buffer1, AZ_SPAN_EMPTY, &span3);
+
+  /// assert
+  assert_int_equal(result1, AZ_OK);
+  assert_ptr_equal(az_span_ptr(span1), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  assert_int_equal(az_span_size(span1), length1);
+  assert_int_equal(result2, AZ_OK);
+  assert_ptr_equal(az_span_ptr(span2), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1 + length1 - 1);
+  assert_int_equal(az_span_size(span2), 1);
+  assert_int_equal(result3, AZ_OK);
+  assert_ptr_equal(az_span_ptr(span3), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2);
+  assert_int_equal(az_span_size(span3), length2);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer1);
+}
+
+/* az_ulib_ustream_peek shall return AZ_ERROR_NOT_SUPPORTED if the ustream cannot expose its
+ * memory and the provided buffer is empty. */
+static void az_ulib_ustream_peek_not_supported_with_empty_buffer_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  az_span span;
+
+  /// act
+  az_result result = az_ulib_ustream_peek(test_ustream, AZ_SPAN_EMPTY, &span);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_NOT_SUPPORTED);
+  assert_int_equal(az_span_size(span), 0);
+
+  /// cleanup
+  az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_peek shall return the return value of az_ulib_ustream_read if the copy fails. */
+static void az_ulib_ustream_peek_copy_read_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  uint8_t buffer[10];
+  az_span span;
+
+  set_read_result(AZ_ERROR_ULIB_SYSTEM);
+
+  /// act
+  az_result result = az_ulib_ustream_peek(test_ustream, AZ_SPAN_FROM_BUFFER(buffer), &span);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_SYSTEM);
+  assert_int_equal(az_span_size(span), 0);
+
+  /// cleanup
+  az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_readv shall fill the buffers across the boundary of the concatenated
+ * ustreams. */
+static void az_ulib_ustream_readv_multi_across_ustreams_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block1;
+  az_ulib_ustream_data_cb control_block2;
+  az_ulib_ustream_multi_data_cb multi_data;
+  az_ulib_ustream test_buffer1;
+  az_ulib_ustream test_buffer2;
+  size_t length1 = strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  size_t length2 = strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer1,
+          &control_block1,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          length1,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer2,
+          &control_block2,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+          length2,
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_concat(&test_buffer1, &test_buffer2, &multi_data, NULL), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&test_buffer2), AZ_OK);
+  uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  az_span buffers[2] = { az_span_create(buf_result, (int32_t)(length1 + 1)),
+                         az_span_create(buf_result + length1 + 1, (int32_t)length2) };
+  size_t size_result;
+
+  /// act
+  az_result result = az_ulib_ustream_readv(&test_buffer1, buffers, 2, &size_result);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size_result, length1 + length2);
+  assert_memory_equal(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT, buf_result, size_result);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer1);
+}
+
+/* az_ulib_ustream_readv shall return AZ_OK with the content read before the inner ustream failed.
+ */
+static void az_ulib_ustream_readv_multi_failed_in_read_with_some_valid_content_succeed(
+    void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream multibuffer;
+  az_ulib_ustream_data_cb* control_block1
+      = (az_ulib_ustream_data_cb*)malloc(sizeof(az_ulib_ustream_data_cb));
+  size_t length1 = strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &multibuffer,
+          control_block1,
+          free,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          length1,
+          NULL),
+      AZ_OK);
+
+  az_ulib_ustream* test_buffer2 = ustream_mock_create();
+
+  az_ulib_ustream_multi_data_cb* multi_data1
+      = (az_ulib_ustream_multi_data_cb*)malloc(sizeof(az_ulib_ustream_multi_data_cb));
+
+  assert_int_equal(az_ulib_ustream_concat(&multibuffer, test_buffer2, multi_data1, free), AZ_OK);
+  set_read_result(AZ_ERROR_ULIB_SYSTEM);
+
+  uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buf_result) };
+  size_t size_result;
+
+  /// act
+  az_result result = az_ulib_ustream_readv(&multibuffer, buffers, 1, &size_result);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size_result, length1);
+  assert_memory_equal(USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1, buf_result, size_result);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&multibuffer);
+  (void)az_ulib_ustream_dispose(test_buffer2);
+}
+
+/* az_ulib_ustream_readv shall call az_ulib_ustream_read for each buffer if the ustream does not
+ * implement readv. */
+static void az_ulib_ustream_readv_fallback_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  uint8_t buffer1[10];
+  uint8_t buffer2[20];
+  az_span buffers[3]
+      = { AZ_SPAN_FROM_BUFFER(buffer1), AZ_SPAN_EMPTY, AZ_SPAN_FROM_BUFFER(buffer2) };
+  size_t size;
+
+  /// act
+  az_result result = az_ulib_ustream_readv(test_ustream, buffers, 3, &size);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_int_equal(size, sizeof(buffer1) + sizeof(buffer2));
+
+  /// cleanup
+  az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_readv shall return the return value of az_ulib_ustream_read if the ustream does
+ * not implement readv and the first read fails. */
+static void az_ulib_ustream_readv_fallback_read_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream* test_ustream = ustream_mock_create();
+  uint8_t buffer[10];
+  az_span buffers[1] = { AZ_SPAN_FROM_BUFFER(buffer) };
+  size_t size;
+
+  set_read_result(AZ_ERROR_ULIB_SYSTEM);
+
+  /// act
+  az_result result = az_ulib_ustream_readv(test_ustream, buffers, 1, &size);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_SYSTEM);
+  assert_int_equal(size, 0);
+
+  /// cleanup
+  az_ulib_ustream_dispose(test_ustream);
+}
+
+/* az_ulib_ustream_concat shall append the ustream to the multi ustream, instead of creating a new
+ * level, and release the provided multi data. */
+static void az_ulib_ustream_concat_append_to_multi_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block1;
+  az_ulib_ustream_data_cb control_block2;
+  az_ulib_ustream_data_cb control_block3;
+  az_ulib_ustream_multi_data_cb multi_data1;
+  az_ulib_ustream_multi_data_cb multi_data2;
+  az_ulib_ustream test_buffer1;
+  az_ulib_ustream test_buffer2;
+  az_ulib_ustream test_buffer3;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer1,
+          &control_block1,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1),
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer2,
+          &control_block2,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_2),
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer3,
+          &control_block3,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_3),
+          NULL),
+      AZ_OK);
+  multi_data_release_count = 0;
+
+  /// act
+  az_result result1 = az_ulib_ustream_concat(
+      &test_buffer1, &test_buffer2, &multi_data1, multi_data_release_counter);
+  az_result result2 = az_ulib_ustream_concat(
+      &test_buffer1, &test_buffer3, &multi_data2, multi_data_release_counter);
+
+  /// assert
+  assert_int_equal(result1, AZ_OK);
+  assert_int_equal(result2, AZ_OK);
+  assert_ptr_equal(test_buffer1.control_block, &multi_data1.control_block);
+  assert_int_equal(multi_data1.segments_count, 3);
+  assert_int_equal(multi_data_release_count, 1);
+  (void)az_ulib_ustream_dispose(&test_buffer2);
+  (void)az_ulib_ustream_dispose(&test_buffer3);
+  check_buffer(
+      &test_buffer1,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer1);
+  assert_int_equal(multi_data_release_count, 2);
+}
+
+/* az_ulib_ustream_concat shall create a new level if the multi ustream has no free segments. */
+static void az_ulib_ustream_concat_more_than_segments_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_blocks[USTREAM_FRAGMENTS];
+  az_ulib_ustream_multi_data_cb multi_data[USTREAM_FRAGMENTS];
+  az_ulib_ustream test_buffer;
+  multi_data_release_count = 0;
+
+  /// act
+  create_test_fragmented_multibuffer(&test_buffer, control_blocks, multi_data);
+
+  /// assert
+  assert_true(multi_data_release_count > 0);
+  check_buffer(
+      &test_buffer,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer);
+  assert_int_equal(multi_data_release_count, USTREAM_FRAGMENTS - 1);
+}
+
+/* az_ulib_ustream_set_position shall move to any segment of the multi ustream, and the next read
+ * shall start at the new position. */
+static void az_ulib_ustream_multi_read_after_set_position_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_blocks[USTREAM_FRAGMENTS];
+  az_ulib_ustream_multi_data_cb multi_data[USTREAM_FRAGMENTS];
+  az_ulib_ustream test_buffer;
+  create_test_fragmented_multibuffer(&test_buffer, control_blocks, multi_data);
+  static const offset_t positions[] = { 45, 3, 60, 0, 31, 17, 16, 61 };
+  uint8_t buf_result[5];
+  size_t size_result;
+
+  /// act
+  /// assert
+  for (size_t i = 0; i < (sizeof(positions) / sizeof(positions[0])); i++)
+  {
+    size_t expected_size = USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - positions[i];
+    expected_size = (expected_size < sizeof(buf_result)) ? expected_size : sizeof(buf_result);
+    assert_int_equal(az_ulib_ustream_set_position(&test_buffer, positions[i]), AZ_OK);
+    assert_int_equal(
+        az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result), AZ_OK);
+    assert_int_equal(size_result, expected_size);
+    assert_memory_equal(
+        USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + positions[i], buf_result, size_result);
+  }
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_concat shall not append to a multi ustream used by another instance. */
+static void az_ulib_ustream_concat_to_cloned_multi_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_buffer;
+  az_ulib_ustream test_buffer_clone;
+  create_test_default_multibuffer(&test_buffer);
+  assert_int_equal(az_ulib_ustream_clone(&test_buffer_clone, &test_buffer, 0), AZ_OK);
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream_multi_data_cb multi_data;
+  az_ulib_ustream test_buffer2;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &test_buffer2,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+          strlen((const char*)USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1),
+          NULL),
+      AZ_OK);
+
+  /// act
+  az_result result = az_ulib_ustream_concat(&test_buffer, &test_buffer2, &multi_data, NULL);
+
+  /// assert
+  assert_int_equal(result, AZ_OK);
+  assert_ptr_equal(test_buffer.control_block, &multi_data.control_block);
+  (void)az_ulib_ustream_dispose(&test_buffer2);
+  check_buffer(
+      &test_buffer_clone,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  uint8_t buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 10];
+  size_t size_result;
+  assert_int_equal(
+      az_ulib_ustream_read(&test_buffer, buf_result, sizeof(buf_result), &size_result), AZ_OK);
+  assert_int_equal(size_result, USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH + 10);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      buf_result,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_memory_equal(
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT_1,
+      &buf_result[USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH],
+      10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&test_buffer_clone);
+  (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
+/* az_ulib_ustream_concat shall return the error of get_remaining_size, keep the multi ustream
+ * unchanged, and release the provided multi data, if it failed to append the ustream. */
+static void az_ulib_ustream_concat_append_get_remaining_size_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream test_buffer;
+  create_test_default_multibuffer(&test_buffer);
+  az_ulib_ustream_data_cb* control_block = test_buffer.control_block;
+  az_ulib_ustream* test_buffer2 = ustream_mock_create();
+  az_ulib_ustream_multi_data_cb multi_data;
+  multi_data_release_count = 0;
+
+  set_get_remaining_size_result(AZ_ERROR_ULIB_SYSTEM);
+
+  /// act
+  az_result result
+      = az_ulib_ustream_concat(&test_buffer, test_buffer2, &multi_data, multi_data_release_counter);
+
+  /// assert
+  assert_int_equal(result, AZ_ERROR_ULIB_SYSTEM);
+  assert_ptr_equal(test_buffer.control_block, control_block);
+  assert_int_equal(multi_data_release_count, 1);
+  check_buffer(
+      &test_buffer,
+      0,
+      USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+      USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(test_buffer2);
+  (void)az_ulib_ustream_dispose(&test_buffer);
+}
+
 #include "az_ulib_ustream_compliance_ut.h"
 
 int az_ulib_ustream_aux_ut()
@@ -890,6 +1500,13 @@ int az_ulib_ustream_aux_ut()
     cmocka_unit_test(az_ulib_ustream_concat_null_multi_data_failed),
     cmocka_unit_test(az_ulib_ustream_split_null_instance_failed),
     cmocka_unit_test(az_ulib_ustream_split_null_split_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_peek_null_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_peek_null_span_failed),
+    cmocka_unit_test(az_ulib_ustream_advance_null_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_readv_null_instance_failed),
+    cmocka_unit_test(az_ulib_ustream_readv_null_buffers_failed),
+    cmocka_unit_test(az_ulib_ustream_readv_zero_buffers_count_failed),
+    cmocka_unit_test(az_ulib_ustream_readv_null_size_failed),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup_teardown(
         az_ulib_ustream_concat_multiple_buffers_succeed, setup, teardown),
@@ -923,6 +1540,29 @@ int az_ulib_ustream_aux_ut()
     cmocka_unit_test_setup_teardown(az_ulib_ustream_split_clone_failed, setup, teardown),
     cmocka_unit_test_setup_teardown(
         az_ulib_ustream_split_set_position_second_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_peek_multi_without_copy_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_peek_not_supported_with_empty_buffer_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_peek_copy_read_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_readv_multi_across_ustreams_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_readv_multi_failed_in_read_with_some_valid_content_succeed,
+        setup,
+        teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_readv_fallback_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_readv_fallback_read_failed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_concat_append_to_multi_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_concat_more_than_segments_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_multi_read_after_set_position_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_concat_to_cloned_multi_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(
+        az_ulib_ustream_concat_append_get_remaining_size_failed, setup, teardown),
 #ifndef AZ_NO_PRECONDITION_CHECKING
     AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
 #endif // AZ_NO_PRECONDITION_CHECKING
@@ -0,0 +1,359 @@
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license.
+// See LICENSE file in the project root for full license information.
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "az_ulib_config.h"
+#include "az_ulib_ustream.h"
+#include "az_ulib_ustream_pool.h"
+#include "az_ulib_ustream_ut.h"
+
+#include "az_ulib_test_thread.h"
+
+#include "az_ulib_test_precondition.h"
+#include "azure/core/az_precondition.h"
+
+#include "cmocka.h"
+
+#define TEST_POOL_THREADS 4
+#define TEST_POOL_ITERATIONS 10000
+
+static const uint8_t* const USTREAM_POOL_CONTENT_1 = (const uint8_t* const) "0123456789";
+static const uint8_t* const USTREAM_POOL_CONTENT_2 = (const uint8_t* const) "ABCDEFGHIJ";
+
+static volatile long g_pool_errors;
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+AZ_ULIB_ENABLE_PRECONDITION_CHECK_TESTS()
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* Takes all blocks from the pool, checks that they are all different, and returns them. */
+static void check_all_data_cb_available(void)
+{
+  az_ulib_ustream_data_cb* blocks[AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB];
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB; i++)
+  {
+    blocks[i] = az_ulib_ustream_pool_alloc_data_cb();
+    assert_non_null(blocks[i]);
+    for (int j = 0; j < i; j++)
+    {
+      assert_ptr_not_equal(blocks[i], blocks[j]);
+    }
+  }
+  assert_null(az_ulib_ustream_pool_alloc_data_cb());
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_USTREAM_POOL_DATA_CB; i++)
+  {
+    az_ulib_ustream_pool_release_data_cb(blocks[i]);
+  }
+}
+
+static void check_all_multi_data_cb_available(void)
+{
+  az_ulib_ustream_multi_data_cb* blocks[AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB];
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB; i++)
+  {
+    blocks[i] = az_ulib_ustream_pool_alloc_multi_data_cb();
+    assert_non_null(blocks[i]);
+    for (int j = 0; j < i; j++)
+    {
+      assert_ptr_not_equal(blocks[i], blocks[j]);
+    }
+  }
+  assert_null(az_ulib_ustream_pool_alloc_multi_data_cb());
+
+  for (int i = 0; i < AZ_ULIB_CONFIG_USTREAM_POOL_MULTI_DATA_CB; i++)
+  {
+    az_ulib_ustream_pool_release_multi_data_cb(blocks[i]);
+  }
+}
+
+static int alloc_and_release_thread(void* arg)
+{
+  (void)arg;
+
+  for (int i = 0; i < TEST_POOL_ITERATIONS; i++)
+  {
+    az_ulib_ustream_data_cb* control_block = az_ulib_ustream_pool_alloc_data_cb();
+    if (control_block == NULL)
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_pool_errors);
+      continue;
+    }
+
+    /* Another thread that got the same block would change the ref_count. */
+    control_block->ref_count = i;
+    test_thread_sleep(0);
+    if (control_block->ref_count != i)
+    {
+      (void)AZ_ULIB_PORT_ATOMIC_INC_W(&g_pool_errors);
+    }
+
+    az_ulib_ustream_pool_release_data_cb(control_block);
+  }
+
+  return 0;
+}
+
+/**
+ * Beginning of the UT for ustream_pool.c module.
+ */
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+/* az_ulib_ustream_pool_release_data_cb shall fail with precondition if the provided pointer is
+ * NULL. */
+static void az_ulib_ustream_pool_release_data_cb_null_failed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(az_ulib_ustream_pool_release_data_cb(NULL));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_pool_release_data_cb shall fail with precondition if the provided pointer is not
+ * a block of the pool. */
+static void az_ulib_ustream_pool_release_data_cb_not_from_pool_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(
+      az_ulib_ustream_pool_release_data_cb(&control_block));
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_pool_release_data_cb shall fail with precondition if the provided pointer is in
+ * the middle of a block of the pool. */
+static void az_ulib_ustream_pool_release_data_cb_misaligned_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb* control_block = az_ulib_ustream_pool_alloc_data_cb();
+  assert_non_null(control_block);
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(
+      az_ulib_ustream_pool_release_data_cb((uint8_t*)control_block + 1));
+
+  /// cleanup
+  az_ulib_ustream_pool_release_data_cb(control_block);
+}
+
+/* az_ulib_ustream_pool_release_multi_data_cb shall fail with precondition if the provided pointer
+ * is not a block of the pool. */
+static void az_ulib_ustream_pool_release_multi_data_cb_not_from_pool_failed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_multi_data_cb multi_data;
+
+  /// act
+  /// assert
+  AZ_ULIB_ASSERT_PRECONDITION_CHECKED_VOID_FUNCTION(
+      az_ulib_ustream_pool_release_multi_data_cb(&multi_data));
+
+  /// cleanup
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+/* az_ulib_ustream_pool_alloc_data_cb shall return different blocks up to the size of the pool,
+ * and NULL after that. */
+/* az_ulib_ustream_pool_release_data_cb shall return the block to the pool. */
+static void az_ulib_ustream_pool_alloc_data_cb_all_blocks_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  check_all_data_cb_available();
+  check_all_data_cb_available();
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_pool_alloc_multi_data_cb shall return different blocks up to the size of the
+ * pool, and NULL after that. */
+/* az_ulib_ustream_pool_release_multi_data_cb shall return the block to the pool. */
+static void az_ulib_ustream_pool_alloc_multi_data_cb_all_blocks_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+
+  /// act
+  /// assert
+  check_all_multi_data_cb_available();
+  check_all_multi_data_cb_available();
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_pool_alloc_data_cb shall return the most recently released block first. */
+static void az_ulib_ustream_pool_alloc_data_cb_reuse_released_block_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb* control_block1 = az_ulib_ustream_pool_alloc_data_cb();
+  az_ulib_ustream_data_cb* control_block2 = az_ulib_ustream_pool_alloc_data_cb();
+  assert_non_null(control_block1);
+  assert_non_null(control_block2);
+  az_ulib_ustream_pool_release_data_cb(control_block1);
+
+  /// act
+  az_ulib_ustream_data_cb* control_block3 = az_ulib_ustream_pool_alloc_data_cb();
+
+  /// assert
+  assert_ptr_equal(control_block3, control_block1);
+
+  /// cleanup
+  az_ulib_ustream_pool_release_data_cb(control_block2);
+  az_ulib_ustream_pool_release_data_cb(control_block3);
+}
+
+/* The ustream shall return the control block to the pool when it is disposed, if the
+ * az_ulib_ustream_pool_release_data_cb is the control_block_release. */
+static void az_ulib_ustream_pool_ustream_dispose_release_data_cb_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_instance;
+  az_ulib_ustream ustream_clone;
+  az_ulib_ustream_data_cb* control_block = az_ulib_ustream_pool_alloc_data_cb();
+  assert_non_null(control_block);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          control_block,
+          az_ulib_ustream_pool_release_data_cb,
+          USTREAM_POOL_CONTENT_1,
+          strlen((const char*)USTREAM_POOL_CONTENT_1),
+          NULL),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_clone(&ustream_clone, &ustream_instance, 0), AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_instance), AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_clone), AZ_OK);
+
+  /// assert
+  check_all_data_cb_available();
+
+  /// cleanup
+}
+
+/* The multi ustream shall return all control blocks to the pool when it is disposed, if the
+ * pool release functions are the release callbacks. */
+static void az_ulib_ustream_pool_concat_dispose_release_all_blocks_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream ustream_one;
+  az_ulib_ustream ustream_two;
+  az_ulib_ustream_data_cb* control_block1 = az_ulib_ustream_pool_alloc_data_cb();
+  az_ulib_ustream_data_cb* control_block2 = az_ulib_ustream_pool_alloc_data_cb();
+  az_ulib_ustream_multi_data_cb* multi_data = az_ulib_ustream_pool_alloc_multi_data_cb();
+  assert_non_null(control_block1);
+  assert_non_null(control_block2);
+  assert_non_null(multi_data);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_one,
+          control_block1,
+          az_ulib_ustream_pool_release_data_cb,
+          USTREAM_POOL_CONTENT_1,
+          strlen((const char*)USTREAM_POOL_CONTENT_1),
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_two,
+          control_block2,
+          az_ulib_ustream_pool_release_data_cb,
+          USTREAM_POOL_CONTENT_2,
+          strlen((const char*)USTREAM_POOL_CONTENT_2),
+          NULL),
+      AZ_OK);
+  assert_int_equal(
+      az_ulib_ustream_concat(
+          &ustream_one, &ustream_two, multi_data, az_ulib_ustream_pool_release_multi_data_cb),
+      AZ_OK);
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_two), AZ_OK);
+
+  /// act
+  assert_int_equal(az_ulib_ustream_dispose(&ustream_one), AZ_OK);
+
+  /// assert
+  check_all_data_cb_available();
+  check_all_multi_data_cb_available();
+
+  /// cleanup
+}
+
+/* az_ulib_ustream_pool_alloc_data_cb and az_ulib_ustream_pool_release_data_cb shall never return
+ * the same block to two threads at the same time. */
+static void az_ulib_ustream_pool_alloc_and_release_in_parallel_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  THREAD_HANDLE threads[TEST_POOL_THREADS];
+  g_pool_errors = 0;
+
+  /// act
+  for (int i = 0; i < TEST_POOL_THREADS; i++)
+  {
+    assert_int_equal(
+        test_thread_create(&threads[i], alloc_and_release_thread, NULL), TEST_THREAD_OK);
+  }
+  for (int i = 0; i < TEST_POOL_THREADS; i++)
+  {
+    int thread_result;
+    assert_int_equal(test_thread_join(threads[i], &thread_result), TEST_THREAD_OK);
+  }
+
+  /// assert
+  assert_int_equal(g_pool_errors, 0);
+  check_all_data_cb_available();
+
+  /// cleanup
+}
+
+int az_ulib_ustream_pool_ut()
+{
+#ifndef AZ_NO_PRECONDITION_CHECKING
+  AZ_ULIB_SETUP_PRECONDITION_CHECK_TESTS();
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+  const struct CMUnitTest tests[] = {
+#ifndef AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_ustream_pool_release_data_cb_null_failed),
+    cmocka_unit_test(az_ulib_ustream_pool_release_data_cb_not_from_pool_failed),
+    cmocka_unit_test(az_ulib_ustream_pool_release_data_cb_misaligned_failed),
+    cmocka_unit_test(az_ulib_ustream_pool_release_multi_data_cb_not_from_pool_failed),
+#endif // AZ_NO_PRECONDITION_CHECKING
+    cmocka_unit_test(az_ulib_ustream_pool_alloc_data_cb_all_blocks_succeed),
+    cmocka_unit_test(az_ulib_ustream_pool_alloc_multi_data_cb_all_blocks_succeed),
+    cmocka_unit_test(az_ulib_ustream_pool_alloc_data_cb_reuse_released_block_succeed),
+    cmocka_unit_test(az_ulib_ustream_pool_ustream_dispose_release_data_cb_succeed),
+    cmocka_unit_test(az_ulib_ustream_pool_concat_dispose_release_all_blocks_succeed),
+    cmocka_unit_test(az_ulib_ustream_pool_alloc_and_release_in_parallel_succeed),
+  };
+
+  return cmocka_run_group_tests_name("az_ulib_ustream_pool_ut", tests, NULL, NULL);
+}
@@ -209,6 +209,42 @@ static void az_ulib_ustream_init_succeed(void** state)
   (void)az_ulib_ustream_dispose(&ustream_instance);
 }
 
+/* az_ulib_ustream_peek shall return a span that points to the data in the ustream buffer. */
+static void az_ulib_ustream_peek_without_copy_succeed(void** state)
+{
+  /// arrange
+  (void)state;
+  az_ulib_ustream_data_cb control_block;
+  az_ulib_ustream ustream_instance;
+  assert_int_equal(
+      az_ulib_ustream_init(
+          &ustream_instance,
+          &control_block,
+          NULL,
+          USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT,
+          USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH,
+          NULL),
+      AZ_OK);
+  az_span span1;
+  az_span span2;
+
+  /// act
+  az_result result1 = az_ulib_ustream_peek(&ustream_instance, AZ_SPAN_EMPTY, &span1);
+  assert_int_equal(az_ulib_ustream_advance(&ustream_instance, 10), AZ_OK);
+  az_result result2 = az_ulib_ustream_peek(&ustream_instance, AZ_SPAN_EMPTY, &span2);
+
+  /// assert
+  assert_int_equal(result1, AZ_OK);
+  assert_ptr_equal(az_span_ptr(span1), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT);
+  assert_int_equal(az_span_size(span1), USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH);
+  assert_int_equal(result2, AZ_OK);
+  assert_ptr_equal(az_span_ptr(span2), USTREAM_COMPLIANCE_LOCAL_EXPECTED_CONTENT + 10);
+  assert_int_equal(az_span_size(span2), USTREAM_COMPLIANCE_EXPECTED_CONTENT_LENGTH - 10);
+
+  /// cleanup
+  (void)az_ulib_ustream_dispose(&ustream_instance);
+}
+
 #include "az_ulib_ustream_compliance_ut.h"
 
 int az_ulib_ustream_ut()
@@ -226,6 +262,7 @@ int az_ulib_ustream_ut()
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test_setup_teardown(az_ulib_ustream_init_const_succeed, setup, teardown),
     cmocka_unit_test_setup_teardown(az_ulib_ustream_init_succeed, setup, teardown),
+    cmocka_unit_test_setup_teardown(az_ulib_ustream_peek_without_copy_succeed, setup, teardown),
 #ifndef AZ_NO_PRECONDITION_CHECKING
     AZ_ULIB_USTREAM_PRECONDITION_COMPLIANCE_UT_LIST
 #endif // AZ_NO_PRECONDITION_CHECKING
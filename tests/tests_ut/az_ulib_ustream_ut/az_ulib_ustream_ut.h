@@ -4,3 +4,4 @@
 
 int az_ulib_ustream_ut();
 int az_ulib_ustream_aux_ut();
+int az_ulib_ustream_pool_ut();
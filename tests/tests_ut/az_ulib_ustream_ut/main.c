@@ -14,6 +14,8 @@ int main(void)
   result += az_ulib_ustream_ut();
   (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_aux_ut.\r\n");
   result += az_ulib_ustream_aux_ut();
+  (void)printf("[==========]\r\n[ STARTING ] Running az_ulib_ustream_pool_ut.\r\n");
+  result += az_ulib_ustream_pool_ut();
 
   return result;
 }